@@ -212,6 +212,15 @@ namespace BasisClasses
     for (auto & v : dlegs ) v.resize(lmax+1, lmax+1);
     for (auto & v : d2legs) v.resize(lmax+1, lmax+1);
 
+    accbuf.resize(nthrds);
+    potB  .resize(nthrds);
+
+    for (auto & v : accbuf) v.reserve(batchSize);
+    for (auto & v : potB  ) v.resize(batchSize, Eigen::MatrixXd(lmax+1, nmax));
+
+    legB.resize(nthrds);
+    for (auto & v : legB) v.resize(lmax);
+
     expcoef.resize((lmax+1)*(lmax+1), nmax);
     expcoef.setZero();
       
@@ -324,6 +333,7 @@ namespace BasisClasses
   void Spherical::reset_coefs(void)
   {
     if (expcoef.rows()>0 && expcoef.cols()>0) expcoef.setZero();
+    for (auto & v : accbuf) v.clear();
     totalMass = 0.0;
     used = 0;
   }
@@ -421,70 +431,114 @@ namespace BasisClasses
   }
 
   void Spherical::accumulate(double x, double y, double z, double mass)
+  {
+    // Get thread id
+    int tid = omp_get_thread_num();
+
+    accbuf[tid].push_back({x, y, z, mass});
+
+    if (accbuf[tid].size() >= batchSize) accumulate_batch(tid);
+  }
+  
+  void Spherical::accumulate_batch(int tid)
   {
     double fac, fac1, fac2, fac4;
     double norm = -4.0*M_PI;
     const double dsmall = 1.0e-20;
     
-    // Get thread id
-    int tid = omp_get_thread_num();
+    auto & buf = accbuf[tid];
+
+    //======================
+    // Select the particles
+    //======================
+
+    std::array<double, batchSize> rs;
+    std::array<int,    batchSize> which;
+    int nb = 0;
+
+    for (int k=0; k<buf.size(); k++) {
+      auto & b = buf[k];
+      double r = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2]) + dsmall;
+      if (r < rmin or r > rmax) continue;
+      rs[nb] = r/scale;
+      which[nb++] = k;
+    }
+
+    // Radial functions for the whole batch
+    //
+    get_pot(potB[tid], rs.data(), nb);
 
     //======================
     // Compute coefficients 
     //======================
     
-    double r2 = (x*x + y*y + z*z);
-    double r = sqrt(r2) + dsmall;
-    double costh = z/r;
-    double phi = atan2(y,x);
-    double rs = r/scale;
-    
-    if (r < rmin or r > rmax) return;
-    
-    used++;
-    totalMass += mass;
+    auto & lb = legB[tid];
+    constexpr int W = LegendreBlock<double>::lanes;
+
+    for (int j=0; j<nb; j++) {
+
+      int q = j % W;		// Lane in the Legendre block
+
+      if (q==0) {		// Angular functions for the next W
+	double costh[W], phi[W];
+	int nq = std::min<int>(W, nb-j);
+	for (int k=0; k<nq; k++) {
+	  auto & b = buf[which[j+k]];
+	  double r = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2]) + dsmall;
+	  costh[k] = b[2]/r;
+	  phi[k]   = atan2(b[1], b[0]);
+	}
+	lb.legendre(costh, nq);
+	lb.sinecosine(lmax, phi, nq);
+      }
+
+      double mass = buf[which[j]][3];
     
-    get_pot(potd[tid], rs);
+      used++;
+      totalMass += mass;
     
-    legendre_R(lmax, costh, legs[tid]);
+      auto & potd_ = potB[tid][j];
     
-    // L loop
-    for (int l=0, loffset=0; l<=lmax; loffset+=(2*l+1), l++) {
-      
-      Eigen::VectorXd workE;
-      int esize = (l+1)*nmax;
+      // L loop
+      for (int l=0, loffset=0; l<=lmax; loffset+=(2*l+1), l++) {
       
-      // M loop
-      for (int m=0, moffset=0, moffE=0; m<=l; m++) {
+	// M loop
+	for (int m=0, moffset=0; m<=l; m++) {
 	
-	if (m==0) {
-	  fac = factorial(l, m) * legs[tid](l, m);
-	  for (int n=0; n<nmax; n++) {
-	    fac4 = potd[tid](l, n)*fac;
-	    expcoef(loffset+moffset, n) += fac4 * norm * mass;
-	  }
+	  if (m==0) {
+	    fac = factorial(l, m) * lb.P(l, m, q);
+	    for (int n=0; n<nmax; n++) {
+	      fac4 = potd_(l, n)*fac;
+	      expcoef(loffset+moffset, n) += fac4 * norm * mass;
+	    }
 	  
-	  moffset++;
-	}
-	else {
-	  fac  = factorial(l, m) * legs[tid](l, m);
-	  fac1 = fac*cos(phi*m);
-	  fac2 = fac*sin(phi*m);
-	  for (int n=0; n<nmax; n++) {
-	    fac4 = potd[tid](l, n);
-	    expcoef(loffset+moffset  , n) += fac1 * fac4 * norm * mass;
-	    expcoef(loffset+moffset+1, n) += fac2 * fac4 * norm * mass;
+	    moffset++;
 	  }
+	  else {
+	    fac  = factorial(l, m) * lb.P(l, m, q);
+	    fac1 = fac*lb.C(m, q);
+	    fac2 = fac*lb.S(m, q);
+	    for (int n=0; n<nmax; n++) {
+	      fac4 = potd_(l, n);
+	      expcoef(loffset+moffset  , n) += fac1 * fac4 * norm * mass;
+	      expcoef(loffset+moffset+1, n) += fac2 * fac4 * norm * mass;
+	    }
 	  
-	  moffset+=2;
+	    moffset+=2;
+	  }
 	}
       }
     }
-    
+
+    buf.clear();
   }
   
   void Spherical::make_coefs()
   {
+    // Add any remaining buffered particles
+    //
+    for (int tid=0; tid<accbuf.size(); tid++) accumulate_batch(tid);
+
     if (use_mpi) {
       
       MPI_Allreduce(MPI_IN_PLACE, &used, 1, MPI_INT,
@@ -1205,6 +1259,18 @@ namespace BasisClasses
     //
     if (mlim>=0)  sl->set_mlim(mlim);
     if (EVEN_M)   sl->setEven(EVEN_M);
+
+    // The EOF basis is conditioned by the analytic density described
+    // by the configuration, so the configuration less the cache name
+    // identifies it in the shared basis store
+    //
+    {
+      YAML::Node tag = YAML::Clone(conf);
+      tag.remove("cachename");
+      tag.remove("eof_file");
+      std::ostringstream sout; sout << tag;
+      sl->setCacheTag(sout.str());
+    }
       
     // Attempt to read EOF cache
     //
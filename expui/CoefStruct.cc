@@ -18,7 +18,7 @@ namespace CoefClasses
     ret->geom  = geom;
     ret->id    = id;
     ret->time  = time;
-    ret->store = store;
+    ret->store = getCoefs();
     if (ret->ctr.size()) ret->ctr = ctr;
   }
 
@@ -93,7 +93,7 @@ namespace CoefClasses
     copyfields(ret);
 
     assert(("CylStruct::deepcopy dimension mismatch",
-	    (mmax+1)*nmax == store.size()));
+	    (mmax+1)*nmax == ret->store.size()));
 
     ret->coefs = std::make_shared<coefType>(ret->store.data(), mmax+1, nmax);
     ret->mmax  = mmax;
@@ -109,7 +109,7 @@ namespace CoefClasses
     copyfields(ret);
 
     assert(("SphStruct::deepcopy dimension mismatch",
-	    (lmax+1)*(lmax+2)/2*nmax == store.size()));
+	    (lmax+1)*(lmax+2)/2*nmax == ret->store.size()));
 
     ret->coefs  = std::make_shared<coefType>
       (ret->store.data(), (lmax+1)*(lmax+2)/2, nmax);
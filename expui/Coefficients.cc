@@ -8,6 +8,7 @@
 
 #include <config_exp.h>
 #include <localmpi.H>
+#include <NodeShared.H>
 
 #include <Eigen/Dense>
 #include <yaml-cpp/yaml.h>
@@ -64,11 +65,13 @@ namespace CoefClasses
     auto cA = getCoefStruct(times[iA]);
     auto cB = getCoefStruct(times[iB]);
 
-    int siz = cA->store.size();
+    auto dA = cA->getCoefs(), dB = cB->getCoefs();
+
+    int siz = dA.size();
     arr.resize(siz);
 
     for (int c=0; c<siz; c++) {
-      arr(c) = A*cA->store(c) + B*cB->store(c);
+      arr(c) = A*dA(c) + B*dB(c);
     }
 
     return {arr, onGrid};
@@ -91,6 +94,26 @@ namespace CoefClasses
     file.getAttribute("geometry").read(geometry);
     file.getAttribute("forceID" ).read(forceID );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this, scale, geometry, forceID]()
+      {
+	auto coef = std::make_shared<SphStruct>();
+	coef->lmax  = Lmax;
+	coef->nmax  = Nmax;
+	coef->scale = scale;
+	coef->geom  = geometry;
+	coef->id    = forceID;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Look for Coef output version to toggle backward compatibility
     // with legacy storage order
     //
@@ -277,6 +300,27 @@ namespace CoefClasses
     file.getAttribute("geometry").read(geometry);
     file.getAttribute("fieldID" ).read(fieldID );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this, scale, geometry, fieldID]()
+      {
+	auto coef = std::make_shared<SphFldStruct>();
+	coef->nfld  = Nfld;
+	coef->lmax  = Lmax;
+	coef->nmax  = Nmax;
+	coef->scale = scale;
+	coef->geom  = geometry;
+	coef->id    = fieldID;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Open the snapshot group
     //
     auto snaps = file.getGroup("snapshots");
@@ -368,6 +412,27 @@ namespace CoefClasses
     file.getAttribute("geometry").read(geometry);
     file.getAttribute("fieldID" ).read(fieldID );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this, scale, geometry, fieldID]()
+      {
+	auto coef = std::make_shared<CylFldStruct>();
+	coef->nfld  = Nfld;
+	coef->mmax  = Mmax;
+	coef->nmax  = Nmax;
+	coef->scale = scale;
+	coef->geom  = geometry;
+	coef->id    = fieldID;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Open the snapshot group
     //
     auto snaps = file.getGroup("snapshots");
@@ -443,6 +508,8 @@ namespace CoefClasses
 
   Eigen::VectorXcd& SphCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -456,6 +523,8 @@ namespace CoefClasses
   
   Eigen::MatrixXcd& SphCoefs::getMatrix(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -471,6 +540,7 @@ namespace CoefClasses
   
   void SphCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -486,6 +556,7 @@ namespace CoefClasses
   
   void SphCoefs::setMatrix(double time, Eigen::MatrixXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -798,6 +869,23 @@ namespace CoefClasses
     file.getAttribute("config" ).read(config);
     file.getDataSet  ("count"  ).read(count );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this]()
+      {
+	auto coef = std::make_shared<CylStruct>();
+	coef->mmax  = Mmax;
+	coef->nmax  = Nmax;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Look for Coef output version to toggle backward compatibility
     // with legacy storage order
     //
@@ -866,6 +954,8 @@ namespace CoefClasses
   
   Eigen::VectorXcd& CylCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -879,6 +969,8 @@ namespace CoefClasses
   
   Eigen::MatrixXcd& CylCoefs::getMatrix(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -893,6 +985,7 @@ namespace CoefClasses
   
   void CylCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -908,6 +1001,7 @@ namespace CoefClasses
 
   void CylCoefs::setMatrix(double time, Eigen::MatrixXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1193,6 +1287,24 @@ namespace CoefClasses
     file.getAttribute("config" ).read(config);
     file.getDataSet  ("count"  ).read(count );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this]()
+      {
+	auto coef = std::make_shared<SlabStruct>();
+	coef->nmaxx = NmaxX;
+	coef->nmaxy = NmaxY;
+	coef->nmaxz = NmaxZ;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Open the snapshot group
     //
     auto snaps = file.getGroup("snapshots");
@@ -1236,6 +1348,8 @@ namespace CoefClasses
   
   Eigen::VectorXcd& SlabCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1249,6 +1363,7 @@ namespace CoefClasses
 
   void SlabCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1264,6 +1379,7 @@ namespace CoefClasses
 
   void SlabCoefs::setTensor(double time, const Eigen3d& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1278,6 +1394,8 @@ namespace CoefClasses
 
   SlabCoefs::Eigen3d& SlabCoefs::getTensor(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1545,6 +1663,24 @@ namespace CoefClasses
     file.getAttribute("config" ).read(config);
     file.getDataSet  ("count"  ).read(count );
     
+    // Time-series layout: read the time window as a hyperslab
+    //
+    if (isH5Series(file)) {
+      ReadH5Series(file, stride, Tmin, Tmax, [this]()
+      {
+	auto coef = std::make_shared<CubeStruct>();
+	coef->nmaxx = NmaxX;
+	coef->nmaxy = NmaxY;
+	coef->nmaxz = NmaxZ;
+	coef->allocate();
+	return coef;
+      });
+
+      times.clear();
+      for (auto t : coefs) times.push_back(t.first);
+      return;
+    }
+
     // Open the snapshot group
     //
     auto snaps = file.getGroup("snapshots");
@@ -1588,6 +1724,8 @@ namespace CoefClasses
   
   Eigen::VectorXcd& CubeCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1601,6 +1739,7 @@ namespace CoefClasses
 
   void CubeCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1616,6 +1755,7 @@ namespace CoefClasses
 
   void CubeCoefs::setTensor(double time, const Eigen3d& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -1630,6 +1770,8 @@ namespace CoefClasses
 
   CubeCoefs::Eigen3d& CubeCoefs::getTensor(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2106,7 +2248,8 @@ namespace CoefClasses
 
 
   std::shared_ptr<Coefs> Coefs::factory
-  (const std::string& file, int stride, double tmin, double tmax)
+  (const std::string& file, int stride, double tmin, double tmax,
+   bool lazy, double cache_mb)
   {
     std::shared_ptr<Coefs> coefs;
     
@@ -2127,21 +2270,34 @@ namespace CoefClasses
       HighFive::Attribute geom = h5file.getAttribute("geometry");
       geom.read(geometry);
       
+      // A lazy container reads the parameters only, and pages the
+      // snapshots in the requested window on demand
+      //
+      double Tmin = tmin, Tmax = tmax;
+      if (lazy) {
+	if (not isH5Series(h5file))
+	  throw std::runtime_error("Coefs::factory: lazy paging requires the "
+				   "time-series H5 layout; convert <" + file +
+				   "> with coefstoh5");
+	Tmin =  std::numeric_limits<double>::max();
+	Tmax = -std::numeric_limits<double>::max();
+      }
+
       try {
 	// Is the set a biorthogonal basis (has the forceID attribute)
 	// or general basis (fieldID attribute)?
 	//
 	if (h5file.hasAttribute("forceID")) {
 	  if (geometry.compare("sphere")==0) {
-	    coefs = std::make_shared<SphCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<SphCoefs>(h5file, stride, Tmin, Tmax);
 	  } else if (geometry.compare("cylinder")==0) {
-	    coefs = std::make_shared<CylCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<CylCoefs>(h5file, stride, Tmin, Tmax);
 	  } else if (geometry.compare("slab")==0) {
-	    coefs = std::make_shared<SlabCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<SlabCoefs>(h5file, stride, Tmin, Tmax);
 	  } else if (geometry.compare("cube")==0) {
-	    coefs = std::make_shared<CubeCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<CubeCoefs>(h5file, stride, Tmin, Tmax);
 	  } else if (geometry.compare("table")==0) {
-	    coefs = std::make_shared<TableData>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<TableData>(h5file, stride, Tmin, Tmax);
 	  } else {
 	    throw std::runtime_error("Coefs::factory: unknown H5 coefficient file geometry: " + geometry);
 	  }
@@ -2152,9 +2308,9 @@ namespace CoefClasses
 	  fieldID.read(field);
 
 	  if (field.compare("spherical field")>0) {
-	    coefs = std::make_shared<SphFldCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<SphFldCoefs>(h5file, stride, Tmin, Tmax);
 	  } else if (field.compare("polar field")>0) {
-	    coefs = std::make_shared<CylFldCoefs>(h5file, stride, tmin, tmax);
+	    coefs = std::make_shared<CylFldCoefs>(h5file, stride, Tmin, Tmax);
 	  } else {
 	    throw std::runtime_error("Coefs::factory: unknown H5 coefficient file fieldID: " + field);
 	  }
@@ -2163,6 +2319,8 @@ namespace CoefClasses
 	std::string msg("Coefs::factory: error reading HDF5 file, ");
 	throw std::runtime_error(msg + err.what());
       }
+
+      if (lazy) coefs->setLazy(file, stride, tmin, tmax, cache_mb);
 	
       return coefs;
       
@@ -2180,6 +2338,12 @@ namespace CoefClasses
 			       + "> does not exist");
     }
 
+    if (lazy) {
+      throw std::runtime_error("Coefs::factory: lazy paging requires an "
+			       "H5 coefficient file; convert <" + file +
+			       "> with coefstoh5");
+    }
+
     // Open file and read magic number
     //
     std::ifstream in(file);
@@ -2207,6 +2371,128 @@ namespace CoefClasses
     
     return coefs;
   }
+
+  std::shared_ptr<Coefs> Coefs::factoryShared(const std::string& file,
+					      bool share)
+  {
+    MPI_Comm comm = share ? NodeShared::nodeComm() : MPI_COMM_NULL;
+
+    if (comm == MPI_COMM_NULL) return factory(file);
+
+    bool leader = NodeShared::nodeRank()==0;
+
+    // Only the node leader reads the file.  It sends the geometry,
+    // name and force id and, for each snapshot, the time and the
+    // dimensions to the other processes on the node, which build
+    // snapshots without data and attach them to the leader's block
+    //
+    const int nmeta = 5;	// time, lmax|mmax, nmax, scale, normed
+
+    std::shared_ptr<Coefs> coefs;
+    std::vector<double> meta;
+    std::string label;
+
+    if (leader) {
+      coefs = factory(file);
+
+      std::string id;
+      for (auto t : coefs->Times()) {
+	auto c = coefs->getCoefStruct(t);
+	if (auto p = std::dynamic_pointer_cast<SphStruct>(c))
+	  meta.insert(meta.end(), {p->time, double(p->lmax), double(p->nmax),
+				   p->scale, double(p->normed)});
+	else if (auto p = std::dynamic_pointer_cast<CylStruct>(c))
+	  meta.insert(meta.end(), {p->time, double(p->mmax), double(p->nmax),
+				   1.0, 1.0});
+	id = c->id;
+      }
+
+      label = coefs->geometry + '\n' + coefs->name + '\n' + id;
+    }
+
+    unsigned long sizes[2] = {label.size(), meta.size()};
+    MPI_Bcast(sizes, 2, MPI_UNSIGNED_LONG, 0, comm);
+    label.resize(sizes[0]);
+    meta.resize(sizes[1]);
+    MPI_Bcast(label.data(), sizes[0], MPI_CHAR, 0, comm);
+    MPI_Bcast(meta.data(), sizes[1], MPI_DOUBLE, 0, comm);
+
+    std::string geometry, name, id;
+    {
+      std::istringstream sin(label);
+      std::getline(sin, geometry);
+      std::getline(sin, name);
+      std::getline(sin, id);
+    }
+
+    bool sphere = geometry == "sphere";
+    if (not sphere and geometry != "cylinder")
+      throw CoefsError("Coefs::factoryShared: coefficients with geometry <" +
+		       geometry + "> can not be shared on the node");
+
+    if (not leader) {
+      if (sphere) coefs = std::make_shared<SphCoefs>();
+      else        coefs = std::make_shared<CylCoefs>();
+      coefs->setName(name);
+
+      for (size_t k=0; k<meta.size(); k+=nmeta) {
+	const double* m = &meta[k];
+	CoefStrPtr c;
+	if (sphere) {
+	  auto p = std::make_shared<SphStruct>();
+	  p->lmax   = m[1];
+	  p->nmax   = m[2];
+	  p->scale  = m[3];
+	  p->normed = m[4] != 0.0;
+	  c = p;
+	} else {
+	  auto p = std::make_shared<CylStruct>();
+	  p->mmax   = m[1];
+	  p->nmax   = m[2];
+	  c = p;
+	}
+	c->time = m[0];
+	c->id   = id;
+	coefs->add(c);
+      }
+      coefs->Times();		// Rebuild the time list
+    }
+
+    // Values per snapshot, in time order on every process
+    //
+    std::vector<unsigned long> count;
+    unsigned long total = 0;
+    for (size_t k=0; k<meta.size(); k+=nmeta) {
+      unsigned long rows = sphere ?
+	(meta[k+1]+1)*(meta[k+1]+2)/2 : meta[k+1]+1;
+      count.push_back(rows*meta[k+2]);
+      total += count.back();
+    }
+
+    // Two doubles for each complex value
+    //
+    auto block = std::make_shared<NodeShared>(2*total, true);
+    block->report("Playback coefficients");
+    auto p = reinterpret_cast<std::complex<double>*>(block->data());
+
+    if (leader) {
+      auto q = p;
+      for (auto t : coefs->Times()) {
+	auto c = coefs->getCoefStruct(t);
+	q = std::copy(c->store.data(), c->store.data()+c->store.size(), q);
+      }
+    }
+    block->sync();
+
+    auto times = coefs->Times();
+    for (size_t i=0; i<times.size(); i++) {
+      coefs->getCoefStruct(times[i])->attach(p);
+      p += count[i];
+    }
+    coefs->nodeStore = block;
+
+    return coefs;
+  }
   
   std::shared_ptr<Coefs> Coefs::makecoefs(CoefStrPtr coef, std::string name)
   {
@@ -2295,9 +2581,17 @@ namespace CoefClasses
 			  HighFive::File::ReadWrite |
 			  HighFive::File::Create);
       
+      // Use the time-series layout if requested and supported by
+      // this coefficient type
+      //
+      bool series = H5Version >= 2 and H5Shape().size() > 0;
+
       // Write the Version string
       //
-      file.createAttribute<std::string>("CoefficientOutputVersion", HighFive::DataSpace::From(CoefficientOutputVersion)).write(CoefficientOutputVersion);
+      const std::string& version =
+	series ? CoefficientSeriesVersion : CoefficientOutputVersion;
+
+      file.createAttribute<std::string>("CoefficientOutputVersion", HighFive::DataSpace::From(version)).write(version);
 
       // We write the coefficient file geometry
       //
@@ -2321,13 +2615,19 @@ namespace CoefClasses
       unsigned count = 0;
       HighFive::DataSet dataset = file.createDataSet("count", count);
       
-      // Create a new group for coefficient snapshots
-      //
-      HighFive::Group group = file.createGroup("snapshots");
+      if (series) {
+	// Write the coefficients as a time series
+	//
+	count = WriteH5Series(file, count);
+      } else {
+	// Create a new group for coefficient snapshots
+	//
+	HighFive::Group group = file.createGroup("snapshots");
       
-      // Write the coefficients
-      //
-      count = WriteH5Times(group, count);
+	// Write the coefficients
+	//
+	count = WriteH5Times(group, count);
+      }
       
       // Update the count
       //
@@ -2352,11 +2652,17 @@ namespace CoefClasses
       unsigned count;
       dataset.read(count);
       
-      HighFive::Group group = file.getGroup("snapshots");
+      if (isH5Series(file)) {
+	// Append to the time series
+	//
+	count = WriteH5Series(file, count);
+      } else {
+	HighFive::Group group = file.getGroup("snapshots");
       
-      // Write the coefficients
-      //
-      count = WriteH5Times(group, count);
+	// Write the coefficients
+	//
+	count = WriteH5Times(group, count);
+      }
       
       // Update the count
       //
@@ -2368,6 +2674,361 @@ namespace CoefClasses
     
   }
   
+  bool Coefs::isH5Series(HighFive::File& file)
+  {
+    if (not file.hasAttribute("CoefficientOutputVersion")) return false;
+
+    std::string version;
+    file.getAttribute("CoefficientOutputVersion").read(version);
+
+    return version == CoefficientSeriesVersion;
+  }
+
+  // Eigen stores the coefficient arrays in column-major order while
+  // the time-series dataset is row-major (C order) with the same
+  // dimensions so that it reads naturally from h5py.  Copy one
+  // snapshot between the two orders.
+  //
+  static void seriesOrder(const std::complex<double>* in,
+			  std::complex<double>* out,
+			  const std::vector<size_t>& dims, bool toRow)
+  {
+    size_t rank = dims.size(), N = 1;
+    for (auto d : dims) N *= d;
+
+    std::vector<size_t> idx(rank, 0);
+
+    for (size_t r=0; r<N; r++) {
+      size_t c = 0, s = 1;
+      for (size_t j=0; j<rank; j++) { c += idx[j]*s; s *= dims[j]; }
+
+      if (toRow) out[r] = in[c];
+      else       out[c] = in[r];
+
+      // Next row-major index: last dimension varies fastest
+      for (size_t j=rank; j-->0; ) {
+	if (++idx[j] < dims[j]) break;
+	idx[j] = 0;
+      }
+    }
+  }
+
+  // Number of snapshots per chunk and per I/O block for snapshots of
+  // size N
+  //
+  static size_t seriesChunk(size_t N)
+  { return std::max<size_t>(1, (1<<16)/std::max<size_t>(1, N)); }
+
+  static size_t seriesBlock(size_t N)
+  { return std::max<size_t>(1, (1<<22)/std::max<size_t>(1, N)); }
+
+  unsigned Coefs::WriteH5Series(HighFive::File& file, unsigned count)
+  {
+    auto shape = H5Shape();
+    size_t N = 1;
+    for (auto d : shape) N *= d;
+
+    auto T = Times();
+    if (T.size()==0) return count;
+
+    bool hasCtr = getCoefStruct(T.front())->ctr.size() > 0;
+
+    HighFive::DataSet tims, cofs, ctrs;
+
+    if (file.exist("times")) {
+      tims = file.getDataSet("times");
+      cofs = file.getDataSet("coefficients");
+
+      auto dims = cofs.getDimensions();
+      if (dims.size() != shape.size()+1 or
+	  not std::equal(shape.begin(), shape.end(), dims.begin()+1)) {
+	throw std::runtime_error("Coefs::WriteH5Series: coefficient "
+				 "dimensions do not match the H5 file");
+      }
+
+      hasCtr = file.exist("centers");
+      if (hasCtr) ctrs = file.getDataSet("centers");
+    } else {
+      // Unlimited along time and chunked by a fixed number of
+      // snapshots so that appends only touch the last chunk
+      //
+      size_t chunk = seriesChunk(N);
+      const size_t U = HighFive::DataSpace::UNLIMITED;
+
+      HighFive::DataSetCreateProps tprops;
+      tprops.add(HighFive::Chunking(std::vector<hsize_t>{1024}));
+      tims = file.createDataSet<double>
+	("times", HighFive::DataSpace({0}, {U}), tprops);
+
+      std::vector<size_t> dims {0}, maxd {U};
+      std::vector<hsize_t> cdim {chunk};
+      for (auto d : shape) {
+	dims.push_back(d);
+	maxd.push_back(d);
+	cdim.push_back(d);
+      }
+
+      HighFive::DataSetCreateProps cprops;
+      cprops.add(HighFive::Chunking(cdim));
+      cofs = file.createDataSet<std::complex<double>>
+	("coefficients", HighFive::DataSpace(dims, maxd), cprops);
+
+      if (hasCtr) {
+	HighFive::DataSetCreateProps pprops;
+	pprops.add(HighFive::Chunking(std::vector<hsize_t>{1024, 3}));
+	ctrs = file.createDataSet<double>
+	  ("centers", HighFive::DataSpace({0, 3}, {U, 3}), pprops);
+      }
+    }
+
+    // Extend the datasets once and write the new snapshots in blocks
+    //
+    size_t total = count + T.size();
+
+    std::vector<size_t> dims {total};
+    dims.insert(dims.end(), shape.begin(), shape.end());
+
+    tims.resize({total});
+    cofs.resize(dims);
+    if (hasCtr) ctrs.resize({total, 3});
+
+    size_t block = seriesBlock(N);
+    std::vector<std::complex<double>> buf;
+    std::vector<double> tbuf, cbuf;
+
+    for (size_t b=0; b<T.size(); b+=block) {
+      size_t nb = std::min(block, T.size() - b);
+
+      buf .resize(nb*N);
+      tbuf.resize(nb);
+      cbuf.assign(3*nb, 0.0);
+
+      for (size_t i=0; i<nb; i++) {
+	auto C = getCoefStruct(T[b+i]);
+	if (C->store.size() != N)
+	  throw std::runtime_error("Coefs::WriteH5Series: coefficient "
+				   "size does not match the snapshot shape");
+	tbuf[i] = C->time;
+	seriesOrder(C->store.data(), &buf[i*N], shape, true);
+	for (size_t k=0; k<std::min<size_t>(3, C->ctr.size()); k++)
+	  cbuf[3*i+k] = C->ctr[k];
+      }
+
+      std::vector<size_t> off(dims.size(), 0), cnt(dims);
+      off[0] = count + b;
+      cnt[0] = nb;
+
+      tims.select({off[0]}, {nb}).write_raw(tbuf.data());
+      cofs.select(off, cnt).write_raw(buf.data());
+      if (hasCtr) ctrs.select({off[0], 0}, {nb, 3}).write_raw(cbuf.data());
+    }
+
+    return total;
+  }
+
+  void Coefs::ReadH5Series(HighFive::File& file, int stride,
+			   double tmin, double tmax,
+			   std::function<std::shared_ptr<CoefStruct>()> make)
+  {
+    // Keep the maker for paging snapshots in a lazy container
+    //
+    h5make = make;
+
+    auto tims = file.getDataSet("times");
+    auto cofs = file.getDataSet("coefficients");
+
+    bool hasCtr = file.exist("centers");
+
+    std::vector<double> T;
+    tims.read(T);
+
+    auto dims = cofs.getDimensions();
+    std::vector<size_t> shape(dims.begin()+1, dims.end());
+    size_t N = 1;
+    for (auto d : shape) N *= d;
+
+    // First and last strided snapshot in the time window
+    //
+    size_t S = std::max<int>(1, stride), first = T.size(), last = 0;
+    for (size_t n=0; n<T.size(); n+=S) {
+      if (T[n] < tmin or T[n] > tmax) continue;
+      first = std::min(first, n);
+      last  = n;
+    }
+    if (first >= T.size()) return;
+
+    // Read the window as strided hyperslabs, one block at a time
+    //
+    size_t nrow  = (last - first)/S + 1;
+    size_t block = seriesBlock(N);
+
+    std::vector<std::complex<double>> buf;
+    std::vector<double> cbuf;
+
+    for (size_t b=0; b<nrow; b+=block) {
+      size_t nb = std::min(block, nrow - b);
+
+      std::vector<size_t> off(dims.size(), 0), cnt(dims), str(dims.size(), 1);
+      off[0] = first + b*S;
+      cnt[0] = nb;
+      str[0] = S;
+
+      buf.resize(nb*N);
+      cofs.select(off, cnt, str).read_raw(buf.data());
+
+      if (hasCtr) {
+	cbuf.resize(3*nb);
+	file.getDataSet("centers").select({off[0], 0}, {nb, 3}, {S, 1}).read_raw(cbuf.data());
+      }
+
+      for (size_t i=0; i<nb; i++) {
+	size_t n = off[0] + i*S;
+	if (T[n] < tmin or T[n] > tmax) continue;
+
+	auto coef = make();
+	if (coef->store.size() != N)
+	  throw std::runtime_error("Coefs::ReadH5Series: coefficient "
+				   "size does not match the H5 file");
+
+	coef->time = T[n];
+	seriesOrder(&buf[i*N], coef->store.data(), shape, false);
+	if (hasCtr) coef->ctr.assign(&cbuf[3*i], &cbuf[3*i] + 3);
+
+	add(coef);
+      }
+    }
+  }
+  void Coefs::setLazy(const std::string& file, int stride,
+		      double tmin, double tmax, double cache_mb)
+  {
+    if (not h5make)
+      throw std::runtime_error("Coefs::setLazy: lazy paging requires the "
+			       "time-series H5 layout; convert <" + file +
+			       "> with coefstoh5");
+
+    pager = std::make_shared<H5Pager>();
+
+    pager->file   = std::make_shared<HighFive::File>(file, HighFive::File::ReadOnly);
+    pager->budget = static_cast<size_t>(std::max<double>(cache_mb, 0.0)*1024*1024);
+    pager->stride = std::max<int>(1, stride);
+
+    // The selected rows: every stride'th snapshot in the time window
+    //
+    std::vector<double> T;
+    pager->file->getDataSet("times").read(T);
+
+    times.clear();
+    for (size_t n=0; n<T.size(); n+=pager->stride) {
+      if (T[n] < tmin or T[n] > tmax) continue;
+      pager->pos[roundTime(T[n])] = pager->rows.size();
+      pager->rows.push_back(n);
+      times.push_back(roundTime(T[n]));
+    }
+  }
+
+  void Coefs::page(double time)
+  {
+    auto & P = *pager;
+    double key = roundTime(time);
+
+    // Not in the file: the caller sees a missing time as usual
+    //
+    auto ip = P.pos.find(key);
+    if (ip == P.pos.end()) return;
+
+    // Resident: move to the front of the LRU list
+    //
+    auto iw = P.where.find(key);
+    if (iw != P.where.end()) {
+      P.lru.splice(P.lru.begin(), P.lru, iw->second);
+      P.hits++;
+      return;
+    }
+
+    P.misses++;
+
+    // Sequential misses double the read-ahead depth up to a quarter
+    // of the cache; anything else resets it
+    //
+    size_t p = ip->second;
+    auto cofs = P.file->getDataSet("coefficients");
+    auto dims = cofs.getDimensions();
+    std::vector<size_t> shape(dims.begin()+1, dims.end());
+    size_t N = 1;
+    for (auto d : shape) N *= d;
+
+    size_t bytes = N*sizeof(std::complex<double>);
+    size_t amax  = std::max<size_t>(1, P.budget/(4*bytes)) - 1;
+
+    if (P.last != std::numeric_limits<size_t>::max() and p == P.last+1)
+      P.ahead = std::min<size_t>(amax, std::max<size_t>(1, 2*P.ahead));
+    else
+      P.ahead = 0;
+
+    size_t nb = std::min(P.ahead + 1, P.rows.size() - p);
+    P.last = p + nb - 1;
+
+    // One strided hyperslab for the requested and read-ahead rows
+    //
+    std::vector<size_t> off(dims.size(), 0), cnt(dims), str(dims.size(), 1);
+    off[0] = P.rows[p];
+    cnt[0] = nb;
+    str[0] = P.stride;
+
+    std::vector<std::complex<double>> buf(nb*N);
+    cofs.select(off, cnt, str).read_raw(buf.data());
+
+    std::vector<double> tbuf(nb), cbuf;
+    P.file->getDataSet("times").select({off[0]}, {nb}, {str[0]}).read_raw(tbuf.data());
+
+    bool hasCtr = P.file->exist("centers");
+    if (hasCtr) {
+      cbuf.resize(3*nb);
+      P.file->getDataSet("centers").select({off[0], 0}, {nb, 3}, {str[0], 1}).read_raw(cbuf.data());
+    }
+
+    P.reads++;
+
+    // Insert in reverse so that the requested snapshot ends up most
+    // recently used
+    //
+    for (size_t i=nb; i-->0; ) {
+      double k = roundTime(tbuf[i]);
+      if (P.where.find(k) != P.where.end()) continue;
+
+      auto coef = h5make();
+      coef->time = tbuf[i];
+      seriesOrder(&buf[i*N], coef->store.data(), shape, false);
+      if (hasCtr) coef->ctr.assign(&cbuf[3*i], &cbuf[3*i] + 3);
+
+      add(coef);
+
+      P.lru.push_front(k);
+      P.where[k] = P.lru.begin();
+      P.bytes += bytes;
+    }
+
+    // Evict the least recently used, always keeping the requested
+    // snapshot
+    //
+    auto ie = P.lru.end();
+    while (P.bytes > P.budget and ie != P.lru.begin()) {
+      double k = *--ie;
+      if (k == key) continue;
+      ie = P.lru.erase(ie);
+      P.where.erase(k);
+      evict(k);
+      P.bytes -= bytes;
+    }
+  }
+
+  std::tuple<size_t, size_t, size_t, size_t> Coefs::lazyStats()
+  {
+    if (not pager) return {0, 0, 0, 0};
+    return {pager->hits, pager->misses, pager->reads, pager->bytes};
+  }
+
+  
   void CylCoefs::add(CoefStrPtr coef)
   {
     auto p = std::dynamic_pointer_cast<CylStruct>(coef);
@@ -2431,6 +3092,8 @@ namespace CoefClasses
 
   Eigen::VectorXcd& SphFldCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2444,6 +3107,7 @@ namespace CoefClasses
   
   SphFldStruct::dataType SphFldCoefs::getMatrix(double time)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2460,6 +3124,7 @@ namespace CoefClasses
   
   void SphFldCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2475,6 +3140,7 @@ namespace CoefClasses
   
   void SphFldCoefs::setMatrix(double time, SphFldStruct::dataType& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2871,6 +3537,8 @@ namespace CoefClasses
 
   Eigen::VectorXcd& CylFldCoefs::getData(double time)
   {
+    if (pager) page(time);
+
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2884,6 +3552,7 @@ namespace CoefClasses
   
   CylFldStruct::dataType CylFldCoefs::getMatrix(double time)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2899,6 +3568,7 @@ namespace CoefClasses
   
   void CylFldCoefs::setData(double time, Eigen::VectorXcd& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -2914,6 +3584,7 @@ namespace CoefClasses
   
   void CylFldCoefs::setMatrix(double time, CylFldStruct::dataType& dat)
   {
+    if (pager) page(time);
     auto it = coefs.find(roundTime(time));
 
     if (it == coefs.end()) {
@@ -15,7 +15,10 @@ int main(int argc, char **argv)
   //
   // Parse Command line
   //
-  const std::string overview = "Convert native coefficient file to new HDF5 format";
+  const std::string overview = "Convert native or HDF5 coefficient file to the HDF5 format\n"
+    "By default, the new file uses the chunked time-series layout\n"
+    "(version 2).  Use this to convert an HDF5 file with one group\n"
+    "per snapshot (version 1) or, with --legacy, to convert back.";
 
   cxxopts::Options options(argv[0], overview);
 
@@ -25,6 +28,7 @@ int main(int argc, char **argv)
     ("c, cylinder", "assume that coefficients are cylindrical type (for old style)")
     ("s, sphere", "assume that coefficients are spherical type (for old style)")
     ("e, extend", "extend coefficient file rather than write a new file")
+    ("l, legacy", "write the version 1 layout with one group per snapshot")
     ("i,infile", "input coefficient file",
      cxxopts::value<std::string>(infile)->default_value("coef.dat"))
     ("p,prefix", "prefix for h5 coefficient file",
@@ -61,6 +65,10 @@ int main(int argc, char **argv)
   else
     coefs = CoefClasses::Coefs::factory(infile);
 
+  // Layout for the new file.  An extended file keeps its own layout.
+  //
+  CoefClasses::Coefs::H5Version = vm.count("legacy") ? 1 : 2;
+
   // Do the writing
   //
   if (vm.count("extend"))
@@ -0,0 +1,434 @@
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <BasisCache.H>
+
+namespace fs = std::filesystem;
+
+bool           BasisCache::configured  = false;
+std::string    BasisCache::cache_dir;
+std::uintmax_t BasisCache::cache_limit = 0;
+
+namespace {
+
+  // Point a cache file name somewhere else for the life of the
+  // instance
+  //
+  class Redirect
+  {
+  private:
+    std::string& name;
+    std::string  save;
+  public:
+    Redirect(std::string& name, const std::string& path) :
+      name(name), save(name) { name = path; }
+    ~Redirect() { name = save; }
+  };
+
+  // Seconds since the epoch for a file time
+  //
+  std::time_t toTimeT(fs::file_time_type ft)
+  {
+    auto sys = std::chrono::time_point_cast<std::chrono::system_clock::duration>
+      (ft - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
+    return std::chrono::system_clock::to_time_t(sys);
+  }
+
+  // Unique temporary name in the store for this process
+  //
+  std::string tempName(const std::string& dir, const std::string& hash)
+  {
+    char host[256] = "";
+    gethostname(host, sizeof(host)-1);
+    std::ostringstream sout;
+    sout << dir << "/.tmp-" << host << "-" << getpid() << "-" << hash;
+    return sout.str();
+  }
+
+  // Crashed writers leave temporary files behind: remove them after
+  // a day
+  //
+  const std::chrono::hours stale_temp(24);
+}
+
+
+BasisCache::Key::Key(const std::string& forceID, const std::string& version) :
+  id(forceID), version(version)
+{
+  h1 = 0xcbf29ce484222325ULL;	// FNV-1a offset basis
+  h2 = 0x84222325cbf29ce4ULL;
+  mix(id.data(), id.size());
+  mix(version.data(), version.size());
+}
+
+void BasisCache::Key::mix(const void* p, std::size_t n)
+{
+  // Two independent 64-bit streams: FNV-1a and a multiply-rotate
+  // hash with a different multiplier
+  //
+  auto c = static_cast<const unsigned char*>(p);
+  for (std::size_t i=0; i<n; i++) {
+    h1 = (h1 ^ c[i]) * 0x100000001b3ULL;
+    h2 = (h2 ^ c[i]) * 0x9e3779b97f4a7c15ULL;
+    h2 = (h2 << 31) | (h2 >> 33);
+  }
+}
+
+void BasisCache::Key::mix(const std::string& name, char type,
+			  const void* p, std::size_t n)
+{
+  // Separate the fields so that no two sequences of fields hash the
+  // same bytes
+  //
+  std::uint64_t len = n;
+  mix(name.data(), name.size());
+  mix(&type, 1);
+  mix(&len, sizeof(len));
+  mix(p, n);
+}
+
+BasisCache::Key&
+BasisCache::Key::add(const std::string& name, int value)
+{
+  mix(name, 'i', &value, sizeof(value));
+  node[name] = value;
+  return *this;
+}
+
+BasisCache::Key&
+BasisCache::Key::add(const std::string& name, double value)
+{
+  mix(name, 'd', &value, sizeof(value));
+  node[name] = value;
+  return *this;
+}
+
+BasisCache::Key&
+BasisCache::Key::add(const std::string& name, const std::string& value)
+{
+  mix(name, 's', value.data(), value.size());
+  node[name] = value;
+  return *this;
+}
+
+BasisCache::Key&
+BasisCache::Key::add(const std::string& name, const Eigen::VectorXd& value)
+{
+  mix(name, 'v', value.data(), sizeof(double)*value.size());
+  std::ostringstream sout;
+  sout << "[" << value.size() << " values]";
+  node[name] = sout.str();
+  return *this;
+}
+
+std::string BasisCache::Key::hash() const
+{
+  std::ostringstream sout;
+  sout << std::hex << std::setfill('0')
+       << std::setw(16) << h1 << std::setw(16) << h2;
+  return sout.str();
+}
+
+
+void BasisCache::configure()
+{
+  if (configured) return;
+  configured = true;
+
+  if (auto dir = std::getenv("EXP_CACHE_DIR")) cache_dir = dir;
+  if (auto lim = std::getenv("EXP_CACHE_LIMIT")) {
+    try {
+      cache_limit = parseSize(lim);
+    }
+    catch (std::exception& e) {
+      std::cerr << "---- BasisCache: ignoring EXP_CACHE_LIMIT: "
+		<< e.what() << std::endl;
+    }
+  }
+}
+
+bool BasisCache::enabled()
+{
+  configure();
+  return cache_dir.size()>0;
+}
+
+void BasisCache::setDirectory(const std::string& dir, std::uintmax_t limit)
+{
+  configured  = true;
+  cache_dir   = dir;
+  cache_limit = limit;
+}
+
+std::string BasisCache::directory()
+{
+  configure();
+  return cache_dir;
+}
+
+std::uintmax_t BasisCache::sizeLimit()
+{
+  configure();
+  return cache_limit;
+}
+
+std::uintmax_t BasisCache::parseSize(const std::string& size)
+{
+  std::size_t pos = 0;
+  double value = std::stod(size, &pos);
+
+  std::string suffix = size.substr(pos);
+  suffix.erase(std::remove_if(suffix.begin(), suffix.end(), ::isspace),
+	       suffix.end());
+
+  double scale = 1.0;
+  if (suffix.size()) {
+    switch (std::toupper(suffix[0])) {
+    case 'K': scale = 1024.0;                      break;
+    case 'M': scale = 1024.0*1024.0;               break;
+    case 'G': scale = 1024.0*1024.0*1024.0;        break;
+    case 'T': scale = 1024.0*1024.0*1024.0*1024.0; break;
+    default:
+      throw std::runtime_error("BasisCache: bad size suffix in <" + size + ">");
+    }
+  }
+
+  if (value < 0.0)
+    throw std::runtime_error("BasisCache: negative size <" + size + ">");
+
+  return static_cast<std::uintmax_t>(value*scale);
+}
+
+std::string BasisCache::path(const Key& key)
+{
+  return directory() + "/" + key.ID() + "-" + key.hash() + ".h5";
+}
+
+
+BasisCache::Lock::Lock(const std::string& dir)
+{
+  std::string name = dir + "/.lock";
+  fd = open(name.c_str(), O_RDWR | O_CREAT, 0666);
+  if (fd < 0)
+    throw std::runtime_error("BasisCache: could not open <" + name + ">: " +
+			     std::strerror(errno));
+
+  struct flock fl;
+  std::memset(&fl, 0, sizeof(fl));
+  fl.l_type   = F_WRLCK;
+  fl.l_whence = SEEK_SET;
+
+  while (fcntl(fd, F_SETLKW, &fl) < 0) {
+    if (errno == EINTR) continue;
+    close(fd);
+    throw std::runtime_error("BasisCache: could not lock <" + name + ">: " +
+			     std::strerror(errno));
+  }
+}
+
+BasisCache::Lock::~Lock()
+{
+  close(fd);			// Releases the lock
+}
+
+
+bool BasisCache::read(const Key& key, std::string& name,
+		      std::function<bool()> reader)
+{
+  if (not enabled()) return false;
+
+  std::string entry = path(key);
+  std::error_code ec;
+  if (not fs::exists(entry, ec)) return false;
+
+  bool ok = false;
+  {
+    Redirect redirect(name, entry);
+    ok = reader();
+  }
+
+  // Mark as recently used
+  //
+  if (ok) fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+
+  return ok;
+}
+
+void BasisCache::write(const Key& key, std::string& name,
+		       std::function<void()> writer)
+{
+  if (not enabled()) {
+    writer();
+    return;
+  }
+
+  std::string entry = path(key);
+  std::string tmp   = tempName(cache_dir, key.hash());
+  std::string desc  = fs::path(entry).replace_extension(".yml").string();
+
+  try {
+    fs::create_directories(cache_dir);
+
+    // Write the cache and its description to temporary files
+    //
+    {
+      Redirect redirect(name, tmp);
+      writer();
+    }
+
+    // Nothing written (e.g. not the root process or a writer error)
+    //
+    if (not fs::exists(tmp)) return;
+
+    YAML::Emitter out;
+    std::time_t now = std::time(nullptr);
+    std::string created(std::ctime(&now));
+    created.pop_back();		// Remove the trailing newline
+
+    out << YAML::BeginMap
+	<< YAML::Key << "forceID" << YAML::Value << key.ID()
+	<< YAML::Key << "Version" << YAML::Value << key.Version()
+	<< YAML::Key << "hash"    << YAML::Value << key.hash()
+	<< YAML::Key << "created" << YAML::Value << created
+	<< YAML::Key << "params"  << YAML::Value << key.params()
+	<< YAML::EndMap;
+
+    std::ofstream fout(tmp + ".yml");
+    fout << out.c_str() << std::endl;
+    fout.close();
+
+    // Install under the lock
+    //
+    Lock lock(cache_dir);
+
+    if (fs::exists(entry)) {
+      fs::remove(tmp);
+      fs::remove(tmp + ".yml");
+      fs::last_write_time(entry, fs::file_time_type::clock::now());
+      std::cout << "---- BasisCache: <" << entry << "> was stored by "
+		<< "another process" << std::endl;
+      return;
+    }
+
+    fs::rename(tmp + ".yml", desc);
+    fs::rename(tmp, entry);
+
+    std::cout << "---- BasisCache: stored <" << entry << ">" << std::endl;
+
+    if (cache_limit) evict_locked(cache_dir, cache_limit, entry);
+  }
+  catch (std::exception& e) {
+    // The basis is in memory so the run can continue without the
+    // store entry
+    //
+    std::error_code ec;
+    fs::remove(tmp, ec);
+    fs::remove(tmp + ".yml", ec);
+    std::cerr << "---- BasisCache: could not store <" << entry << ">: "
+	      << e.what() << std::endl;
+  }
+}
+
+
+std::vector<BasisCache::Entry> BasisCache::list(const std::string& dir)
+{
+  std::string d = dir.size() ? dir : directory();
+  std::vector<Entry> ret;
+
+  std::error_code ec;
+  if (d.empty() or not fs::is_directory(d, ec)) return ret;
+
+  for (auto & p : fs::directory_iterator(d)) {
+    auto name = p.path().filename().string();
+    if (name[0] == '.' or p.path().extension() != ".h5") continue;
+
+    Entry e;
+    e.path = p.path().string();
+    e.size = fs::file_size(p.path(), ec);
+    e.used = toTimeT(fs::last_write_time(p.path(), ec));
+
+    auto desc = fs::path(p.path()).replace_extension(".yml");
+    e.size += fs::file_size(desc, ec);
+
+    try {
+      auto node = YAML::LoadFile(desc.string());
+      e.forceID = node["forceID"].as<std::string>();
+      e.version = node["Version"].as<std::string>();
+      e.hash    = node["hash"   ].as<std::string>();
+      e.params  = node["params" ];
+    }
+    catch (std::exception& err) {
+      // No description: use the file name
+      auto stem = p.path().stem().string();
+      auto pos  = stem.rfind('-');
+      e.forceID = stem.substr(0, pos);
+      if (pos != std::string::npos) e.hash = stem.substr(pos+1);
+    }
+
+    ret.push_back(e);
+  }
+
+  std::sort(ret.begin(), ret.end(),
+	    [](const Entry& a, const Entry& b) { return a.used > b.used; });
+
+  return ret;
+}
+
+std::uintmax_t BasisCache::evict(std::uintmax_t limit, const std::string& dir)
+{
+  std::string d = dir.size() ? dir : directory();
+  std::error_code ec;
+  if (d.empty() or not fs::is_directory(d, ec)) return 0;
+
+  Lock lock(d);
+  return evict_locked(d, limit, "");
+}
+
+std::uintmax_t BasisCache::evict_locked(const std::string& dir,
+					std::uintmax_t limit,
+					const std::string& keep)
+{
+  std::error_code ec;
+
+  // Clean up after crashed writers
+  //
+  auto now = fs::file_time_type::clock::now();
+  for (auto & p : fs::directory_iterator(dir)) {
+    if (p.path().filename().string().rfind(".tmp-", 0) == 0 and
+	now - fs::last_write_time(p.path(), ec) > stale_temp)
+      fs::remove(p.path(), ec);
+  }
+
+  auto entries = list(dir);
+
+  std::uintmax_t total = 0, removed = 0;
+  for (auto & e : entries) total += e.size;
+
+  // Least recently used are at the end
+  //
+  while (total > limit and entries.size()) {
+    auto e = entries.back();
+    entries.pop_back();
+    if (e.path == keep) continue;
+
+    fs::remove(e.path, ec);
+    fs::remove(fs::path(e.path).replace_extension(".yml"), ec);
+    total   -= e.size;
+    removed += e.size;
+
+    std::cout << "---- BasisCache: evicted <" << e.path << ">" << std::endl;
+  }
+
+  return removed;
+}
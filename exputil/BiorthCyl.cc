@@ -110,6 +110,9 @@ BiorthCyl::BiorthCyl(const YAML::Node& conf) : conf(conf)
     if (conf["EVEN_M"])      EVEN_M = conf["EVEN_M"].as<bool>();
     else                     EVEN_M = false;
 
+    if (conf["node_shared"]) node_shared = conf["node_shared"].as<bool>();
+    else                     node_shared = false;
+
     if (conf["diskconf"])    diskconf  = conf["diskconf"];
     else throw std::runtime_error("BiorthCyl: you must specify the diskconf stanza");
   }
@@ -134,7 +137,28 @@ BiorthCyl::BiorthCyl(const YAML::Node& conf) : conf(conf)
   
   initialize();
 
-  if (not ReadH5Cache()) create_tables();
+  // A matching named cache is used first.  Otherwise, look in the
+  // shared basis store, if configured.
+  //
+  // Only the node leaders read shared arrays, so all processes must
+  // agree on the outcome
+  //
+  auto agree = [this](bool found)
+  {
+    if (not gridStore->shared()) return found;
+    int ok = found;
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    return ok>0;
+  };
+
+  bool found = agree(ReadH5Cache());
+
+  if (not found and BasisCache::enabled())
+    found = agree(BasisCache::read(cacheKey(), cachename,
+				   [this]() { return ReadH5Cache(); }));
+
+  if (found) gridStore->sync();
+  else       create_tables();
 
 }
 
@@ -150,23 +174,23 @@ void BiorthCyl::initialize()
   ymax    = z_to_yi(rcylmax*scale);
   dy      = (ymax - ymin)/(numy-1);
 
-  dens   .resize(mmax+1);
-  pot    .resize(mmax+1);
-  rforce .resize(mmax+1);
-  zforce .resize(mmax+1);
+  // One block for all four arrays, shared on the node if requested
+  //
+  const size_t grid = static_cast<size_t>(numx)*numy;
 
-  for (int m=0; m<=mmax; m++) {
+  gridStore = std::make_shared<NodeShared>(4*grid*(mmax+1)*nmax,
+					   node_shared and use_mpi);
+  gridStore->report("BiorthCyl tables");
 
-    dens  [m].resize(nmax);
-    pot   [m].resize(nmax);
-    rforce[m].resize(nmax);
-    zforce[m].resize(nmax);
+  double* p = gridStore->data();
 
-    for (int n=0; n<nmax; n++) {
-      dens  [m][n].resize(numx, numy);
-      pot   [m][n].resize(numx, numy);
-      rforce[m][n].resize(numx, numy);
-      zforce[m][n].resize(numx, numy);
+  for (auto t : {&dens, &pot, &rforce, &zforce}) {
+
+    t->clear();
+    t->resize(mmax+1);
+
+    for (int m=0; m<=mmax; m++) {
+      for (int n=0; n<nmax; n++, p+=grid) (*t)[m].emplace_back(p, numx, numy);
     }
   }
 }
@@ -191,6 +215,13 @@ void BiorthCyl::create_tables()
   }
 
 
+  // Zero the block before the processes fill in their grid points
+  //
+  if (not gridStore->shared() or NodeShared::nodeRank()==0)
+    std::fill(gridStore->data(), gridStore->data()+gridStore->size(), 0.0);
+
+  gridStore->sync();
+
   // Pack basis grids
   //
   for (int m=0; m<=mmax; m++) {
@@ -201,11 +232,6 @@ void BiorthCyl::create_tables()
 
     for (int n=0; n<nmax; n++) {
 
-      dens  [m][n].setZero();
-      pot   [m][n].setZero();
-      rforce[m][n].setZero();
-      zforce[m][n].setZero();
-
       // Create the functor
       //
       auto func = [&, this](double R)
@@ -241,19 +267,32 @@ void BiorthCyl::create_tables()
 
   if (verbose and myid==0) std::cout << std::endl;
 
+  // With shared arrays, each node already holds the points computed
+  // by its processes and only the node leaders sum over nodes
+  //
   if (use_mpi) {
-    for (int m=0; m<=mmax; m++) {
-      for (int n=0; n<nmax; n++) {
-	MPI_Allreduce(MPI_IN_PLACE, dens  [m][n].data(), numx*numy,
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	MPI_Allreduce(MPI_IN_PLACE, pot   [m][n].data(), numx*numy,
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	MPI_Allreduce(MPI_IN_PLACE, rforce[m][n].data(), numx*numy,
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	MPI_Allreduce(MPI_IN_PLACE, zforce[m][n].data(), numx*numy,
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Comm comm = MPI_COMM_WORLD;
+    if (gridStore->shared()) {
+      gridStore->sync();
+      comm = NodeShared::leaderComm();
+    }
+
+    if (comm != MPI_COMM_NULL) {
+      for (int m=0; m<=mmax; m++) {
+	for (int n=0; n<nmax; n++) {
+	  MPI_Allreduce(MPI_IN_PLACE, dens  [m][n].data(), numx*numy,
+			MPI_DOUBLE, MPI_SUM, comm);
+	  MPI_Allreduce(MPI_IN_PLACE, pot   [m][n].data(), numx*numy,
+			MPI_DOUBLE, MPI_SUM, comm);
+	  MPI_Allreduce(MPI_IN_PLACE, rforce[m][n].data(), numx*numy,
+			MPI_DOUBLE, MPI_SUM, comm);
+	  MPI_Allreduce(MPI_IN_PLACE, zforce[m][n].data(), numx*numy,
+			MPI_DOUBLE, MPI_SUM, comm);
+	}
       }
     }
+
+    gridStore->sync();		// Wait for the leader
   }
 
   if (myid==0) {
@@ -261,7 +300,12 @@ void BiorthCyl::create_tables()
 	      << std::endl;
   }
 
-  WriteH5Cache();
+  if (BasisCache::enabled()) {
+    if (myid==0)
+      BasisCache::write(cacheKey(), cachename, [this]() { WriteH5Cache(); });
+  }
+  else
+    WriteH5Cache();
 }
 
 
@@ -349,7 +393,7 @@ double BiorthCyl::d_yi_to_z(double y)
 
 // Matrix interpolation on grid for n-body
 void BiorthCyl::interp(double R, double Z,
-		       const std::vector<std::vector<Eigen::MatrixXd>>& mat,
+		       const GridTable& mat,
 		       Eigen::MatrixXd& ret, bool anti_symmetric)
 {
   ret.resize(mmax+1, nmax);
@@ -415,7 +459,7 @@ void BiorthCyl::interp(double R, double Z,
 
 
 double BiorthCyl::interp(int m, int n, double R, double Z,
-			 const std::vector<std::vector<Eigen::MatrixXd>>& mat,
+			 const GridTable& mat,
 			 bool anti_symmetric)
 {
   double ret = 0.0;
@@ -492,6 +536,33 @@ void BiorthCyl::WriteH5Params(HighFive::File& file)
 }
 
 
+BasisCache::Key BiorthCyl::cacheKey()
+{
+  // The target disk enters through its configuration
+  //
+  std::ostringstream sout; sout << diskconf;
+
+  BasisCache::Key key(forceID, Version);
+  key.add("mmax",     mmax)
+     .add("nmax",     nmax)
+     .add("numr",     numr)
+     .add("nmaxfid",  nmaxfid)
+     .add("numx",     numx)
+     .add("numy",     numy)
+     .add("knots",    knots)
+     .add("NQDHT",    NQDHT)
+     .add("rcylmin",  rcylmin)
+     .add("rcylmax",  rcylmax)
+     .add("scale",    scale)
+     .add("cmapR",    cmapR)
+     .add("cmapZ",    cmapZ)
+     .add("logr",     logr ? 1 : 0)
+     .add("biorth",   biorth)
+     .add("diskconf", sout.str());
+  return key;
+}
+
+
 void BiorthCyl::WriteH5Arrays(HighFive::Group& harmonic)
 {
   for (int m=0; m<=mmax; m++) {
@@ -505,9 +576,9 @@ void BiorthCyl::WriteH5Arrays(HighFive::Group& harmonic)
       auto arrays = order.createGroup(sout.str());
 
       HighFive::DataSet ds1 = arrays.createDataSet<Eigen::MatrixXd>("density",   dens  [m][n]);
-      HighFive::DataSet ds2 = arrays.createDataSet("potential", pot   [m][n]);
-      HighFive::DataSet ds3 = arrays.createDataSet("rforce",    rforce[m][n]);
-      HighFive::DataSet ds4 = arrays.createDataSet("zforce",    zforce[m][n]);
+      HighFive::DataSet ds2 = arrays.createDataSet("potential", Eigen::MatrixXd(pot   [m][n]));
+      HighFive::DataSet ds3 = arrays.createDataSet("rforce",    Eigen::MatrixXd(rforce[m][n]));
+      HighFive::DataSet ds4 = arrays.createDataSet("zforce",    Eigen::MatrixXd(zforce[m][n]));
     }
   }
 }
@@ -524,10 +595,10 @@ void BiorthCyl::ReadH5Arrays(HighFive::Group& harmonic)
       sout << n;
       auto arrays = order.getGroup(sout.str());
 
-      arrays.getDataSet("density")  .read(dens  [m][n]);
-      arrays.getDataSet("potential").read(pot   [m][n]);
-      arrays.getDataSet("rforce")   .read(rforce[m][n]);
-      arrays.getDataSet("zforce")   .read(zforce[m][n]);
+      dens  [m][n] = arrays.getDataSet("density")  .read<Eigen::MatrixXd>();
+      pot   [m][n] = arrays.getDataSet("potential").read<Eigen::MatrixXd>();
+      rforce[m][n] = arrays.getDataSet("rforce")   .read<Eigen::MatrixXd>();
+      zforce[m][n] = arrays.getDataSet("zforce")   .read<Eigen::MatrixXd>();
     }
   }
 
@@ -668,7 +739,10 @@ bool BiorthCyl::ReadH5Cache()
     //
     auto harmonic = h5file.getGroup("Harmonic");
 
-    ReadH5Arrays(harmonic);
+    // Only the node leader fills shared arrays
+    //
+    if (not gridStore->shared() or NodeShared::nodeRank()==0)
+      ReadH5Arrays(harmonic);
 
     if (myid==0)
       std::cerr << "---- BiorthCyl::ReadH5Cache: "
@@ -771,7 +771,7 @@ EmpCyl2d::EmpCyl2d
 
   basis_test = false;
 
-  if (not ReadH5Cache()) create_tables();
+  if (not readCache()) create_tables();
 
   configured = true;
 
@@ -795,7 +795,7 @@ EmpCyl2d::EmpCyl2d
 
   basis_test = false;
 
-  if (not ReadH5Cache()) create_tables();
+  if (not readCache()) create_tables();
 
   configured = true;
 
@@ -888,7 +888,7 @@ void EmpCyl2d::create_tables()
     }
   }
 
-  if (myid==0) WriteH5Cache();
+  if (myid==0) writeCache();
 }
 
 void EmpCyl2d::writeBasis(int M, const std::string& filename)
@@ -988,6 +988,58 @@ std::vector<Eigen::MatrixXd> EmpCyl2d::orthoCheck()
 }
 
 
+BasisCache::Key EmpCyl2d::cacheKey()
+{
+  YAML::Emitter y; y << Params;
+
+  // The target model enters through its profile at the centers of
+  // numr radial bins (avoiding a singular center)
+  //
+  Eigen::VectorXd dens(numr), pot(numr);
+  for (int i=0; i<numr; i++) {
+    double r = rmin + (rmax - rmin)*(0.5 + i)/numr;
+    dens[i] = disk->dens(r);
+    pot [i] = disk->pot (r);
+  }
+
+  BasisCache::Key key("EmpCyl2d", Version);
+  key.add("mmax",    mmax)
+     .add("nmaxfid", nmaxfid)
+     .add("nmax",    nmax)
+     .add("numr",    numr)
+     .add("knots",   knots)
+     .add("logr",    logr ? 1 : 0)
+     .add("cmap",    cmap ? 1 : 0)
+     .add("rmin",    rmin)
+     .add("rmax",    rmax)
+     .add("scale",   scale)
+     .add("params",  std::string(y.c_str()))
+     .add("model",   model)
+     .add("biorth",  biorth)
+     .add("dens",    dens)
+     .add("pot",     pot);
+  return key;
+}
+
+bool EmpCyl2d::readCache()
+{
+  if (ReadH5Cache()) return true;
+
+  if (BasisCache::enabled())
+    return BasisCache::read(cacheKey(), cache_name_2d,
+			    [this]() { return ReadH5Cache(); });
+  return false;
+}
+
+void EmpCyl2d::writeCache()
+{
+  if (BasisCache::enabled())
+    BasisCache::write(cacheKey(), cache_name_2d,
+		      [this]() { WriteH5Cache(); });
+  else
+    WriteH5Cache();
+}
+
 void EmpCyl2d::WriteH5Cache()
 {
   if (myid) return;
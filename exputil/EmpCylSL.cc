@@ -5,7 +5,9 @@
 #include <sstream>
 #include <memory>
 #include <limits>
+#include <cstring>
 #include <string>
+#include <random>
 
 #include <yaml-cpp/yaml.h>
 
@@ -51,6 +53,7 @@ bool     EmpCylSL::PCAEOF          = false;
 bool     EmpCylSL::PCADRY          = true;
 bool     EmpCylSL::logarithmic     = false;
 bool     EmpCylSL::enforce_limits  = false;
+bool     EmpCylSL::node_shared     = false;
 int      EmpCylSL::CMAPR           = 1;
 int      EmpCylSL::CMAPZ           = 1;
 int      EmpCylSL::NUMX            = 256;
@@ -679,77 +682,106 @@ SphModTblPtr EmpCylSL::make_sl()
 
 void EmpCylSL::send_eof_grid()
 {
+  // Root has every table
+  //
+  gather_eof_grid(std::vector<int>(eof_blocks().size(), 0));
+}
 
-#ifdef SEND_DEBUG
-  auto blab = [](auto& s, auto& t, auto id, auto m, auto v) {
-		 std::cout << "[" << id << "] " << s << "  " << t
-			     << " (" << m << ", " << v << ")" << std::endl;
-		 };
-  
-  std::cout << "[" << myid << "] (MMAX, rank3)=("
-	    << MMAX << ", " << rank3 << ")" << std::endl;
-#else
-  auto blab = [](auto& s, auto& t, auto id, auto m, auto v) {};
-#endif
 
-  // Send to workers
-  // 
-  for (int m=0; m<=MMAX; m++) {
+std::vector<std::pair<int, int>> EmpCylSL::eof_blocks()
+{
+  std::vector<std::pair<int, int>> blocks;
+  for (int M=0; M<=MMAX; M++) {
+    blocks.push_back({M, 1});		// Cosine
+    if (M) blocks.push_back({M, 0});	// Sine
+  }
+  return blocks;
+}
 
-    // Grids in X--Y
-    // 
-    for (int v=0; v<rank3; v++) {
 
-      blab("before", "potC", myid, m, v);
-      MPI_Bcast(potC[m][v].data(), potC[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "potC", myid, m, v);
+void EmpCylSL::gather_eof_grid(const std::vector<int>& owner)
+{
+  auto blocks = eof_blocks();
+  int  nblk   = blocks.size();
+  int  tsize  = (NUMX+1)*(NUMY+1);
+
+  if (std::none_of(owner.begin(), owner.end(), [](int n) { return n>=0; }))
+    return;
+
+  packStale = true;		// The EOF tables will change
+
+  // With node-shared tables, every process on a node sees the blocks
+  // written there and only the node leaders exchange blocks
+  //
+  bool shared = gridStore and gridStore->shared();
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+  int me = myid, ngrp = numprocs;
 
-      blab("before", "rforceC", myid, m, v);
-      MPI_Bcast(rforceC[m][v].data(), rforceC[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "rforceC", myid, m, v);
+  std::vector<int> group(owner);
+  if (shared) {
+    for (auto & g : group) if (g>=0) g = NodeShared::nodeOf(g);
 
-      blab("before", "zforceC", myid, m, v);
-      MPI_Bcast(zforceC[m][v].data(), zforceC[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "zforceC", myid, m, v);
+    gridStore->sync();
 
-      blab("before", "densC", myid, m, v);
-      MPI_Bcast(densC[m][v].data(), densC[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "densC", myid, m, v);
+    comm = NodeShared::leaderComm();
+    if (comm == MPI_COMM_NULL) {
+      gridStore->sync();	// Wait for the leader
+      return;
     }
+
+    me   = NodeShared::nodeOf(myid);
+    ngrp = NodeShared::numNodes();
   }
 
-  for (int m=1; m<=MMAX; m++) {
-    
-    // Grids in X--Y
-    //
-    for (int v=0; v<rank3; v++) {
+  // Each group contributes its blocks in order
+  //
+  std::vector<int> cnt(ngrp, 0), dsp(ngrp, 0);
+  for (int b=0; b<nblk; b++) {
+    if (group[b]>=0) cnt[group[b]] += NORDER*tsize;
+  }
+  for (int n=1; n<ngrp; n++) dsp[n] = dsp[n-1] + cnt[n-1];
 
-      blab("before", "potS", myid, m, v);
-      MPI_Bcast(potS[m][v].data(), potS[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "potS", myid, m, v);
+  std::vector<double> sendbuf(cnt[me]), recvbuf(dsp.back() + cnt.back());
 
-      blab("before", "rforceS", myid, m, v);
-      MPI_Bcast(rforceS[m][v].data(), rforceS[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "rforceS", myid, m, v);
+  for (int f=0; f<4; f++) {
 
-      blab("before", "zforceS", myid, m, v);
-      MPI_Bcast(zforceS[m][v].data(), zforceS[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "zforceS", myid, m, v);
+    auto table = [&](int b, int v) -> GridTable&
+    {
+      int M = blocks[b].first;
+      bool C = blocks[b].second;
+      switch (f) {
+      case 0:  return C ? potC   [M][v] : potS   [M][v];
+      case 1:  return C ? rforceC[M][v] : rforceS[M][v];
+      case 2:  return C ? zforceC[M][v] : zforceS[M][v];
+      default: return C ? densC  [M][v] : densS  [M][v];
+      }
+    };
 
-      blab("before", "densS", myid, m, v);
-      MPI_Bcast(densS[m][v].data(), densS[m][v].size(),
-		MPI_DOUBLE, 0, MPI_COMM_WORLD);
-      blab("after", "densS", myid, m, v);
+    int off = 0;
+    for (int b=0; b<nblk; b++) {
+      if (group[b] != me) continue;
+      for (int v=0; v<NORDER; v++, off+=tsize)
+	std::copy(table(b, v).data(), table(b, v).data() + tsize,
+		  sendbuf.data() + off);
+    }
+
+    MPI_Allgatherv(sendbuf.data(), cnt[me], MPI_DOUBLE,
+		   recvbuf.data(), cnt.data(), dsp.data(), MPI_DOUBLE, comm);
+
+    std::vector<int> pos(dsp);
+    for (int b=0; b<nblk; b++) {
+      int n = group[b];
+      if (n<0) continue;
+      for (int v=0; v<NORDER; v++, pos[n]+=tsize) {
+	if (n == me) continue;
+	std::copy(recvbuf.data() + pos[n], recvbuf.data() + pos[n] + tsize,
+		  table(b, v).data());
+      }
     }
-      
   }
+
+  if (shared) gridStore->sync();
 }
 
 
@@ -897,10 +929,16 @@ int EmpCylSL::read_cache(void)
   setup_table();
   setup_accumulation();
 
-  // Root tries to read table
+  // Root tries to read table: a matching named cache first and then
+  // the shared basis store
   //
   int retcode;
-  if (myid==0)  retcode = cache_grid(0, cachefile);
+  if (myid==0) {
+    retcode = cache_grid(0, cachefile);
+    if (not retcode and useStore())
+      retcode = BasisCache::read(cacheKey(), cachefile,
+				 [this]() { return cache_grid(0, cachefile)>0; });
+  }
   if (use_mpi)  MPI_Bcast(&retcode, 1, MPI_INT, 0, MPI_COMM_WORLD);
   if (!retcode) return 0;
 
@@ -937,8 +975,33 @@ std::string compare_out(std::string str, U one, U two)
   return sout.str();
 }
 
+BasisCache::Key EmpCylSL::cacheKey()
+{
+  // The conditioning model enters through the tag
+  //
+  BasisCache::Key key("EmpCylSL", Version);
+  key.add("mmax",        MMAX)
+     .add("numx",        NUMX)
+     .add("numy",        NUMY)
+     .add("numr",        NUMR)
+     .add("nmax",        NORDER)
+     .add("lmaxfid",     LMAX)
+     .add("nmaxfid",     NMAX)
+     .add("nodd",        Nodd)
+     .add("cmapr",       CMAPR)
+     .add("cmapz",       CMAPZ)
+     .add("logarithmic", logarithmic ? 1 : 0)
+     .add("rmin",        RMIN)
+     .add("rmax",        RMAX)
+     .add("ascl",        ASCALE)
+     .add("hscl",        HSCALE)
+     .add("tag",         cache_tag);
+  return key;
+}
+
 int EmpCylSL::cache_grid(int readwrite, std::string cachename)
 {
+  packStale = true;		// The EOF tables will change
 
   // Option to reset cache file name
   //
@@ -1325,112 +1388,10 @@ YAML::Node EmpCylSL::getHeader_binary(const std::string& cachefile)
 }
     
 
-void EmpCylSL::receive_eof(int request_id, int MM)
-{
-  int type, icnt, off;
-  int mm;
-
-  MPI_Recv(&type, 1, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG, 
-	   MPI_COMM_WORLD, &status);
-
-  int current_source = status.MPI_SOURCE;
-
-  if (VFLAG & 16)
-    cerr << "Root beginning to receive from " << current_source 
-	 << " . . . " << endl;
-
-  MPI_Recv(&mm, 1, MPI_INT, current_source, MPI_ANY_TAG, 
-	   MPI_COMM_WORLD, &status);
-
-  if (VFLAG & 16)
-    cerr << "Root receiving from " << current_source << ": type=" << type 
-	 << "   M=" << mm << endl;
-
-				// Receive rest of data
-
-  for (int n=0; n<NORDER; n++) {
-    MPI_Recv(&mpi_double_buf2[MPIbufsz*(MPItable*n+0)], 
-	     MPIbufsz, MPI_DOUBLE, current_source, 13 + MPItable*n+1, 
-	     MPI_COMM_WORLD, &status);
-
-    MPI_Recv(&mpi_double_buf2[MPIbufsz*(MPItable*n+1)], 
-	     MPIbufsz, MPI_DOUBLE, current_source, 13 + MPItable*n+2, 
-	     MPI_COMM_WORLD, &status);
-
-    MPI_Recv(&mpi_double_buf2[MPIbufsz*(MPItable*n+2)], 
-	     MPIbufsz, MPI_DOUBLE, current_source, 13 + MPItable*n+3, 
-	     MPI_COMM_WORLD, &status);
-
-    MPI_Recv(&mpi_double_buf2[MPIbufsz*(MPItable*n+3)], 
-	     MPIbufsz, MPI_DOUBLE, current_source, 13 + MPItable*n+4, 
-	     MPI_COMM_WORLD, &status);
-  }
-  
-
-				// Send worker new orders
-  if (request_id >=0) {
-    MPI_Send(&request_id, 1, MPI_INT, current_source, 1, MPI_COMM_WORLD);
-    MPI_Send(&MM, 1, MPI_INT, current_source, 2, MPI_COMM_WORLD);
-  }
-  else {
-    MPI_Send(&request_id, 1, MPI_INT, current_source, 1, MPI_COMM_WORLD);
-  }
-  
-				// Read from buffers
-
-  for (int n=0; n<NORDER; n++) {
-  
-    off = MPIbufsz*(MPItable*n+0);
-    icnt = 0;
-    for (int ix=0; ix<=NUMX; ix++)
-      for (int iy=0; iy<=NUMY; iy++)
-      if (type)
-	potC[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-      else
-	potS[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-	
-
-
-    off = MPIbufsz*(MPItable*n+1);
-    icnt = 0;
-    for (int ix=0; ix<=NUMX; ix++)
-      for (int iy=0; iy<=NUMY; iy++)
-      if (type)
-	rforceC[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-      else
-	rforceS[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-	
-
-    off = MPIbufsz*(MPItable*n+2);
-    icnt = 0;
-    for (int ix=0; ix<=NUMX; ix++)
-      for (int iy=0; iy<=NUMY; iy++)
-      if (type)
-	zforceC[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-      else
-	zforceS[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-    
-
-    off = MPIbufsz*(MPItable*n+3);
-    icnt = 0;
-    for (int ix=0; ix<=NUMX; ix++)
-      for (int iy=0; iy<=NUMY; iy++)
-	if (type)
-	  densC[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-	else
-	  densS[mm][n](ix, iy)  = mpi_double_buf2[off+icnt++];
-  }
-  
-  if (VFLAG & 16)
-    cerr << "Root finished receiving: type=" << type << "   M=" 
-	 << mm << endl;
-
-  return;
-
-}
-
 void EmpCylSL::compute_eof_grid(int request_id, int m)
 {
+  packStale = true;		// The EOF tables will change
+
   // Check for existence of ortho and create if necessary
   //
   if (not ortho)
@@ -1440,9 +1401,6 @@ void EmpCylSL::compute_eof_grid(int request_id, int m)
 
   //  Read in coefficient matrix or
   //  make grid if needed
-  double fac2, dens, potl, potr, pott, fac3, fac4;
-  
-  int icnt, off;
   
   for (int v=0; v<NORDER; v++) {
     tpot[v].setZero();
@@ -1451,165 +1409,99 @@ void EmpCylSL::compute_eof_grid(int request_id, int m)
     tdens[v].setZero();
   }
 
-  for (int ix=0; ix<=NUMX; ix++) {
+  // Each thread computes whole rows of the tables
+  //
+#pragma omp parallel
+  {
+    Eigen::MatrixXd potd, dpot, dend;
+    Eigen::MatrixXd lg(LMAX+1, LMAX+1), dlg(LMAX+1, LMAX+1);
+    double fac2, fac3, fac4, dens, potl, potr, pott;
 
-    double x = XMIN + dX*ix;
-    double r = xi_to_r(x);
+#pragma omp for
+    for (int ix=0; ix<=NUMX; ix++) {
 
-    for (int iy=0; iy<=NUMY; iy++) {
+      double x = XMIN + dX*ix;
+      double r = xi_to_r(x);
+
+      for (int iy=0; iy<=NUMY; iy++) {
 
-      double y = YMIN + dY*iy;
-      double z = y_to_z(y);
+	double y = YMIN + dY*iy;
+	double z = y_to_z(y);
 
-      double rr = sqrt(r*r + z*z) + 1.0e-18;
+	double rr = sqrt(r*r + z*z) + 1.0e-18;
 
-      ortho->get_pot(potd, rr/ASCALE);
-      ortho->get_force(dpot, rr/ASCALE);
-      ortho->get_dens(dend, rr/ASCALE);
+	ortho->get_pot(potd, rr/ASCALE);
+	ortho->get_force(dpot, rr/ASCALE);
+	ortho->get_dens(dend, rr/ASCALE);
 
-      double costh = z/rr;
-      dlegendre_R(LMAX, costh, legs[0], dlegs[0]);
+	double costh = z/rr;
+	dlegendre_R(LMAX, costh, lg, dlg);
       
-      for (int v=0; v<NORDER; v++) {
+	for (int v=0; v<NORDER; v++) {
 
-	for (int ir=0; ir<NMAX; ir++) {
+	  for (int ir=0; ir<NMAX; ir++) {
 
-	  for (int l=m; l<=LMAX; l++) {
+	    for (int l=m; l<=LMAX; l++) {
 
-	    if (m==0) {
-	      fac2 = legs[0](l, m);
+	      if (m==0) {
+		fac2 = lg(l, m);
 
-	      dens = fac2*dend(l, ir) * dfac;
-	      potl = fac2*potd(l, ir) * pfac;
-	      potr = fac2*dpot(l, ir) * ffac;
-	      pott = dlegs[0](l, m)*potd(l, ir) * pfac;
+		dens = fac2*dend(l, ir) * dfac;
+		potl = fac2*potd(l, ir) * pfac;
+		potr = fac2*dpot(l, ir) * ffac;
+		pott = dlg(l, m)*potd(l, ir) * pfac;
 
-	    } else {
+	      } else {
 
-	      fac2 = M_SQRT2;
-	      fac3 = fac2 * legs[0](l, m);
-	      fac4 = fac2 * dlegs[0](l, m);
+		fac2 = M_SQRT2;
+		fac3 = fac2 * lg(l, m);
+		fac4 = fac2 * dlg(l, m);
 	      
-	      dens = fac3*dend(l, ir) * dfac;
-	      potl = fac3*potd(l, ir) * pfac;
-	      potr = fac3*dpot(l, ir) * ffac;
-	      pott = fac4*potd(l, ir) * pfac;
-	    }
+		dens = fac3*dend(l, ir) * dfac;
+		potl = fac3*potd(l, ir) * pfac;
+		potr = fac3*dpot(l, ir) * ffac;
+		pott = fac4*potd(l, ir) * pfac;
+	      }
 	    
-	    int nn = ir + NMAX*(l-m);
+	      int nn = ir + NMAX*(l-m);
 
-	    tpot[v](ix, iy) +=  ef(nn, v) * potl;
+	      tpot[v](ix, iy) +=  ef(nn, v) * potl;
 
-	    trforce[v](ix, iy) += 
-	      -ef(nn, v) * (potr*r/rr - pott*z*r/(rr*rr*rr));
+	      trforce[v](ix, iy) += 
+		-ef(nn, v) * (potr*r/rr - pott*z*r/(rr*rr*rr));
 
-	    tzforce[v](ix, iy) += 
-	      -ef(nn, v) * (potr*z/rr + pott*r*r/(rr*rr*rr));
+	      tzforce[v](ix, iy) += 
+		-ef(nn, v) * (potr*z/rr + pott*r*r/(rr*rr*rr));
 
-	    tdens[v](ix, iy) +=  ef(nn, v) * dens * 0.25/M_PI;
+	      tdens[v](ix, iy) +=  ef(nn, v) * dens * 0.25/M_PI;
+	    }
 	  }
 	}
       }
     }
   }
-
-  // Send tables back to root process
-  //
-  if (use_mpi) {
-
-    MPI_Send(&request_id, 1, MPI_INT, 0, 12, MPI_COMM_WORLD);
-    MPI_Send(&m, 1, MPI_INT, 0, 12, MPI_COMM_WORLD);
-      
-    
-    for (int n=0; n<NORDER; n++) {
-
-      // Potential
-      //
-      off = MPIbufsz*(MPItable*n+0);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = tpot[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " send Potential" << std::endl;
-
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+1, MPI_COMM_WORLD);
-
-      // R force
-      //
-      off = MPIbufsz*(MPItable*n+1);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = trforce[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " sending R force" << std::endl;
-
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+2, MPI_COMM_WORLD);
-
-      // Z force
-      //
-      off = MPIbufsz*(MPItable*n+2);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = tzforce[n](ix, iy);
-    
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " sending Z force" << std::endl;
-
-
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+3, MPI_COMM_WORLD);
-
-      // Density
-      //
-      off = MPIbufsz*(MPItable*n+3);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = tdens[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid 
-		  << ": with request_id=" << request_id
-		  << ", M=" << m << " sending Density" << std::endl;
-	
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+4, MPI_COMM_WORLD);
-	
-    }
-  }
-  // END: MPI packing
-  //
-  // Copy directory to final table arrays for non-MPI
+  
+  // Copy to the final table arrays
   //
-  else {
-    for (int n=0; n<NORDER; n++) {
-      if (request_id) {
-	potC   [m][n] = tpot[n];
-	rforceC[m][n] = trforce[n];
-	zforceC[m][n] = tzforce[n];
-	densC  [m][n] = tdens[n];
-      } else {
-	potS   [m][n] = tpot[n];
-	rforceS[m][n] = trforce[n];
-	zforceS[m][n] = trforce[n];
-	densS  [m][n] = tdens[n];
-      }
+  for (int n=0; n<NORDER; n++) {
+    if (request_id) {
+      potC   [m][n] = tpot[n];
+      rforceC[m][n] = trforce[n];
+      zforceC[m][n] = tzforce[n];
+      densC  [m][n] = tdens[n];
+    } else {
+      potS   [m][n] = tpot[n];
+      rforceS[m][n] = trforce[n];
+      zforceS[m][n] = tzforce[n];
+      densS  [m][n] = tdens[n];
     }
   }
 }
 
 void EmpCylSL::compute_even_odd(int request_id, int m)
 {
+  packStale = true;		// The EOF tables will change
+
   // check for ortho
   //
   if (not ortho)
@@ -1617,9 +1509,6 @@ void EmpCylSL::compute_even_odd(int request_id, int m)
 					  LMAX, NMAX, NUMR, RMIN, RMAX*0.99,
 					  false, 1, 1.0);
 
-  double dens, potl, potr, pott;
-  
-  int icnt, off;
   
   for (int v=0; v<NORDER; v++) {
     tpot[v].setZero();
@@ -1628,211 +1517,142 @@ void EmpCylSL::compute_even_odd(int request_id, int m)
     tdens[v].setZero();
   }
 
-  for (int ix=0; ix<=NUMX; ix++) {
+  // Each thread computes whole rows of the tables
+  //
+#pragma omp parallel
+  {
+    Eigen::MatrixXd potd, dpot, dend;
+    Eigen::MatrixXd lg(LMAX+1, LMAX+1), dlg(LMAX+1, LMAX+1);
+    double dens, potl, potr, pott;
 
-    double x = XMIN + dX*ix;
-    double r = xi_to_r(x);
+#pragma omp for
+    for (int ix=0; ix<=NUMX; ix++) {
 
-    for (int iy=0; iy<=NUMY; iy++) {
+      double x = XMIN + dX*ix;
+      double r = xi_to_r(x);
+
+      for (int iy=0; iy<=NUMY; iy++) {
 
-      double y = YMIN + dY*iy;
-      double z = y_to_z(y);
+	double y = YMIN + dY*iy;
+	double z = y_to_z(y);
 
-      double rr = sqrt(r*r + z*z) + 1.0e-18;
+	double rr = sqrt(r*r + z*z) + 1.0e-18;
 
-      ortho->get_pot(potd, rr/ASCALE);
-      ortho->get_force(dpot, rr/ASCALE);
-      ortho->get_dens(dend, rr/ASCALE);
+	ortho->get_pot(potd, rr/ASCALE);
+	ortho->get_force(dpot, rr/ASCALE);
+	ortho->get_dens(dend, rr/ASCALE);
 
-      double costh = z/rr;
-      dlegendre_R(LMAX, costh, legs[0], dlegs[0]);
+	double costh = z/rr;
+	dlegendre_R(LMAX, costh, lg, dlg);
       
-      // Do the even eigenfunction first
-      //
-      for (int v=0; v<Neven; v++) {
+	// Do the even eigenfunction first
+	//
+	for (int v=0; v<Neven; v++) {
 
-	for (int ir=0; ir<NMAX; ir++) {
+	  for (int ir=0; ir<NMAX; ir++) {
 
-	  for (int il=0; il<lE[m].size(); il++) {
+	    for (int il=0; il<lE[m].size(); il++) {
 
-	    int l = lE[m][il];	// Even l values first
+	      int l = lE[m][il];	// Even l values first
 	    
-	    if (m==0) {
-	      double fac2 = legs[0](l, m);
+	      if (m==0) {
+		double fac2 = lg(l, m);
 
-	      dens = fac2*dend(l, ir) * dfac;
-	      potl = fac2*potd(l, ir) * pfac;
-	      potr = fac2*dpot(l, ir) * ffac;
-	      pott = dlegs[0](l, m)*potd(l, ir) * pfac;
+		dens = fac2*dend(l, ir) * dfac;
+		potl = fac2*potd(l, ir) * pfac;
+		potr = fac2*dpot(l, ir) * ffac;
+		pott = dlg(l, m)*potd(l, ir) * pfac;
 
-	    } else {
+	      } else {
 
-	      double fac2 = M_SQRT2;
-	      double fac3 = fac2 *  legs[0](l, m);
-	      double fac4 = fac2 * dlegs[0](l, m);
+		double fac2 = M_SQRT2;
+		double fac3 = fac2 *  lg(l, m);
+		double fac4 = fac2 * dlg(l, m);
 	      
-	      dens = fac3*dend(l, ir) * dfac;
-	      potl = fac3*potd(l, ir) * pfac;
-	      potr = fac3*dpot(l, ir) * ffac;
-	      pott = fac4*potd(l, ir) * pfac;
-	    }
+		dens = fac3*dend(l, ir) * dfac;
+		potl = fac3*potd(l, ir) * pfac;
+		potr = fac3*dpot(l, ir) * ffac;
+		pott = fac4*potd(l, ir) * pfac;
+	      }
 	    
-	    int nn = ir + NMAX*il;
+	      int nn = ir + NMAX*il;
 
-	    tpot[v](ix, iy) +=  efE(nn, v) * potl;
+	      tpot[v](ix, iy) +=  efE(nn, v) * potl;
 
-	    trforce[v](ix, iy) += 
-	      -efE(nn, v) * (potr*r/rr - pott*z*r/(rr*rr*rr));
+	      trforce[v](ix, iy) += 
+		-efE(nn, v) * (potr*r/rr - pott*z*r/(rr*rr*rr));
 
-	    tzforce[v](ix, iy) += 
-	      -efE(nn, v) * (potr*z/rr + pott*r*r/(rr*rr*rr));
+	      tzforce[v](ix, iy) += 
+		-efE(nn, v) * (potr*z/rr + pott*r*r/(rr*rr*rr));
 
-	    tdens[v](ix, iy) +=  efE(nn, v) * dens * 0.25/M_PI;
+	      tdens[v](ix, iy) +=  efE(nn, v) * dens * 0.25/M_PI;
+	    }
 	  }
 	}
-      }
 
-      for (int v=Neven; v<NORDER; v++) {
+	for (int v=Neven; v<NORDER; v++) {
 
-	int w = v - Neven;	// Index in odd eigenfunctions
+	  int w = v - Neven;	// Index in odd eigenfunctions
 
-	for (int ir=0; ir<NMAX; ir++) {
+	  for (int ir=0; ir<NMAX; ir++) {
 
-	  for (int il=0; il<lO[m].size(); il++) {
+	    for (int il=0; il<lO[m].size(); il++) {
 
-	    int l = lO[m][il];
+	      int l = lO[m][il];
 
-	    if (m==0) {
-	      double fac2 = legs[0](l, m);
+	      if (m==0) {
+		double fac2 = lg(l, m);
 
-	      dens = fac2*dend(l, ir) * dfac;
-	      potl = fac2*potd(l, ir) * pfac;
-	      potr = fac2*dpot(l, ir) * ffac;
-	      pott = dlegs[0](l, m)*potd(l, ir) * pfac;
+		dens = fac2*dend(l, ir) * dfac;
+		potl = fac2*potd(l, ir) * pfac;
+		potr = fac2*dpot(l, ir) * ffac;
+		pott = dlg(l, m)*potd(l, ir) * pfac;
 
-	    } else {
+	      } else {
 	      
-	      double fac2 = M_SQRT2;
-	      double fac3 = fac2 *  legs[0](l, m);
-	      double fac4 = fac2 * dlegs[0](l, m);
+		double fac2 = M_SQRT2;
+		double fac3 = fac2 *  lg(l, m);
+		double fac4 = fac2 * dlg(l, m);
 	      
-	      dens = fac3*dend(l, ir) * dfac;
-	      potl = fac3*potd(l, ir) * pfac;
-	      potr = fac3*dpot(l, ir) * ffac;
-	      pott = fac4*potd(l, ir) * pfac;
-	    }
+		dens = fac3*dend(l, ir) * dfac;
+		potl = fac3*potd(l, ir) * pfac;
+		potr = fac3*dpot(l, ir) * ffac;
+		pott = fac4*potd(l, ir) * pfac;
+	      }
 	    
-	    int nn = ir + NMAX*il;
+	      int nn = ir + NMAX*il;
 
-	    tpot[v](ix, iy) +=  efO(nn, w) * potl;
+	      tpot[v](ix, iy) +=  efO(nn, w) * potl;
 
-	    trforce[v](ix, iy) += 
-	      -efO(nn, w) * (potr*r/rr - pott*z*r/(rr*rr*rr));
+	      trforce[v](ix, iy) += 
+		-efO(nn, w) * (potr*r/rr - pott*z*r/(rr*rr*rr));
 
-	    tzforce[v](ix, iy) += 
-	      -efO(nn, w) * (potr*z/rr + pott*r*r/(rr*rr*rr));
+	      tzforce[v](ix, iy) += 
+		-efO(nn, w) * (potr*z/rr + pott*r*r/(rr*rr*rr));
 
-	    tdens[v](ix, iy) +=  efO(nn, w) * dens * 0.25/M_PI;
+	      tdens[v](ix, iy) +=  efO(nn, w) * dens * 0.25/M_PI;
+	    }
 	  }
 	}
       }
     }
   }
   
-  
-  // Send tables back to root process
+  // Copy to the final table arrays
   //
-  if (use_mpi) {
-      
-    MPI_Send(&request_id, 1, MPI_INT, 0, 12, MPI_COMM_WORLD);
-    MPI_Send(&m, 1, MPI_INT, 0, 12, MPI_COMM_WORLD);
-      
-    
-    for (int n=0; n<NORDER; n++) {
-
-      // Potential
-      //
-      off = MPIbufsz*(MPItable*n+0);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = tpot[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " send Potential" << std::endl;
-
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+1, MPI_COMM_WORLD);
-
-      // R force
-      //
-      off = MPIbufsz*(MPItable*n+1);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = trforce[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " sending R force" << std::endl;
-      
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+2, MPI_COMM_WORLD);
-
-      // Z force
-      //
-      off = MPIbufsz*(MPItable*n+2);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	mpi_double_buf2[off + icnt++] = tzforce[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid << ": with request_id=" << request_id
-		  << ", M=" << m << " sending Z force" << std::endl;
-
-
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+3, MPI_COMM_WORLD);
-
-      // Density
-      //
-      off = MPIbufsz*(MPItable*n+3);
-      icnt = 0;
-      for (int ix=0; ix<=NUMX; ix++)
-	for (int iy=0; iy<=NUMY; iy++)
-	  mpi_double_buf2[off + icnt++] = tdens[n](ix, iy);
-      
-      if (VFLAG & 16)
-	std::cerr << "Worker " << setw(4) << myid 
-		  << ": with request_id=" << request_id
-		  << ", M=" << m << " sending Density" << std::endl;
-      
-      MPI_Send(&mpi_double_buf2[off], MPIbufsz, MPI_DOUBLE, 0, 
-	       13 + MPItable*n+4, MPI_COMM_WORLD);
-    }
-  }
-  // END: MPI packing
-  //
-  // Copy directory to final table arrays for non-MPI
-  //
-  else {
-    for (int n=0; n<NORDER; n++) {
-      if (request_id) {
-	potC   [m][n] = tpot[n];
-	rforceC[m][n] = trforce[n];
-	zforceC[m][n] = tzforce[n];
-	densC  [m][n] = tdens[n];
-      } else {
-	potS   [m][n] = tpot[n];
-	rforceS[m][n] = trforce[n];
-	zforceS[m][n] = trforce[n];
-	densS  [m][n] = tdens[n];
-      }
+  for (int n=0; n<NORDER; n++) {
+    if (request_id) {
+      potC   [m][n] = tpot[n];
+      rforceC[m][n] = trforce[n];
+      zforceC[m][n] = tzforce[n];
+      densC  [m][n] = tdens[n];
+    } else {
+      potS   [m][n] = tpot[n];
+      rforceS[m][n] = trforce[n];
+      zforceS[m][n] = tzforce[n];
+      densS  [m][n] = tdens[n];
     }
   }
-
 }
 
 
@@ -2034,6 +1854,8 @@ void EmpCylSL::init_pca()
 
 void EmpCylSL::setup_table()
 {
+  packStale = true;		// The EOF tables will change
+
   // Create storage for EOF tables
   //
   rank2   = NMAX*(LMAX+1);
@@ -2048,46 +1870,7 @@ void EmpCylSL::setup_table()
   YMAX    = z_to_y( Rtable*ASCALE);
   dY      = (YMAX - YMIN)/NUMY;
 
-  potC    .resize(MMAX+1);
-  rforceC .resize(MMAX+1);
-  zforceC .resize(MMAX+1);
-  
-  potS    .resize(MMAX+1);
-  rforceS .resize(MMAX+1);
-  zforceS .resize(MMAX+1);
-  
-  densC   .resize(MMAX+1);
-  densS   .resize(MMAX+1);
-
-  for (int m=0; m<=MMAX; m++) {
-
-    potC[m]   .resize(rank3);
-    rforceC[m].resize(rank3);
-    zforceC[m].resize(rank3);
-    densC[m]  .resize(rank3);
-    
-    for (int v=0; v<rank3; v++) {
-      potC   [m][v].resize(NUMX+1, NUMY+1);
-      rforceC[m][v].resize(NUMX+1, NUMY+1);
-      zforceC[m][v].resize(NUMX+1, NUMY+1);
-      densC  [m][v].resize(NUMX+1, NUMY+1);
-    }
-  }
-  
-  for (int m=1; m<=MMAX; m++) {
-    
-    potS[m]   .resize(rank3);
-    rforceS[m].resize(rank3);
-    zforceS[m].resize(rank3);
-    densS[m]  .resize(rank3);
-    
-    for (int v=0; v<rank3; v++) {
-      potS   [m][v].resize(NUMX+1, NUMY+1);
-      rforceS[m][v].resize(NUMX+1, NUMY+1);
-      zforceS[m][v].resize(NUMX+1, NUMY+1);
-      densS  [m][v].resize(NUMX+1, NUMY+1);
-    }
-  }
+  allocate_grid();
 
   vc.resize(nthrds);
   vs.resize(nthrds);
@@ -2098,6 +1881,39 @@ void EmpCylSL::setup_table()
 
 }
 
+void EmpCylSL::allocate_grid()
+{
+  std::size_t tsize = static_cast<std::size_t>(NUMX+1)*(NUMY+1);
+  std::size_t total = tsize*NORDER*4*(2*MMAX+1);
+
+  // Already allocated with these dimensions
+  //
+  if (gridStore and gridStore->size()==total and
+      potC.size()==MMAX+1 and potC[0].size()==NORDER and
+      potC[0][0].rows()==NUMX+1) return;
+
+  bool share = node_shared and use_mpi;
+
+  auto store = std::make_shared<NodeShared>(total, share);
+  double* p  = store->data();
+
+  auto make = [&](std::vector<std::vector<GridTable>>& tbl, int mmin)
+  {
+    tbl.clear();
+    tbl.resize(MMAX+1);
+    for (int m=mmin; m<=MMAX; m++) {
+      for (int v=0; v<NORDER; v++, p+=tsize)
+	tbl[m].emplace_back(p, NUMX+1, NUMY+1);
+    }
+  };
+
+  make(potC, 0);  make(rforceC, 0);  make(zforceC, 0);  make(densC, 0);
+  make(potS, 1);  make(rforceS, 1);  make(zforceS, 1);  make(densS, 1);
+
+  gridStore = store;
+  gridStore->report("EmpCylSL EOF tables");
+}
+
 void EmpCylSL::setup_eof()
 {
   if (SC.size()==0 and SCe.size()==0) {
@@ -2242,7 +2058,6 @@ void EmpCylSL::setup_eof()
 
     MPIbufsz = (NUMX+1)*(NUMY+1);
 
-    mpi_double_buf2.resize(MPIbufsz*NORDER*MPItable);
     mpi_double_buf3.resize(rank3);
   }
 
@@ -3052,167 +2867,66 @@ void EmpCylSL::make_eof(void)
   // END: DEBUG
 
 
-  // Enter this loop for each MPI process
+  // Only tabulate the blocks that changed
   //
-  if (use_mpi) {
+  bool changed = true;
 
-    if (myid==0) {
-
-      int worker = 0;
-      int request_id = 1;	// Begin with cosine case, 0 is sine case
-      int M = 0;		// Begin with M=0
+  if (eofIncremental) {
+    changed = make_eof_incremental(timer);
+  }
+  // Each process solves the eigenproblems and computes the tables
+  // for its share of the blocks
+  //
+  else {
 
-      while (M<=MMAX) {
-	
-	// Send request to worker
-	if (worker<numprocs-1) {
-	  
-	  worker++;
-	
-	  MPI_Send(&request_id, 1, MPI_INT, worker, 1, MPI_COMM_WORLD);
-	  MPI_Send(&M,  1, MPI_INT, worker, 2, MPI_COMM_WORLD);
-	  
-	  // Increment counters
-	  request_id++;
-	  if (request_id>1) {
-	    M++;
-	    request_id = 0;
-	  }
-	  
-	  if (VFLAG & 16)
-	    std::cerr << "root in make_eof: done waiting on Worker " << worker 
-		      << ", next M=" << M << std::endl;
-	}
-	
-	// If M>MMAX before processor queue exhausted,
-	// exit loop and reap the worker data
-	if (M>MMAX) break;
-	
-	if (worker == numprocs-1) {
-	  
-	  //
-	  // <Wait and receive and send new request>
-	  //
-	  receive_eof(request_id, M);
-	  
-	  // Increment counters
-	  
-	  request_id++;
-	  if (request_id>1) {
-	    M++;
-	    request_id = 0;
-	  }
-	}
-      }
-      
-      //
-      // <Wait for all workers to return and flag to continue>
-      //
-      if (VFLAG & 16)
-	std::cerr << "root in make_eof: now waiting for all workers to finish" 
-		  << std::endl;
-      
-      // Dispatch resting workers
-      if (worker < numprocs-1) {
-	request_id = -1;		// request_id < 0 means continue
-	for (int s=numprocs-1; s>worker; s--) {
-	  MPI_Send(&request_id, 1, MPI_INT, s, 1, MPI_COMM_WORLD);
-	}
-      }
-      
-      // Get data from working workers
-      while (worker) {
-	receive_eof(-1,0);
-	worker--;
-      }
-      
-    } else {
+    auto blocks = eof_blocks();
+    int  nblk   = blocks.size();
+    int  nproc  = use_mpi ? numprocs : 1;
 
-      int M, request_id;
+    std::vector<int> owner(nblk);
 
-      while (1) {
-	// Wait for request . . .
-	MPI_Recv(&request_id, 1, 
-		 MPI_INT, 0, 1, MPI_COMM_WORLD, &status);
-      
-				// Done!
-	if (request_id<0) {
-	  if (VFLAG & 16)
-	    cerr << "Worker " << setw(4) << myid 
-		 << ": received DONE signal" << endl;
-	  break;
-	}
-	
-	MPI_Recv(&M, 1, 
-		 MPI_INT, 0, 2, MPI_COMM_WORLD, &status);
-	
-	if (VFLAG & 16)
-	  std::cerr << "Worker " << std::setw(4) << myid
-		    << ": received orders type="
-		    << request_id << "  M=" << M << std::endl;
-	
-	eigen_problem(request_id, M, timer);
-      }
-    }
+    for (int b=0; b<nblk; b++) {
+      owner[b] = b % nproc;
+      if (owner[b] != myid) continue;
 
-    // Send grid to all processes
-    //
-    if (VFLAG & 2) {
-      MPI_Barrier(MPI_COMM_WORLD);
-      cerr << "Process " << std::setw(4) << myid 
-	   << ": about to enter send_eof_grid" << endl;
-    }
-    
-    if (VFLAG & 16) {
-      timer.reset();
-      timer.start();
-    }
+      int M = blocks[b].first, request_id = blocks[b].second;
 
-    send_eof_grid();
+      if (VFLAG & 16)
+	std::cout << "Process " << std::setw(4) << myid
+		  << ": begin computing type=" << request_id
+		  << " M=" << M << std::endl;
 
-    if (VFLAG & 16) {
-      std::cout << "Process " << std::setw(4) << myid << ": grid reduced in " 
-		<< timer.stop()  << " seconds"
-		<< std::endl;
-    }
-    else if (VFLAG & 2) {
-      std::cerr << "Process " << setw(4) << myid
-		<< ": grid reduce completed" << std::endl;
+      eigen_problem(request_id, M, timer);
     }
-  }
-  // MPI End
-  //
-  // Do the following loop for a single process
-  else {
 
-    // Non-MPI loop
+    // Share the tables with all processes
     //
-    for (int M=0; M<=MMAX; M++) {
+    if (use_mpi) {
+
       if (VFLAG & 16) {
-	std::cout << "Process " << std::setw(4) << myid
-		  << ": Begin computing M=" << M << std::endl;
 	timer.reset();
 	timer.start();
       }
 
-      if (M==0) {
-	eigen_problem(1, M, timer); // Cosine
-      } else {
-	eigen_problem(0, M, timer); // Sine
-	eigen_problem(1, M, timer); // Cosine
-      }
+      gather_eof_grid(owner);
 
       if (VFLAG & 16) {
-	std::cout << "Process " << std::setw(4) << myid
-		  << ": Computed M=" << M << " in "
-		  << timer.stop()  << " seconds" << std::endl;
+	std::cout << "Process " << std::setw(4) << myid << ": grid shared in "
+		  << timer.stop()  << " seconds"
+		  << std::endl;
       }
     }
   }
 
   // Cache table for restarts
   //
-  if (myid==0) cache_grid(1, cachefile);
+  if (myid==0 and changed) {
+    if (useStore())
+      BasisCache::write(cacheKey(), cachefile,
+			[this]() { cache_grid(1, cachefile); });
+    else
+      cache_grid(1, cachefile);
+  }
   
   // Basis complete but still need to compute coefficients
   //
@@ -3227,6 +2941,11 @@ void EmpCylSL::make_eof(void)
 }
 
 
+// Leading eigenpairs of a symmetric matrix, defined below
+//
+static int eof_eigen(const Eigen::MatrixXd& A, Eigen::MatrixXd& V,
+		     Eigen::VectorXd& lam, int nkeep, bool warm, int maxit);
+
 void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
 {
 
@@ -3405,28 +3124,13 @@ void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
     
     if (EvenOdd) {
       
-      Eigen::EigenSolver<Eigen::MatrixXd> esE(varE[M]);
-      Eigen::EigenSolver<Eigen::MatrixXd> esO(varO[M]);
-      
-      evE = esE.eigenvalues().real();
-      evO = esO.eigenvalues().real();
-      
-      efE = esE.eigenvectors().real();
-      efO = esO.eigenvectors().real();
-      
-      // Choose sign conventions for the ef table
+      // Sorted by decreasing eigenvalue with the same sign
+      // convention as the incremental path
       //
-      int nfid = std::min<int>(4, efE.rows()) - 1;
-
-      // Even case
-      for (int j=0; j<efE.cols(); j++) {
-	if (efE(nfid, j) < 0.0) efE.col(j) *= -1;
-      }
-
-      // Odd case
-      for (int j=0; j<efO.cols(); j++) {
-	if (efO(nfid, j) < 0.0) efO.col(j) *= -1;
-      }
+      efE.resize(varE[M].rows(), varE[M].cols());
+      efO.resize(varO[M].rows(), varO[M].cols());
+      eof_eigen(varE[M], efE, evE, 0, false, 0);
+      eof_eigen(varO[M], efO, evO, 0, false, 0);
 
       if (VFLAG & 32) {
 	
@@ -3468,17 +3172,11 @@ void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
       
     } else {
       
-      Eigen::EigenSolver<Eigen::MatrixXd> es(var[M]);
-      
-      ev = es.eigenvalues().real();
-      ef = es.eigenvectors().real();
-      
-      // Sign convention
+      // Sorted by decreasing eigenvalue with the same sign
+      // convention as the incremental path
       //
-      int nfid = std::min<int>(4, efE.rows()) - 1;
-      for (int j=0; j<ef.cols(); j++) {
-	if (ef(nfid, j) < 0.0) ef.col(j) *= -1;
-      }
+      ef.resize(var[M].rows(), var[M].cols());
+      eof_eigen(var[M], ef, ev, 0, false, 0);
 
       if (VFLAG & 32) {
 	
@@ -3644,31 +3342,13 @@ void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
     
     if (EvenOdd) {
       
-      Eigen::EigenSolver<Eigen::MatrixXd> esE(varE[M]);
-      Eigen::EigenSolver<Eigen::MatrixXd> esO(varO[M]);
-      
-      evE = esE.eigenvalues().real();
-      evO = esO.eigenvalues().real();
-      
-      efE = esE.eigenvectors().real();
-      efO = esO.eigenvectors().real();
-      
-
-      // Sign convention
+      // Sorted by decreasing eigenvalue with the same sign
+      // convention as the incremental path
       //
-      int nfid = std::min<int>(4, efE.rows()) - 1;
-
-      // Even case
-      //
-      for (int j=0; j<efE.cols(); j++) {
-	if (efE(nfid, j) < 0.0) efE.col(j) *= -1;
-      }
-
-      // Odd case
-      //
-      for (int j=0; j<efO.cols(); j++) {
-	if (efO(nfid, j) < 0.0) efO.col(j) *= -1;
-      }
+      efE.resize(varE[M].rows(), varE[M].cols());
+      efO.resize(varO[M].rows(), varO[M].cols());
+      eof_eigen(varE[M], efE, evE, 0, false, 0);
+      eof_eigen(varO[M], efO, evO, 0, false, 0);
 
       if (VFLAG & 32) {
 	
@@ -3697,17 +3377,11 @@ void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
       
     } else {
       
-      Eigen::EigenSolver<Eigen::MatrixXd> es(var[M]);
-      
-      ev = es.eigenvalues().real();
-      ef = es.eigenvectors().real();
-      
-      // Sign convention
+      // Sorted by decreasing eigenvalue with the same sign
+      // convention as the incremental path
       //
-      int nfid = std::min<int>(4, efE.rows()) - 1;
-      for (int j=0; j<ef.cols(); j++) {
-	if (ef(nfid, j) < 0.0) ef.col(j) *= -1;
-      }
+      ef.resize(var[M].rows(), var[M].cols());
+      eof_eigen(var[M], ef, ev, 0, false, 0);
 
       if (VFLAG & 32) {
 	
@@ -3761,6 +3435,263 @@ void EmpCylSL::eigen_problem(int request_id, int M, Timer& timer)
 	      << ", M=" << M << " COMPLETED compute_eof_grid" << std::endl;
 }
 
+
+Eigen::MatrixXd EmpCylSL::eof_covariance(int request_id, int M, int parity)
+{
+  // Select the accumulated upper triangle for this block
+  //
+  int n;
+  auto cov = [&](int i, int j) -> double
+  {
+    if (EvenOdd) {
+      if (parity==0) return request_id ? SCe[0][M][i][j] : SSe[0][M][i][j];
+      else           return request_id ? SCo[0][M][i][j] : SSo[0][M][i][j];
+    }
+    return request_id ? SC[0][M][i][j] : SS[0][M][i][j];
+  };
+
+  if (EvenOdd) n = NMAX*(parity==0 ? lE[M].size() : lO[M].size());
+  else         n = NMAX*(LMAX-M+1);
+
+  Eigen::MatrixXd A(n, n);
+  for (int i=0; i<n; i++) {
+    for (int j=i; j<n; j++) A(i, j) = A(j, i) = cov(i, j);
+  }
+
+  // Same normalization as eigen_problem()
+  //
+  double maxV = A.cwiseAbs().maxCoeff();
+  if (request_id) {
+    if (maxV>0.0) A /= maxV;
+  } else {
+    if (maxV>1.0e-5) A /= maxV;
+  }
+
+  return A;
+}
+
+// Leading eigenpairs of a symmetric matrix sorted by decreasing
+// eigenvalue.  With warm=true, V holds the starting subspace and the
+// pairs are found by subspace iteration with Rayleigh-Ritz
+// projection; the return value is the number of iterations or -1 if
+// the first nkeep pairs did not converge.  The iteration gives up
+// early once the observed residual reduction per step projects past
+// maxit.  Otherwise, this is a full solve returning the first
+// V.cols() pairs and the return value is 0.  eigen_problem() uses
+// the full solve so both paths tabulate the same ordered functions.
+//
+static int eof_eigen(const Eigen::MatrixXd& A, Eigen::MatrixXd& V,
+		     Eigen::VectorXd& lam, int nkeep, bool warm, int maxit)
+{
+  const double tol = 1.0e-10;
+
+  int n = A.rows(), k = V.cols();
+
+  auto sign = [&]()
+  {
+    // Same convention as eigen_problem()
+    int nfid = std::min<int>(4, n) - 1;
+    for (int j=0; j<V.cols(); j++) {
+      if (V(nfid, j) < 0.0) V.col(j) *= -1;
+    }
+  };
+
+  if (not warm) {
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(A);
+    V   = es.eigenvectors().rowwise().reverse().leftCols(k);
+    lam = es.eigenvalues().reverse().head(k);
+    sign();
+    return 0;
+  }
+
+  double last = 0.0;
+
+  for (int it=1; it<=maxit; it++) {
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr(A*V);
+    Eigen::MatrixXd Q = qr.householderQ() * Eigen::MatrixXd::Identity(n, k);
+    Eigen::MatrixXd H = Q.transpose() * A * Q;
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(H);
+    V   = Q * es.eigenvectors().rowwise().reverse();
+    lam = es.eigenvalues().reverse();
+
+    Eigen::MatrixXd R = A*V.leftCols(nkeep) -
+      V.leftCols(nkeep) * lam.head(nkeep).asDiagonal();
+
+    double scale = std::max<double>(std::fabs(lam(0)), 1.0e-30);
+    double res   = nkeep ? R.colwise().norm().maxCoeff() : 0.0;
+    if (res < tol*scale) {
+      sign();
+      return it;
+    }
+
+    // Stop when the residual stalls or the observed rate cannot
+    // reach the tolerance within maxit
+    //
+    if (it>2) {
+      double rate = res/last;
+      if (rate >= 1.0) return -1;
+      if (it + std::log(tol*scale/res)/std::log(rate) > maxit) return -1;
+    }
+    last = res;
+  }
+
+  return -1;
+}
+
+bool EmpCylSL::make_eof_incremental(Timer& timer)
+{
+  const int guard = 4;		// Extra subspace columns for convergence
+  const int maxit = 50;		// Subspace iterations before a full solve
+
+  int nproc = use_mpi ? numprocs : 1;
+
+  // Each block is solved and tabulated by a fixed process so that its
+  // history stays in one place
+  //
+  auto blocks = eof_blocks();
+  int  nblk   = blocks.size();
+  eofChanges.resize(nblk);
+
+  for (int b=0; b<nblk; b++) {
+
+    if (b % nproc != myid % nproc) continue;
+
+    int M = blocks[b].first, request_id = blocks[b].second;
+    auto & B = eofBlocks[blocks[b]];
+    auto & C = eofChanges[b];
+
+    C = {M, request_id==1, B.ready, false, 0, 0.0, 1.0, 0.0};
+
+    if (VFLAG & 16) {
+      timer.reset();
+      timer.start();
+    }
+
+    Eigen::MatrixXd vec[2];
+    Eigen::VectorXd val[2];
+
+    for (int p=0; p<(EvenOdd ? 2 : 1); p++) {
+
+      int nkeep = EvenOdd ? (p==0 ? Neven : Nodd) : NORDER;
+
+      // Blend with the retained covariance
+      //
+      Eigen::MatrixXd A = eof_covariance(request_id, M, p);
+      if (B.ready) A = eofForget*B.cov[p] + (1.0 - eofForget)*A;
+      B.cov[p] = A;
+
+      int n = A.rows();
+      nkeep = std::min<int>(nkeep, n);
+
+      // Warm start from the tabulated subspace
+      //
+      int iter = -1;
+      if (B.ready) {
+	vec[p] = B.vec[p];
+	iter = eof_eigen(A, vec[p], val[p], nkeep, true, maxit);
+      }
+
+      if (iter<0) {
+	if (B.ready and (VFLAG & 16))
+	  std::cout << "Process " << std::setw(4) << myid
+		    << ": incremental EOF M=" << M
+		    << (request_id ? " cos" : " sin")
+		    << (EvenOdd ? (p ? " odd" : " even") : "")
+		    << " subspace iteration did not converge,"
+		    << " using a full solve" << std::endl;
+
+	vec[p].resize(n, std::min<int>(n, nkeep+guard));
+	eof_eigen(A, vec[p], val[p], nkeep, false, maxit);
+	if (B.ready) C.warm = false;
+      }
+
+      C.iterations = std::max<int>(C.iterations, iter);
+
+      if (not B.ready or nkeep==0) continue;
+
+      // Compare the retained subspaces
+      //
+      Eigen::MatrixXd S =
+	B.vec[p].leftCols(nkeep).transpose() * vec[p].leftCols(nkeep);
+      Eigen::JacobiSVD<Eigen::MatrixXd> svd(S);
+      double smin = std::clamp<double>(svd.singularValues().minCoeff(), -1.0, 1.0);
+
+      C.angle   = std::max<double>(C.angle, std::acos(smin));
+      C.overlap = std::min<double>(C.overlap,
+				   S.diagonal().cwiseAbs().mean());
+
+      double norm = B.val[p].head(nkeep).norm();
+      if (norm>0.0)
+	C.eigen = std::max<double>
+	  (C.eigen, (val[p].head(nkeep) - B.val[p].head(nkeep)).norm()/norm);
+    }
+
+    C.regenerated = not B.ready or C.angle > eofTol;
+
+    if (C.regenerated) {
+
+      // Tabulate from the new eigenvectors
+      //
+      for (int p=0; p<(EvenOdd ? 2 : 1); p++) {
+	B.vec[p] = vec[p];
+	B.val[p] = val[p];
+      }
+
+      if (EvenOdd) {
+	efE = vec[0]; evE = val[0];
+	efO = vec[1]; evO = val[1];
+	compute_even_odd(request_id, M);
+      } else {
+	ef  = vec[0]; ev  = val[0];
+	compute_eof_grid(request_id, M);
+      }
+    }
+
+    B.ready = true;
+
+    if (VFLAG & 16) {
+      std::cout << "Process " << std::setw(4) << myid
+		<< ": incremental EOF M=" << M
+		<< (request_id ? " cos" : " sin")
+		<< " angle=" << C.angle
+		<< " iterations=" << C.iterations
+		<< (C.regenerated ? " regenerated" : " kept")
+		<< " in " << timer.stop() << " seconds" << std::endl;
+    }
+  }
+
+  // Share the changes and the regenerated tables from their owners
+  //
+  std::vector<int> owner(nblk, -1);
+  bool regen = false;
+
+  for (int b=0; b<nblk; b++) {
+
+    auto & C = eofChanges[b];
+
+    if (use_mpi) {
+      double buf[8] = {double(C.M), double(C.cosine), double(C.warm),
+	double(C.regenerated), double(C.iterations),
+	C.angle, C.overlap, C.eigen};
+
+      MPI_Bcast(buf, 8, MPI_DOUBLE, b % nproc, MPI_COMM_WORLD);
+
+      C = {int(buf[0]), buf[1]>0.0, buf[2]>0.0, buf[3]>0.0, int(buf[4]),
+	buf[5], buf[6], buf[7]};
+    }
+
+    if (C.regenerated) {
+      owner[b] = b % nproc;
+      regen = true;
+    }
+  }
+
+  if (use_mpi) gather_eof_grid(owner);
+
+  return regen;
+}
+
 void EmpCylSL::accumulate_eof(std::vector<Particle>& part, bool verbose)
 {
     
@@ -4055,46 +3986,11 @@ void EmpCylSL::make_coefficients(unsigned M0, bool compute)
 	  sinN(M)[0][mm][nn] += sinN(M)[nth][mm][nn];
 	}
     }
-				// Begin distribution loop
-				//
-    for (int mm=0; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	MPIin[mm*rank3 + nn] = cosN(M)[0][mm][nn];
-    
-    if (use_mpi)
-      MPI_Allreduce ( MPIin.data(), MPIout.data(), rank3*(MMAX+1),
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    else
-      MPIout = MPIin;
-
-    for (int mm=0; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	if (multistep)
-	  cosN(M)[0][mm][nn] = MPIout[mm*rank3 + nn];
-	else
-	  accum_cos[mm][nn] = MPIout[mm*rank3 + nn];
-    
-
-    for (int mm=1; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	MPIin[mm*rank3 + nn] = sinN(M)[0][mm][nn];
-    
-    if (use_mpi)
-      MPI_Allreduce ( MPIin.data(), MPIout.data(), rank3*(MMAX+1),
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    else
-      MPIout = MPIin;
-  
-  
-  for (int mm=1; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	if (multistep)
-	  sinN(M)[0][mm][nn] = MPIout[mm*rank3 + nn];
-	else
-	  accum_sin[mm][nn] = MPIout[mm*rank3 + nn];
-    
-    coefs_made[M] = true;
   }
+				// Sum over processes
+  reduce_coefficients(M0);
+
+  for (unsigned M=M0; M<=multistep; M++) coefs_made[M] = true;
   
 
   if (compute) {
@@ -4202,6 +4098,67 @@ void EmpCylSL::make_coefficients(unsigned M0, bool compute)
   }
 }
 
+void EmpCylSL::reduce_coefficients(unsigned M0)
+{
+  // Block for each level: the count followed by the cosine and sine
+  // coefficients
+  //
+  const int ncos = rank3*(MMAX+1), nsin = rank3*MMAX;
+  const int nblk = 1 + ncos + nsin;
+
+  howmany.resize(multistep+1, 0);
+
+  std::vector<unsigned> levs;
+  for (unsigned M=M0; M<=multistep; M++) {
+    if (not coefs_made[M]) levs.push_back(M);
+  }
+
+  if (levs.size()==0) return;
+
+  MPIcoef.resize(nblk*levs.size());
+
+  for (size_t k=0; k<levs.size(); k++) {
+    unsigned M = levs[k];
+    double* b = &MPIcoef[k*nblk];
+
+    b[0] = howmany1[M][0];
+
+    for (int mm=0; mm<=MMAX; mm++)
+      for (int nn=0; nn<rank3; nn++)
+	b[1 + mm*rank3 + nn] = cosN(M)[0][mm][nn];
+
+    for (int mm=1; mm<=MMAX; mm++)
+      for (int nn=0; nn<rank3; nn++)
+	b[1 + ncos + (mm-1)*rank3 + nn] = sinN(M)[0][mm][nn];
+  }
+
+  if (use_mpi)
+    MPI_Allreduce ( MPI_IN_PLACE, MPIcoef.data(), MPIcoef.size(),
+		    MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  for (size_t k=0; k<levs.size(); k++) {
+    unsigned M = levs[k];
+    const double* b = &MPIcoef[k*nblk];
+
+				// "howmany" is only used for debugging
+    howmany[M] = static_cast<unsigned>(std::lround(b[0]));
+
+    for (int mm=0; mm<=MMAX; mm++)
+      for (int nn=0; nn<rank3; nn++)
+	if (multistep)
+	  cosN(M)[0][mm][nn] = b[1 + mm*rank3 + nn];
+	else
+	  accum_cos[mm][nn] = b[1 + mm*rank3 + nn];
+
+    for (int mm=1; mm<=MMAX; mm++)
+      for (int nn=0; nn<rank3; nn++)
+	if (multistep)
+	  sinN(M)[0][mm][nn] = b[1 + ncos + (mm-1)*rank3 + nn];
+	else
+	  accum_sin[mm][nn] = b[1 + ncos + (mm-1)*rank3 + nn];
+  }
+}
+
 void EmpCylSL::reset_mass(void)
 { 
   cylmass=0.0; 
@@ -4280,35 +4237,9 @@ void EmpCylSL::make_coefficients(bool compute)
     for (int nth=0; nth<nthrds; nth++) howmany1[M].resize(nthrds, 0);
   }
 
-  for (unsigned M=0; M<=multistep; M++) {
-
-    if (coefs_made[M]) continue;
-
-				// "howmany" is only used for debugging
-    if (use_mpi)
-      MPI_Allreduce ( &howmany1[M][0], &howmany[M], 1, MPI_UNSIGNED,
-		      MPI_SUM, MPI_COMM_WORLD);
-    else
-      howmany[M] = howmany1[M][0];
-
-    for (int mm=0; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	MPIin[mm*rank3 + nn] = cosN(M)[0][mm][nn];
-  
-    if (use_mpi)
-      MPI_Allreduce ( MPIin.data(), MPIout.data(), rank3*(MMAX+1),
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    else
-      MPIout = MPIin;
-
-    for (int mm=0; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	if (multistep)
-	  cosN(M)[0][mm][nn] = MPIout[mm*rank3 + nn];
-	else
-	  accum_cos[mm][nn] = MPIout[mm*rank3 + nn];
-  }
-  
+				// Counts, cosine and sine
+				// coefficients for all levels
+  reduce_coefficients(0);
 
   if (compute and PCAVAR) {
 
@@ -4347,28 +4278,6 @@ void EmpCylSL::make_coefficients(bool compute)
   } // SELECT
 
 
-  for (unsigned M=0; M<=multistep; M++) {
-    
-    if (coefs_made[M]) continue;
-
-    for (int mm=1; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	MPIin[mm*rank3 + nn] = sinN(M)[0][mm][nn];
-  
-    if (use_mpi)
-      MPI_Allreduce ( MPIin.data(), MPIout.data(), rank3*(MMAX+1),
-		      MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    else
-      MPIout = MPIin;
-
-    for (int mm=1; mm<=MMAX; mm++)
-      for (int nn=0; nn<rank3; nn++)
-	if (multistep)
-	  sinN(M)[0][mm][nn] = MPIout[mm*rank3 + nn];
-	else
-	  accum_sin[mm][nn] = MPIout[mm*rank3 + nn];
-  }
-  
   if (compute and PCAVAR) {
 				// Mass used to compute variance in
 				// each partition
@@ -5048,6 +4957,20 @@ void EmpCylSL::accumulated_eval(double r, double z, double phi,
     return;
   }
 
+  // Node-interleaved tables
+  //
+  if (packOn and not packStale) {
+    thread_local std::vector<double> work;
+    work.resize(3*(packNC + packNS));
+
+    int ix, iy;
+    double c[4];
+    packed_cell(r, z, ix, iy, c);
+    packed_interp(ix, iy, c, 0, work.size(), work.data());
+    packed_sum(work.data(), phi, p0, p, fr, fz, fp);
+    return;
+  }
+
   double X = (r_to_xi(r) - XMIN)/dX;
   double Y = (z_to_y(z)  - YMIN)/dY;
 
@@ -5196,6 +5119,43 @@ double EmpCylSL::accumulated_dens_eval(double r, double z, double phi,
 
   if (rr/ASCALE > Rtable) return ans;
 
+  // Node-interleaved tables: the density fields are the last two
+  // blocks of each node
+  //
+  if (packOn and not packStale) {
+    thread_local std::vector<double> work;
+    work.resize(packNC + packNS);
+
+    int ix, iy;
+    double c[4];
+    packed_cell(r, z, ix, iy, c);
+    packed_interp(ix, iy, c, 3*(packNC + packNS), work.size(), work.data());
+
+    const double *dC = work.data(), *dS = dC + packNC;
+
+    for (int mm=std::max<int>(0, MMIN); mm<=std::min<int>(MLIM, MMAX); mm++) {
+
+      double ccos = cos(phi*mm);
+      double ssin = sin(phi*mm);
+
+      for (int n=std::max<int>(0, NMIN); n<std::min<int>(NLIM, rank3); n++) {
+
+	double fac = accum_cos[mm][n]*ccos;
+
+	ans += fac * dC[mm*packNord + n];
+
+	if (mm) {
+	  fac = accum_sin[mm][n]*ssin;
+	  ans += fac * dS[(mm-1)*packNord + n];
+	}
+      }
+
+      if (mm==0) d0 = ans;
+    }
+
+    return ans;
+  }
+
   double X = (r_to_xi(r) - XMIN)/dX;
   double Y = (z_to_y(z)  - YMIN)/dY;
 
@@ -5273,6 +5233,281 @@ double EmpCylSL::accumulated_dens_eval(double r, double z, double phi,
 
 
   
+void EmpCylSL::pack_tables()
+{
+  if (not packOn or not packStale) return;
+
+  // No tables yet
+  //
+  if (potC.size()==0 or potC[0].size()==0) return;
+
+  packNord   = potC[0].size();
+  packNC     = (MMAX+1)*packNord;
+  packNS     = MMAX*packNord;
+  packStride = 4*(packNC + packNS);
+
+  packTbl.resize(static_cast<size_t>(NUMX+1)*(NUMY+1)*packStride);
+
+  for (int ix=0; ix<=NUMX; ix++) {
+    for (int iy=0; iy<=NUMY; iy++) {
+
+      double *t = &packTbl[(static_cast<size_t>(ix)*(NUMY+1) + iy)*packStride];
+
+      double *tpC = t,             *trC = tpC + packNC, *tzC = trC + packNC;
+      double *tpS = tzC + packNC,  *trS = tpS + packNS, *tzS = trS + packNS;
+      double *tdC = tzS + packNS,  *tdS = tdC + packNC;
+
+      for (int m=0; m<=MMAX; m++) {
+	for (int n=0; n<packNord; n++) {
+	  int j = m*packNord + n;
+	  tpC[j] = potC   [m][n](ix, iy);
+	  trC[j] = rforceC[m][n](ix, iy);
+	  tzC[j] = zforceC[m][n](ix, iy);
+	  tdC[j] = densC  [m][n](ix, iy);
+	}
+      }
+
+      for (int m=1; m<=MMAX; m++) {
+	for (int n=0; n<packNord; n++) {
+	  int j = (m-1)*packNord + n;
+	  tpS[j] = potS   [m][n](ix, iy);
+	  trS[j] = rforceS[m][n](ix, iy);
+	  tzS[j] = zforceS[m][n](ix, iy);
+	  tdS[j] = densS  [m][n](ix, iy);
+	}
+      }
+    }
+  }
+
+  packStale = false;
+
+  if (myid==0 and VFLAG & 1)
+    std::cout << "---- EmpCylSL::pack_tables: "
+	      << packTbl.size()*sizeof(double)/(1024.0*1024.0)
+	      << " MB in node-interleaved tables" << std::endl;
+}
+
+void EmpCylSL::packed_cell(double r, double z, int& ix, int& iy, double c[4])
+{
+  double X = (r_to_xi(r) - XMIN)/dX;
+  double Y = (z_to_y(z)  - YMIN)/dY;
+
+  ix = (int)X;
+  iy = (int)Y;
+  
+  if (ix < 0) {
+    ix = 0;
+    if (enforce_limits) X = 0.0;
+  }
+  if (iy < 0) {
+    iy = 0;
+    if (enforce_limits) Y = 0.0;
+  }
+  
+  if (ix >= NUMX) {
+    ix = NUMX-1;
+    if (enforce_limits) X = NUMX;
+  }
+  if (iy >= NUMY) {
+    iy = NUMY-1;
+    if (enforce_limits) Y = NUMY;
+  }
+
+  double delx0 = (double)ix + 1.0 - X;
+  double dely0 = (double)iy + 1.0 - Y;
+  double delx1 = X - (double)ix;
+  double dely1 = Y - (double)iy;
+  
+  c[0] = delx0*dely0;		// c00
+  c[1] = delx1*dely0;		// c10
+  c[2] = delx0*dely1;		// c01
+  c[3] = delx1*dely1;		// c11
+}
+
+void EmpCylSL::packed_interp(int ix, int iy, const double c[4],
+			     int beg, int len, double* out)
+{
+  const size_t ny = NUMY + 1;
+
+  const double *t00 = &packTbl[((ix  )*ny + iy  )*packStride + beg];
+  const double *t10 = &packTbl[((ix+1)*ny + iy  )*packStride + beg];
+  const double *t01 = &packTbl[((ix  )*ny + iy+1)*packStride + beg];
+  const double *t11 = &packTbl[((ix+1)*ny + iy+1)*packStride + beg];
+
+  const double c00 = c[0], c10 = c[1], c01 = c[2], c11 = c[3];
+
+  // Same association order as the unpacked expressions so that the
+  // results are identical
+  //
+#pragma omp simd
+  for (int k=0; k<len; k++)
+    out[k] = t00[k] * c00 + t10[k] * c10 + t01[k] * c01 + t11[k] * c11;
+}
+
+void EmpCylSL::packed_sum(const double* w, double phi, double& p0,
+			  double& p, double& fr, double& fz, double& fp)
+{
+  const double *pC = w,           *rC = pC + packNC, *zC = rC + packNC;
+  const double *pS = zC + packNC, *rS = pS + packNS, *zS = rS + packNS;
+
+  double ccos, ssin=0.0, fac;
+  
+  for (int mm=std::max<int>(0, MMIN); mm<=std::min<int>(MLIM, MMAX); mm++) {
+    
+    // Suppress odd M terms?
+    if (EVEN_M && (mm/2)*2 != mm) continue;
+
+    ccos = cos(phi*mm);
+    ssin = sin(phi*mm);
+
+    for (int n=std::max<int>(0, NMIN); n<std::min<int>(NLIM, rank3); n++) {
+      
+      int jc = mm*packNord + n;
+
+      fac = accum_cos[mm][n] * ccos;
+      
+      p  += fac * pC[jc];
+      fr += fac * rC[jc];
+      fz += fac * zC[jc];
+      
+      fac = accum_cos[mm][n] * ssin;
+      
+      fp += fac * mm * pC[jc];
+      
+      if (mm) {
+	
+	int js = (mm-1)*packNord + n;
+
+	fac = accum_sin[mm][n] * ssin;
+	
+	p  += fac * pS[js];
+	fr += fac * rS[js];
+	fz += fac * zS[js];
+	
+	fac = -accum_sin[mm][n] * ccos;
+	
+	fp += fac * mm * pS[js];
+      }
+    }
+    
+    if (mm==0) p0 = p;
+  }
+}
+
+void EmpCylSL::accumulated_eval_batch(int N, const double* r, const double* z,
+				      const double* phi, double* p0, double* p,
+				      double* fr, double* fz, double* fp)
+{
+  if (not usePacked()) {
+    for (int i=0; i<N; i++)
+      accumulated_eval(r[i], z[i], phi[i], p0[i], p[i], fr[i], fz[i], fp[i]);
+    return;
+  }
+
+  if (!coefs_made_all()) {
+    if (VFLAG>3)
+      std::cerr << "Process " << myid << ": in EmpCylSL::accumlated_eval_batch, "
+		<< "calling make_coefficients()" << std::endl;
+    make_coefficients();
+  }
+
+  // One scratch block per thread, reused for every point in the batch
+  //
+  thread_local std::vector<double> work;
+  work.resize(3*(packNC + packNS));
+
+  for (int i=0; i<N; i++) {
+
+    fr[i] = fz[i] = fp[i] = p[i] = 0.0;
+
+    double rr = sqrt(r[i]*r[i] + z[i]*z[i]);
+    if (rr/ASCALE>Rtable) continue;
+
+    int ix, iy;
+    double c[4];
+    packed_cell(r[i], z[i], ix, iy, c);
+    packed_interp(ix, iy, c, 0, work.size(), work.data());
+    packed_sum(work.data(), phi[i], p0[i], p[i], fr[i], fz[i], fp[i]);
+  }
+}
+
+unsigned EmpCylSL::validate_packed(int ntest, bool verbose)
+{
+  bool save = packOn;
+
+  packOn = true;
+  pack_tables();
+
+  if (packStale) {
+    packOn = save;
+    if (myid==0 and verbose)
+      std::cout << "---- EmpCylSL::validate_packed: no tables to check"
+		<< std::endl;
+    return 0;
+  }
+
+  // Same points on every process
+  //
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<> unit(0.0, 1.0);
+
+  double rmax = Rtable*ASCALE;
+  unsigned bad = 0;
+  double maxdiff = 0.0;
+
+  auto differ = [&](double a, double b)
+  {
+    maxdiff = std::max<double>(maxdiff, fabs(a - b));
+    return std::memcmp(&a, &b, sizeof(double)) != 0;
+  };
+
+  // The batched path is checked against the same points
+  //
+  std::vector<double> R(ntest), z(ntest), phi(ntest);
+  std::vector<double> b0(ntest), b1(ntest), b2(ntest), b3(ntest), b4(ntest);
+
+  for (int i=0; i<ntest; i++) {
+    R  [i] = rmax*unit(gen);
+    z  [i] = rmax*(2.0*unit(gen) - 1.0);
+    phi[i] = 2.0*M_PI*unit(gen);
+  }
+
+  packOn = true;
+  accumulated_eval_batch(ntest, R.data(), z.data(), phi.data(),
+			 b0.data(), b1.data(), b2.data(), b3.data(), b4.data());
+
+  for (int i=0; i<ntest; i++) {
+    double v0[5] = {0}, v1[5] = {0}, d0[2] = {0}, d1[2] = {0};
+
+    packOn = false;
+    accumulated_eval(R[i], z[i], phi[i], v0[0], v0[1], v0[2], v0[3], v0[4]);
+    d0[1] = accumulated_dens_eval(R[i], z[i], phi[i], d0[0]);
+
+    packOn = true;
+    accumulated_eval(R[i], z[i], phi[i], v1[0], v1[1], v1[2], v1[3], v1[4]);
+    d1[1] = accumulated_dens_eval(R[i], z[i], phi[i], d1[0]);
+
+    double vb[5] = {b0[i], b1[i], b2[i], b3[i], b4[i]};
+
+    bool miss = false;
+    for (int k=0; k<5; k++) miss = differ(v0[k], v1[k]) or miss;
+    for (int k=0; k<5; k++) miss = differ(v0[k], vb[k]) or miss;
+    for (int k=0; k<2; k++) miss = differ(d0[k], d1[k]) or miss;
+    if (miss) bad++;
+  }
+
+  packOn = save;
+
+  if (myid==0 and verbose) {
+    std::cout << "---- EmpCylSL::validate_packed: " << ntest << " points, "
+	      << bad << " not bit-for-bit identical (scalar and batched)";
+    if (bad) std::cout << ", max |diff|=" << maxdiff;
+    std::cout << std::endl;
+  }
+
+  return bad;
+}
+
 double EmpCylSL::accumulated_midplane_eval(double r, double zmin, double zmax,
 					   double phi, int num)
 {
@@ -5333,6 +5568,35 @@ void EmpCylSL::get_pot(Eigen::MatrixXd& Vc, Eigen::MatrixXd& Vs,
   if (z/ASCALE > Rtable) z =  Rtable*ASCALE;
   if (z/ASCALE <-Rtable) z = -Rtable*ASCALE;
 
+  // Node-interleaved tables: interpolate the potential cosine and
+  // sine blocks in two vector passes
+  //
+  if (packOn and not packStale) {
+    thread_local std::vector<double> work;
+    work.resize(packNC + packNS);
+
+    int ix, iy;
+    double c[4];
+    packed_cell(r, z, ix, iy, c);
+    packed_interp(ix, iy, c, 0,        packNC, work.data());
+    packed_interp(ix, iy, c, 3*packNC, packNS, work.data() + packNC);
+
+    const double *pC = work.data(), *pS = pC + packNC;
+
+    for (int mm=0; mm<=std::min<int>(MLIM, MMAX); mm++) {
+    
+      // Suppress odd M terms?
+      if (EVEN_M && (mm/2)*2 != mm) continue;
+
+      for (int n=0; n<rank3; n++) {
+	Vc(mm, n) = pC[mm*packNord + n];
+	if (mm) Vs(mm, n) = pS[(mm-1)*packNord + n];
+      }
+    }
+
+    return;
+  }
+
   double X = (r_to_xi(r) - XMIN)/dX;
   double Y = (z_to_y(z)  - YMIN)/dY;
 
@@ -7198,10 +7462,10 @@ void EmpCylSL::WriteH5Cache()
 	sout << n;
 	auto order = harmonic.createGroup(sout.str());
       
-	order.createDataSet("potC",    potC   [m][n]);
-	order.createDataSet("rforceC", rforceC[m][n]);
-	order.createDataSet("zforceC", zforceC[m][n]);
-	order.createDataSet("densC",   densC  [m][n]);
+	order.createDataSet("potC",    Eigen::MatrixXd(potC   [m][n]));
+	order.createDataSet("rforceC", Eigen::MatrixXd(rforceC[m][n]));
+	order.createDataSet("zforceC", Eigen::MatrixXd(zforceC[m][n]));
+	order.createDataSet("densC",   Eigen::MatrixXd(densC  [m][n]));
       }
     }
 
@@ -7222,10 +7486,10 @@ void EmpCylSL::WriteH5Cache()
 	sout << n;
 	auto order = harmonic.createGroup(sout.str());
       
-	order.createDataSet("potS",    potS   [m][n]);
-	order.createDataSet("rforceS", rforceS[m][n]);
-	order.createDataSet("zforceS", zforceS[m][n]);
-	order.createDataSet("densS",   densS  [m][n]);
+	order.createDataSet("potS",    Eigen::MatrixXd(potS   [m][n]));
+	order.createDataSet("rforceS", Eigen::MatrixXd(rforceS[m][n]));
+	order.createDataSet("zforceS", Eigen::MatrixXd(zforceS[m][n]));
+	order.createDataSet("densS",   Eigen::MatrixXd(densS  [m][n]));
       }
     }
 
@@ -7239,6 +7503,8 @@ void EmpCylSL::WriteH5Cache()
 
 bool EmpCylSL::ReadH5Cache()
 {
+  packStale = true;		// The EOF tables will change
+
   try {
     // Silence the HDF5 error stack
     //
@@ -7317,32 +7583,10 @@ bool EmpCylSL::ReadH5Cache()
       EvenOdd  = true;
     }
 
-    // Allocate arrays for storing grids
+    // The grids are allocated by setup_table() with the dimensions
+    // checked above
     //
-    potC    .resize(MMAX+1);
-    rforceC .resize(MMAX+1);
-    zforceC .resize(MMAX+1);
-  
-    potS    .resize(MMAX+1);
-    rforceS .resize(MMAX+1);
-    zforceS .resize(MMAX+1);
-  
-    densC   .resize(MMAX+1);
-    densS   .resize(MMAX+1);
-
-    for (int m=0; m<=MMAX; m++) {
-      potC[m]   .resize(NORDER);
-      rforceC[m].resize(NORDER);
-      zforceC[m].resize(NORDER);
-      densC[m]  .resize(NORDER);
-    }
-
-    for (int m=1; m<=MMAX; m++) {
-      potS[m]   .resize(NORDER);
-      rforceS[m].resize(NORDER);
-      zforceS[m].resize(NORDER);
-      densS[m]  .resize(NORDER);
-    }    
+    if (potC.size() != MMAX+1 or potC[0].size() != NORDER) return false;
 
     // Read arrays and data from H5 file
     //
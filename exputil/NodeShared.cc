@@ -0,0 +1,124 @@
+#include <iostream>
+
+#include <NodeShared.H>
+
+bool             NodeShared::setup_done  = false;
+MPI_Comm         NodeShared::node_comm   = MPI_COMM_NULL;
+MPI_Comm         NodeShared::leader_comm = MPI_COMM_NULL;
+int              NodeShared::node_rank   = 0;
+int              NodeShared::node_size   = 1;
+int              NodeShared::num_nodes   = 1;
+std::vector<int> NodeShared::node_of     = {0};
+
+namespace {
+
+  bool mpi_running()
+  {
+    int init = 0, done = 0;
+    MPI_Initialized(&init);
+    if (init) MPI_Finalized(&done);
+    return init and not done;
+  }
+
+}
+
+void NodeShared::setup()
+{
+  if (setup_done) return;
+  if (not mpi_running()) return;
+
+  setup_done = true;
+
+  int myid, numprocs;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+  MPI_Comm_size(MPI_COMM_WORLD, &numprocs);
+
+  // Processes that can share memory, ordered by world rank so that
+  // the leader is the lowest world rank on the node
+  //
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, myid,
+		      MPI_INFO_NULL, &node_comm);
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_size(node_comm, &node_size);
+
+  MPI_Comm_split(MPI_COMM_WORLD, node_rank==0 ? 0 : MPI_UNDEFINED, myid,
+		 &leader_comm);
+
+  // Node index for every process
+  //
+  int node = 0;
+  if (leader_comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(leader_comm, &node);
+    MPI_Comm_size(leader_comm, &num_nodes);
+  }
+  MPI_Bcast(&node,      1, MPI_INT, 0, node_comm);
+  MPI_Bcast(&num_nodes, 1, MPI_INT, 0, node_comm);
+
+  node_of.resize(numprocs);
+  MPI_Allgather(&node, 1, MPI_INT, node_of.data(), 1, MPI_INT, MPI_COMM_WORLD);
+}
+
+NodeShared::NodeShared(std::size_t n, bool share) : count(n)
+{
+  if (share and mpi_running()) {
+
+    setup();
+
+    // The leader allocates the whole block
+    //
+    MPI_Aint bytes = node_rank==0 ? n*sizeof(double) : 0;
+    MPI_Win_allocate_shared(bytes, sizeof(double), MPI_INFO_NULL,
+			    node_comm, &base, &win);
+
+    if (node_rank) {
+      MPI_Aint size;
+      int unit;
+      MPI_Win_shared_query(win, 0, &size, &unit, &base);
+    }
+
+    // Passive target epoch for MPI_Win_sync
+    //
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+  }
+  else {
+    local.resize(n);
+    base = local.data();
+  }
+}
+
+NodeShared::~NodeShared()
+{
+  if (win != MPI_WIN_NULL and mpi_running()) {
+    MPI_Win_unlock_all(win);
+    MPI_Win_free(&win);
+  }
+}
+
+void NodeShared::sync()
+{
+  if (win == MPI_WIN_NULL) return;
+
+  MPI_Win_sync(win);
+  MPI_Barrier(node_comm);
+  MPI_Win_sync(win);
+}
+
+void NodeShared::report(const std::string& label) const
+{
+  if (win == MPI_WIN_NULL) return;
+
+  int myid, numprocs;
+  MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+  MPI_Comm_size(MPI_COMM_WORLD, &numprocs);
+
+  // Every process but the leader on each node would otherwise hold
+  // its own copy
+  //
+  if (myid==0) {
+    double MB = count*sizeof(double)/(1024.0*1024.0);
+    std::cout << "---- " << label << ": " << MB << " MB per node on "
+	      << num_nodes << " node(s) shared by " << numprocs
+	      << " processes, saving " << MB*(numprocs - num_nodes)
+	      << " MB in total" << std::endl;
+  }
+}
@@ -465,6 +465,52 @@ int Particle::writeBinaryMPI(char *buf, unsigned rsize, bool indexing)
   return p;
 }
 
+int Particle::readBinaryMPI(const char *buf, unsigned rsize, bool indexing,
+			    unsigned long seq)
+{
+  // Pointer offset
+  int p = 0;
+
+  // Working variable
+  float tf;
+
+  // Read a floating value of size rsize
+  auto getValue = [&](double& v)
+  {
+    if (rsize == sizeof(float)) {
+      memcpy (&tf, buf+p, rsize);
+      v = tf;
+    }
+    else {
+      memcpy (&v, buf+p, rsize);
+    }
+    p += rsize;
+  };
+
+  if (indexing) { 		// Index is cached in the file
+    memcpy (&indx, buf+p, sizeof(unsigned long));
+    p += sizeof(unsigned long);
+  } else
+    indx = seq;
+
+  getValue(mass);
+  for (int i=0; i<3; i++) getValue(pos[i]);
+  for (int i=0; i<3; i++) getValue(vel[i]);
+  getValue(pot);
+  potext = 0.0;
+
+  level = multistep;
+
+  if (iattrib.size()) {
+    memcpy (&iattrib[0], buf+p, sizeof(int)*iattrib.size());
+    p += sizeof(int)*iattrib.size();
+  }
+
+  for (auto & jt : dattrib) getValue(jt);
+
+  return p;
+}
+
 
 void Particle::readAscii(bool indexing, int seq, std::istream* fin)
 {
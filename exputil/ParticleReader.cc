@@ -5,9 +5,15 @@
 #include <sstream>
 #include <memory>
 #include <numeric>
+#include <limits>
 #include <string>
 #include <vector>
 
+#include <sys/mman.h>		// For mmap
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 
 #include <yaml-cpp/yaml.h>	// YAML support
 
@@ -79,19 +85,56 @@ namespace PR {
       
       time = header.time;
 
+      std::array<int, 6> cnt;
       for (int n=0; n<6; n++) {
-	nptot[n] += npart[n];
+	cnt[n] = header.npart[n];
+	nptot[n] += header.npart[n];
 	if (header.npart[n] > 0) pfound.insert(Ptypes[n]);
       }
+      fnpart.push_back(cnt);
     }
     
     Pfound.clear();
     for (auto p : pfound) Pfound.push_back(p);
   }
    
+  // The particles of each type are split evenly across processes in
+  // file order.  Return this process' share [beg, end) of the given
+  // file; processes never open files outside of their share.
+  //
+  static std::pair<unsigned long, unsigned long>
+  gadgetShare(const std::vector<std::array<int, 6>>& fnpart, size_t ifile,
+	      int ptype, int myid, int numprocs)
+  {
+    unsigned long total = 0, offset = 0;
+    for (size_t f=0; f<fnpart.size(); f++) {
+      if (f==ifile) offset = total;
+      total += fnpart[f][ptype];
+    }
+
+    unsigned long gbeg = total*myid/numprocs;
+    unsigned long gend = total*(myid+1)/numprocs;
+    unsigned long flen = ifile < fnpart.size() ? fnpart[ifile][ptype] : 0;
+
+    unsigned long beg = std::max(gbeg, offset);
+    unsigned long end = std::min(gend, offset + flen);
+
+    if (end <= beg) return {0, 0};
+    return {beg - offset, end - offset};
+  }
+
+  bool GadgetNative::localRange()
+  {
+    std::tie(fbeg, fend) = gadgetShare(fnpart, curfile - _files.begin(),
+				       ptype, myid, numprocs);
+    return fend > fbeg;
+  }
 
   bool GadgetNative::nextFile()
   {
+    // Skip files that hold none of this process' particles
+    while (curfile!=_files.end() and not localRange()) curfile++;
+
     if (curfile==_files.end()) return false;
     read_and_load();
     curfile++;
@@ -130,148 +173,92 @@ namespace PR {
     
     time = header.time;
 
-    // Total number of particles in this stanza.  Note: this needs to be
-    // generalized for reading multiple Gadget native files per snap
+    // Total number of particles of this type in all files
     //
-    totalCount = header.npart[ptype];
-    
-    particles.clear();		// Should be empty, but enforce that
+    totalCount = nptot[ptype];
     
-    Particle P;			// Temporary for packing array
-    
-    // Read positions
+    // This process' share of the current file
     //
-    file.read((char*)&blk1, sizeof(int)); // block count
-    
-    float temp[3];		// Pos/vel temporary
-    
-    for (int k=0; k<6; k++) {
-      if ( k == ptype ) {
-	for (int n=0; n<header.npart[k]; n++) {
-	  file.read((char*)temp, 3*sizeof(float));
-	  if (n % numprocs == myid) {
-	    P.pos[0] = temp[0];
-	    P.pos[1] = temp[1];
-	    P.pos[2] = temp[2];
-	    P.level  = 0;		// Assign level 0 to all particles
-	    particles.push_back(P);
-	  }
-	}
-      }
-      else {
-	file.seekg(header.npart[k]*3*sizeof(float), std::ios::cur);
-      }
-    }
-    
-    file.read((char*)&blk2, sizeof(int)); // block count
-    if (blk1 != blk2) {
-      std::cout << "GadgetNative position block read: "
-		<< "blk1=" << blk1 << " != blk2=" << blk2
-		<< std::endl;
-    }
+    size_t n = fend - fbeg;
 
-    file.read((char*)&blk1, sizeof(int)); // block count
-    
-    // Read velocities
-    //
-    for (int k=0; k<6; k++) {
-      if ( k == ptype ) {
-	int pc = 0;
-	for (int n=0; n<header.npart[k]; n++) {
-	  file.read((char*)temp, 3*sizeof(float));
-	  if (n % numprocs == myid) {
-	    particles[pc].vel[0] = temp[0];
-	    particles[pc].vel[1] = temp[1];
-	    particles[pc].vel[2] = temp[2];
-	    pc++;
-	  }
-	}
-      }
-      else {
-	file.seekg(header.npart[k]*3*sizeof(float), std::ios::cur);
-      }
-      
-    }
-    
-    file.read((char*)&blk2, sizeof(int)); // block count
-    if (blk1 != blk2) {
-      std::cout << "GadgetNative velocity block read: "
-		<< "blk1=" << blk1 << " != blk2=" << blk2
-		<< std::endl;
-    }
+    particles.resize(n);
+    pcount = 0;
 
-    file.read((char*)&blk1, sizeof(int));
-    
-    // Read particle ID
+    // Each block is framed by its byte count.  Read this process'
+    // rows of type ptype from the block starting at the current
+    // position and leave the stream at the next block.  Only the
+    // types flagged in <present> have rows in the block; nothing is
+    // read if ptype is not among them.
     //
-    for (int k=0; k<6; k++) {
-      if ( k == ptype ) {
-	int pc = 0;
-	for (int n=0; n<header.npart[k]; n++) {
-	  int temp;
-	  file.read((char*)&temp, sizeof(int));
-	  if (n % numprocs == myid) {
-	    particles[pc].indx = temp;
-	    pc++;
-	  }
-	}
-      }
-      else {
-	file.seekg(header.npart[k]*sizeof(int), std::ios::cur);
-      }
-    }
-    
-    file.read((char*)&blk2, sizeof(int)); // block count
-    if (blk1 != blk2) {
-      std::cout << "GadgetNative id block read: "
-		<< "blk1=" << blk1 << " != blk2=" << blk2
-		<< std::endl;
-    }
-
-    // Do we need to read mass stanza?
-    bool with_mass = false;
-    for (int k=0; k<6; k++) {
-      if (header.npart[k]>0 and header.mass[k] ==0) with_mass = true;
-    }
-
-    if (with_mass) {
-      // file.seekg(sizeof(int), std::ios::cur); // block count
+    auto block = [&](const std::string& name, size_t width,
+		     const std::array<bool, 6>& present, std::vector<char>& buf)
+    {
       file.read((char*)&blk1, sizeof(int));
-    }
-    
-    for (int k=0; k<6; k++) {
-      if ( k == ptype) {
-	int pc = 0;
-	for (int n=0; n<header.npart[k]; n++) {
-	  if (n % numprocs == myid) {
-	    if (header.mass[k]==0) {
-	      file.read((char*)temp, sizeof(float));
-	      particles[pc].mass = temp[0];
-	    }
-	    else
-	      particles[pc].mass = header.mass[k];
-	    pc++;
-	  }
-	}
+      std::streampos start = file.tellg();
+
+      size_t before = 0, total = 0;
+      for (int k=0; k<6; k++) {
+	if (not present[k]) continue;
+	if (k < ptype) before += header.npart[k];
+	total += header.npart[k];
       }
-      else {
-	if (header.mass[k]==0)
-	  file.seekg(header.npart[k]*sizeof(float), std::ios::cur);
+
+      size_t nread = present[ptype] ? n : 0;
+      buf.resize(nread*width);
+      if (nread) {
+	file.seekg(start + std::streamoff((before + fbeg)*width));
+	file.read(buf.data(), nread*width);
       }
-    }
-    
-    if (with_mass) {
-      file.read((char*)&blk2, sizeof(int)); // block count
+      file.seekg(start + std::streamoff(total*width));
+
+      file.read((char*)&blk2, sizeof(int));
       if (blk1 != blk2) {
-	std::cout << "GadgetNative id block read: "
+	std::cout << "GadgetNative " << name << " block read: "
 		  << "blk1=" << blk1 << " != blk2=" << blk2
 		  << std::endl;
       }
+    };
+
+    std::array<bool, 6> all, massive;
+    bool with_mass = false;
+    for (int k=0; k<6; k++) {
+      all[k]     = true;
+      massive[k] = header.mass[k]==0;
+      if (header.npart[k]>0 and header.mass[k]==0) with_mass = true;
     }
-    
+
+    std::vector<char> pbuf, vbuf, ibuf, mbuf;
+
+    block("position", 3*sizeof(float), all, pbuf);
+    block("velocity", 3*sizeof(float), all, vbuf);
+    block("id",       sizeof(int),     all, ibuf);
+    if (with_mass) block("mass", sizeof(float), massive, mbuf);
+
     // Add other fields, as necessary. Acceleration?
     
     file.close();
+
+    // Unpack
+    //
+    const float* pos = reinterpret_cast<const float*>(pbuf.data());
+    const float* vel = reinterpret_cast<const float*>(vbuf.data());
+    const int*   ids = reinterpret_cast<const int*  >(ibuf.data());
+    const float* mss = reinterpret_cast<const float*>(mbuf.data());
+    bool   pmass = header.mass[ptype]==0;
+    double cmass = header.mass[ptype];
+
+#pragma omp parallel for schedule(static)
+    for (size_t i=0; i<n; i++) {
+      Particle & P = particles[i];
+      for (int k=0; k<3; k++) {
+	P.pos[k] = pos[3*i+k];
+	P.vel[k] = vel[3*i+k];
+      }
+      P.indx  = ids[i];
+      P.mass  = pmass ? mss[i] : cmass;
+      P.level = 0;		// Assign level 0 to all particles
+    }
+
     if (myid==0 and _verbose) std::cout << "done." << std::endl;
   }
   
@@ -279,6 +266,11 @@ namespace PR {
   {
     pcount = 0;
     
+    if (particles.size()==0) {
+      if (nextFile()) return firstParticle();
+      else return 0;
+    }
+
     return &particles[pcount++];
   }
   
@@ -321,7 +313,9 @@ namespace PR {
   {
     std::set<std::string> pfound;
     std::fill(nptot, nptot+6, 0);
+    fnpart.clear();
 
+    size_t nfile = 0;
     for (auto file : _files) {
 
       // Try to catch and HDF5 and parsing errors
@@ -366,6 +360,8 @@ namespace PR {
 	  if (npart[n] > 0) pfound.insert(Ptypes[n]);
 	}
 	
+	fnpart.push_back({npart[0], npart[1], npart[2],
+			  npart[3], npart[4], npart[5]});
       }
       // end of try block
       
@@ -386,6 +382,11 @@ namespace PR {
 	{
 	  error.printErrorStack();
 	}
+
+      // Keep one entry per file, even for a file that failed
+      //
+      if (fnpart.size() < ++nfile)
+	fnpart.push_back({0, 0, 0, 0, 0, 0});
     }
       
     Pfound.clear();
@@ -393,8 +394,18 @@ namespace PR {
   }
 
 
+  bool GadgetHDF5::localRange()
+  {
+    std::tie(fbeg, fend) = gadgetShare(fnpart, curfile - _files.begin(),
+				       ptype, myid, numprocs);
+    return fend > fbeg;
+  }
+
   bool GadgetHDF5::nextFile()
   {
+    // Skip files that hold none of this process' particles
+    while (curfile!=_files.end() and not localRange()) curfile++;
+
     if (curfile==_files.end()) return false;
     read_and_load();
     curfile++;
@@ -441,150 +452,92 @@ namespace PR {
 	attr.read(type, npart);
       }
       
+      totalCount = nptot[ptype];
+
+      particles.clear();
+      pcount = 0;
+
       if (npart[ptype]>0) {
 	std::ostringstream sout;
 	sout << "PartType" << ptype;
 	
-	totalCount = npart[ptype];
-
 	std::string grpnam = "/" + sout.str();
 	H5::Group grp(file.openGroup(grpnam));
-	H5::DataSet dataset = grp.openDataSet("Coordinates");
-	H5::DataSpace dataspace = dataset.getSpace();
-	
-	// Get the number of dimensions in the dataspace.
-	//
-	int rank = dataspace.getSimpleExtentNdims();
-	
-	// Get the dimension size of each dimension in the dataspace and
-	// display them.
-	//
-	hsize_t dims[2];
-	int ndims = dataspace.getSimpleExtentDims( dims, NULL);
-	if (myid==0 and _verbose)
-	  std::cout << "GadgetHDF5: coordinate rank " << rank
-		    << ", dimensions " <<
-	    (unsigned long)(dims[0]) << " x " <<
-	    (unsigned long)(dims[1]) << std::endl;
-	
-	// Define the memory space to read dataset.
+
+	// This process' rows [fbeg, fend) of the file
 	//
-	H5::DataSpace mspace(rank, dims);
-	
-	std::vector<float> buf(dims[0]*dims[1]);
-	dataset.read(&buf[0], H5::PredType::NATIVE_FLOAT, mspace, dataspace );
-	
-	if (myid==0 and _verbose)
-	  std::cout << "GadgetHDF5: coordinate storage size="
-		    << dataset.getStorageSize() << std::endl;
-	
-	// Clear and load the particle vector
+	hsize_t n = fend - fbeg;
+
+	// Read the rows of a dataset with ncol columns into a
+	// contiguous buffer
 	//
-	particles.clear();
-
-	Particle P;		// Working particle will be copied
-	for (int n=0; n<dims[0]; n++) {
-	  if (n % numprocs ==  myid) {
-	    P.mass  = mass[ptype];
-	    P.level = 0;
-	    for (int k=0; k<3; k++) P.pos[k] = buf[n*3+k];
-	    particles.push_back(P);
-	  }
-	}
-	
-	// Get velocities
-	dataspace.close();
-	dataset.close();
+	auto slab = [&](H5::DataSet& dataset, hsize_t ncol, auto& buf,
+			const H5::PredType& type)
+	{
+	  H5::DataSpace fspace = dataset.getSpace();
+	  int rank = fspace.getSimpleExtentNdims();
+
+	  hsize_t start[2] = {fbeg, 0}, count[2] = {n, ncol};
+	  fspace.selectHyperslab(H5S_SELECT_SET, count, start);
+
+	  H5::DataSpace mspace(rank, count);
+	  buf.resize(n*ncol);
+	  dataset.read(buf.data(), type, mspace, fspace);
+
+	  if (myid==0 and _verbose)
+	    std::cout << "GadgetHDF5: " << dataset.getObjName()
+		      << " storage size=" << dataset.getStorageSize()
+		      << std::endl;
+	};
+
+	std::vector<float> pos, vel, mss;
+	std::vector<unsigned> seq;
+
+	H5::DataSet dataset = grp.openDataSet("Coordinates");
+	slab(dataset, 3, pos, H5::PredType::NATIVE_FLOAT);
+
 	dataset = grp.openDataSet("Velocities");
-	dataspace = dataset.getSpace();
-	
-	std::vector<float> vel(dims[0]*dims[1]);
-	dataset.read(&vel[0], H5::PredType::NATIVE_FLOAT, mspace, dataspace );
-	
-	if (myid==0 and _verbose)
-	  std::cout << "GadgetHDF5: velocity storage size="
-		    << dataset.getStorageSize() << std::endl;
-	
-	auto it = particles.begin();
-	for (int n=0; n<dims[0]; n++) {
-	  if (n % numprocs ==  myid) {
-	    for (int k=0; k<3; k++) it->vel[k] = vel[n*3+k];
-	    it++;
-	  }
-	}
-	
-	dataspace.close();
-	
+	slab(dataset, 3, vel, H5::PredType::NATIVE_FLOAT);
+
 	// Try to get Masses.  This will override the assignment from
 	// the header if the data exists.
 	//
 	try {
 	  dataset = grp.openDataSet("Masses");
-	
-	  if (myid==0 and _verbose)
-	    std::cout << "GadgetHDF5: mass storage size="
-		      << dataset.getStorageSize() << std::endl;
-	  
-	  if (dataset.getStorageSize()) {
-	    
-	    dataspace = dataset.getSpace();
-	    
-	    int rank = dataspace.getSimpleExtentNdims();
-	    
-	    auto dims = std::make_unique<hsize_t[]>(rank);
-	    
-	    int ndims = dataspace.getSimpleExtentDims(dims.get(), NULL);
-	    
-	    H5::DataSpace mspace(rank, dims.get());
-	    
-	    std::vector<float> masses(dims[0]);
-	    dataset.read(&masses[0], H5::PredType::NATIVE_FLOAT, mspace, dataspace );
-	  
-	    auto it = particles.begin();
-	    for (int n=0; n<dims[0]; n++) {
-	      if (n % numprocs == myid) (it++)->mass = masses[n];
-	    }
-	  }
+	  if (dataset.getStorageSize())
+	    slab(dataset, 1, mss, H5::PredType::NATIVE_FLOAT);
 	}
 	catch(H5::GroupIException error)
 	  {
 	    error.printErrorStack();
 	  }
 
-	
-	dataspace.close();
-	dataset.close();
-	
 	// Try to get particle ids
 	//
 	dataset = grp.openDataSet("ParticleIDs");
+	if (dataset.getStorageSize())
+	  slab(dataset, 1, seq, H5::PredType::NATIVE_UINT32);
 	
-	
-	if (myid==0 and _verbose)
-	  std::cout << "GadgetHDF5: particle ID storage size="
-		    << dataset.getStorageSize() << std::endl;
-	
-	if (dataset.getStorageSize()) {
-	  
-	  dataspace = dataset.getSpace();
-	  
-	  int rank = dataspace.getSimpleExtentNdims();
-	  
-	  auto dims = std::make_unique<hsize_t[]>(rank);
-	  
-	  int ndims = dataspace.getSimpleExtentDims( dims.get(), NULL);
-	  
-	  H5::DataSpace mspace(rank, dims.get());
-	  
-	  std::vector<unsigned> seq(dims[0]);
-	  dataset.read(&seq[0], H5::PredType::NATIVE_UINT32, mspace, dataspace );
-	  
-	  auto it = particles.begin();
-	  for (int n=0; n<dims[0]; n++) {
-	    if (n % numprocs == myid) (it++)->indx = seq[n];
+	dataset.close();
+
+	// Unpack
+	//
+	particles.resize(n);
+
+	bool   pmass = mss.size() == n;
+	bool   pseq  = seq.size() == n;
+	double cmass = mass[ptype];
+
+#pragma omp parallel for schedule(static)
+	for (hsize_t i=0; i<n; i++) {
+	  Particle & P = particles[i];
+	  for (int k=0; k<3; k++) {
+	    P.pos[k] = pos[i*3+k];
+	    P.vel[k] = vel[i*3+k];
 	  }
-	} else {
-	  for (int n=0; n<dims[0]; n++) particles[n].indx = n + 1;
+	  P.mass  = pmass ? mss[i] : cmass;
+	  P.indx  = pseq  ? seq[i] : fbeg + i + 1;
+	  P.level = 0;
 	}
       } else {
 	std::cerr << "GadgetHDF5:: zero pass particles for type <"
@@ -620,6 +573,11 @@ namespace PR {
   {
     pcount = 0;
     
+    if (particles.size()==0) {
+      if (nextFile()) return firstParticle();
+      else return 0;
+    }
+
     return & particles[pcount++];
   }
   
@@ -634,6 +592,295 @@ namespace PR {
   }
   
   
+  const std::set<std::string> EXPH5::allColumns
+  {"index", "mass", "pos", "vel", "pot", "iattrib", "dattrib"};
+
+  EXPH5::EXPH5(const std::vector<std::string>& files, bool verbose)
+  {
+    _files   = files;
+    _verbose = verbose;
+
+    columns  = allColumns;
+    rbeg     = 0;
+    rend     = std::numeric_limits<unsigned long>::max();
+
+    totalCount = 0;		// Initialization of particles read
+
+    getNumbers();
+
+    // Default is the first component in the file.  No particles are
+    // read until the first access, so SelectColumns() and
+    // SelectRange() cost nothing extra after this.
+    //
+    if (Pfound.size()) SelectType(Pfound[0]);
+    else {
+      std::cerr << "EXPH5: no components found" << std::endl;
+    }
+  }
+
+  void EXPH5::SelectColumns(const std::vector<std::string>& cols)
+  {
+    if (cols.size()==0) {
+      columns = allColumns;
+      return;
+    }
+
+    columns.clear();
+    for (auto c : cols) {
+      if (allColumns.find(c) == allColumns.end()) {
+	std::ostringstream sout;
+	sout << "EXPH5: no column <" << c << ">.  Valid columns are:";
+	for (auto v : allColumns) sout << " " << v;
+	throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+      }
+      columns.insert(c);
+    }
+
+    loaded = false;		// Reread with the new columns
+  }
+
+  void EXPH5::SelectRange(unsigned long beg, unsigned long end)
+  {
+    rbeg = beg;
+    rend = end;
+				// Recount and reread the selection
+    if (curType.size()) SelectType(curType);
+  }
+
+  void EXPH5::getNumbers()
+  {
+    if (_files.size()==0) return;
+
+    try {
+      H5::Exception::dontPrint();
+
+      H5::H5File file(_files[0], H5F_ACC_RDONLY);
+
+      // Check the format tag
+      {
+	H5::Attribute attr(file.openAttribute("format"));
+	std::string format;
+	attr.read(attr.getStrType(), format);
+	if (format != "EXPH5") {
+	  std::ostringstream sout;
+	  sout << "EXPH5: file <" << _files[0] << "> has format <"
+	       << format << ">, expected <EXPH5>";
+	  throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+	}
+      }
+
+      // Get time
+      {
+	H5::Attribute attr(file.openAttribute("time"));
+	attr.read(H5::PredType::NATIVE_DOUBLE, &time);
+      }
+
+      // Each group is a component
+      Pfound.clear();
+      for (hsize_t i=0; i<file.getNumObjs(); i++) {
+	if (file.getObjTypeByIdx(i) == H5G_GROUP)
+	  Pfound.push_back(file.getObjnameByIdx(i));
+      }
+    }
+    catch (H5::Exception& error) {
+      std::ostringstream sout;
+      sout << "EXPH5: error reading header from <" << _files[0] << ">: "
+	   << error.getDetailMsg();
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+    }
+  }
+
+  void EXPH5::SelectType(const std::string& type)
+  {
+    if (std::find(Pfound.begin(), Pfound.end(), type) == Pfound.end()) {
+      std::cerr << "EXPH5 error: no component <" << type << ">" << std::endl;
+      std::cerr << "Valid EXPH5 components are:";
+      for (auto s : Pfound) std::cerr << " " << s;
+      std::cerr << std::endl;
+      throw std::runtime_error("EXPH5: non-existent component");
+    }
+
+    curType = type;
+
+    // Total number in the selected range over all files
+    //
+    totalCount = 0;
+    for (auto f : _files) {
+      try {
+	H5::Exception::dontPrint();
+
+	H5::H5File file(f, H5F_ACC_RDONLY);
+	H5::Group  grp(file.openGroup(curType));
+	H5::Attribute attr(grp.openAttribute("nbodies"));
+
+	unsigned long N;
+	attr.read(H5::PredType::NATIVE_ULONG, &N);
+
+	unsigned long b = std::min<unsigned long>(rbeg, N);
+	unsigned long e = std::min<unsigned long>(rend, N);
+	if (e > b) totalCount += e - b;
+      }
+      catch (H5::Exception& error) {
+	std::ostringstream sout;
+	sout << "EXPH5: error reading component <" << curType << "> from <"
+	     << f << ">: " << error.getDetailMsg();
+	throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+      }
+    }
+
+    // The particles are read on the first access
+    //
+    particles.clear();
+    pcount  = 0;
+    loaded  = false;
+  }
+
+  bool EXPH5::nextFile()
+  {
+    if (curfile==_files.end()) return false;
+    read_and_load();
+    curfile++;
+    return true;
+  }
+
+  void EXPH5::read_and_load()
+  {
+    particles.clear();
+    pcount = 0;
+
+    try {
+      H5::Exception::dontPrint();
+
+      H5::H5File file(*curfile, H5F_ACC_RDONLY);
+      H5::Group  grp(file.openGroup(curType));
+
+      unsigned long N;
+      int niattrib, ndattrib;
+      grp.openAttribute("nbodies") .read(H5::PredType::NATIVE_ULONG, &N);
+      grp.openAttribute("niattrib").read(H5::PredType::NATIVE_INT,   &niattrib);
+      grp.openAttribute("ndattrib").read(H5::PredType::NATIVE_INT,   &ndattrib);
+
+      // This process' hyperslab of the selected range
+      //
+      unsigned long b = std::min<unsigned long>(rbeg, N);
+      unsigned long e = std::max<unsigned long>(b, std::min<unsigned long>(rend, N));
+      unsigned long beg = b + (e - b)*myid/numprocs;
+      unsigned long end = b + (e - b)*(myid+1)/numprocs;
+      hsize_t n = end - beg;
+
+      if (n==0) return;
+
+      particles.resize(n, Particle(niattrib, ndattrib));
+      for (hsize_t i=0; i<n; i++) {
+	particles[i].indx  = beg + i + 1;
+	particles[i].level = 0;
+      }
+
+      // Read rows [beg, end) of a dataset with ncol columns
+      //
+      auto slab = [&](const std::string& name, hsize_t ncol, auto& buf,
+		      const H5::PredType& type)
+      {
+	H5::DataSet   dataset = grp.openDataSet(name);
+	H5::DataSpace fspace  = dataset.getSpace();
+
+	hsize_t start[2] = {beg, 0}, count[2] = {n, ncol};
+	int rank = fspace.getSimpleExtentNdims();
+	fspace.selectHyperslab(H5S_SELECT_SET, count, start);
+
+	H5::DataSpace mspace(rank, count);
+	buf.resize(n*ncol);
+	dataset.read(buf.data(), type, mspace, fspace);
+
+	if (myid==0 and _verbose)
+	  std::cout << "EXPH5: " << name << " storage size="
+		    << dataset.getStorageSize() << std::endl;
+      };
+
+      std::vector<double> dbuf;
+      std::vector<int>    ibuf;
+      std::vector<unsigned long> ubuf;
+
+      if (columns.count("index")) {
+	slab("index", 1, ubuf, H5::PredType::NATIVE_ULONG);
+	for (hsize_t i=0; i<n; i++) particles[i].indx = ubuf[i];
+      }
+
+      if (columns.count("mass")) {
+	slab("mass", 1, dbuf, H5::PredType::NATIVE_DOUBLE);
+	for (hsize_t i=0; i<n; i++) particles[i].mass = dbuf[i];
+      }
+
+      if (columns.count("pos")) {
+	slab("pos", 3, dbuf, H5::PredType::NATIVE_DOUBLE);
+	for (hsize_t i=0; i<n; i++)
+	  for (int k=0; k<3; k++) particles[i].pos[k] = dbuf[i*3+k];
+      }
+
+      if (columns.count("vel")) {
+	slab("vel", 3, dbuf, H5::PredType::NATIVE_DOUBLE);
+	for (hsize_t i=0; i<n; i++)
+	  for (int k=0; k<3; k++) particles[i].vel[k] = dbuf[i*3+k];
+      }
+
+      if (columns.count("pot")) {
+	slab("pot", 1, dbuf, H5::PredType::NATIVE_DOUBLE);
+	for (hsize_t i=0; i<n; i++) particles[i].pot = dbuf[i];
+      }
+
+      if (niattrib and columns.count("iattrib")) {
+	slab("iattrib", niattrib, ibuf, H5::PredType::NATIVE_INT);
+	for (hsize_t i=0; i<n; i++)
+	  for (int k=0; k<niattrib; k++)
+	    particles[i].iattrib[k] = ibuf[i*niattrib+k];
+      }
+
+      if (ndattrib and columns.count("dattrib")) {
+	slab("dattrib", ndattrib, dbuf, H5::PredType::NATIVE_DOUBLE);
+	for (hsize_t i=0; i<n; i++)
+	  for (int k=0; k<ndattrib; k++)
+	    particles[i].dattrib[k] = dbuf[i*ndattrib+k];
+      }
+    }
+    catch (H5::Exception& error) {
+      std::ostringstream sout;
+      sout << "EXPH5: error reading component <" << curType << "> from <"
+	   << *curfile << ">: " << error.getDetailMsg();
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+    }
+  }
+
+  const Particle* EXPH5::firstParticle()
+  {
+    if (not loaded) {		// Set to first file and open
+      loaded  = true;
+      curfile = _files.begin();
+      nextFile();
+    }
+
+    pcount = 0;
+
+    if (particles.size()==0) {
+      if (nextFile()) return firstParticle();
+      else return 0;
+    }
+
+    return & particles[pcount++];
+  }
+
+  const Particle* EXPH5::nextParticle()
+  {
+    if (not loaded) return firstParticle();
+
+    if (pcount < particles.size()) {
+      return & particles[pcount++];
+    } else {
+      if (nextFile()) return firstParticle();
+      else return 0;
+    }
+  }
+
+
   bool badstatus(istream& in)
   {
     ios::iostate i = in.rdstate();
@@ -1198,6 +1445,228 @@ namespace PR {
   }
   
   
+  MappedFile::MappedFile(const std::string& file)
+  {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      std::ostringstream sout;
+      sout << "MappedFile: could not open <" << file << ">";
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+    }
+
+    struct stat sb;
+    if (fstat(fd, &sb) < 0) {
+      close(fd);
+      std::ostringstream sout;
+      sout << "MappedFile: could not stat <" << file << ">";
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+    }
+
+    len  = sb.st_size;
+    base = nullptr;
+
+    if (len) {
+      void* p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED) {
+	close(fd);
+	std::ostringstream sout;
+	sout << "MappedFile: could not map <" << file << ">";
+	throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+      }
+      base = static_cast<const char*>(p);
+
+      // Records are scanned front to back
+      madvise(p, len, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (base) munmap(const_cast<char*>(base), len);
+  }
+
+  PSPlayout::PSPlayout(const PSPstanza& s)
+  {
+    rsize   = s.r_size;
+    isize   = s.index_size;
+    niatr   = s.comp.niatr;
+    ndatr   = s.comp.ndatr;
+
+    mass    = isize;
+    pos     = mass  + rsize;
+    vel     = pos   + 3*rsize;
+    pot     = vel   + 3*rsize;
+    iattr   = pot   + rsize;
+    dattr   = iattr + niatr*sizeof(int);
+    recsize = dattr + ndatr*rsize;
+  }
+
+  size_t PSPblock::column(const std::string& name, std::vector<double>& out) const
+  {
+    size_t off = 0, width = 1;
+    bool   ints = false;
+
+    if      (name == "mass")    { off = L->mass;  width = 1;        }
+    else if (name == "pos")     { off = L->pos;   width = 3;        }
+    else if (name == "vel")     { off = L->vel;   width = 3;        }
+    else if (name == "pot")     { off = L->pot;   width = 1;        }
+    else if (name == "iattrib") { off = L->iattr; width = L->niatr; ints = true; }
+    else if (name == "dattrib") { off = L->dattr; width = L->ndatr; }
+    else throw std::runtime_error("PSPblock::column: unknown column <" + name + ">");
+
+    out.resize(count*width);
+
+    const char* q = base + off;
+    for (unsigned long i=0; i<count; i++, q+=L->recsize) {
+      for (size_t k=0; k<width; k++) {
+	if (ints) {
+	  int v; std::memcpy(&v, q + k*sizeof(int), sizeof(int));
+	  out[i*width+k] = v;
+	} else
+	  out[i*width+k] = L->real(q + k*L->rsize);
+      }
+    }
+
+    return width;
+  }
+
+  PSPmap::PSPmap(const std::vector<std::string>& file, bool split, bool verbose)
+  {
+    // The stream readers parse the headers and stanza list
+    //
+    if (split) psp = std::make_shared<PSPspl>(file, verbose);
+    else       psp = std::make_shared<PSPout>(file, verbose);
+
+    // For the OUT format, the records are in the master file
+    //
+    if (not split) getMap(file[0]);
+
+    cur = psp->GetStanza();
+    if (cur) mapStanza();
+  }
+
+  std::shared_ptr<MappedFile> PSPmap::getMap(const std::string& file)
+  {
+    auto it = maps.find(file);
+    if (it != maps.end()) return it->second;
+    return maps[file] = std::make_shared<MappedFile>(file);
+  }
+
+  void PSPmap::SelectType(const std::string& name)
+  {
+    cur = psp->GetNamed(name);
+    if (not cur) {
+      std::cout << "PSPmap error: no particle type <" << name << ">" << std::endl;
+      throw std::runtime_error("PSPmap error: non-existent particle type");
+    }
+    mapStanza();
+  }
+
+  void PSPmap::mapStanza()
+  {
+    layout = PSPlayout(*cur);
+    segs.clear();
+
+    unsigned long first = 0;
+
+    if (cur->nparts.size()) {
+      // SPL: each blob is a particle count followed by the records
+      //
+      for (auto & f : cur->nparts) {
+	auto m = getMap(f);
+	unsigned int N = 0;
+	if (m->size() >= sizeof(unsigned int))
+	  std::memcpy(&N, m->data(), sizeof(unsigned int));
+
+	if (sizeof(unsigned int) + N*layout.recsize > m->size()) {
+	  std::ostringstream sout;
+	  sout << "PSPmap: SPL blob <" << f << "> is truncated";
+	  throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+	}
+
+	segs.push_back({m->data() + sizeof(unsigned int), first, N});
+	first += N;
+      }
+    } else {
+      // OUT: one run of records in the master file
+      //
+      auto m = maps.begin()->second;
+      size_t off = cur->pspos;
+      if (off + cur->comp.nbod*layout.recsize > m->size()) {
+	std::ostringstream sout;
+	sout << "PSPmap: component <" << cur->name << "> is truncated";
+	throw GenericError(sout.str(), __FILE__, __LINE__, 1041, true);
+      }
+      segs.push_back({m->data() + off, 0, (unsigned long)cur->comp.nbod});
+      first = cur->comp.nbod;
+    }
+
+    // Contiguous share for this process
+    //
+    rbeg = first*myid/numprocs;
+    rend = first*(myid+1)/numprocs;
+  }
+
+  std::vector<PSPblock> PSPmap::Blocks(unsigned long beg, unsigned long end,
+				       unsigned long bsize)
+  {
+    std::vector<PSPblock> ret;
+    bsize = std::max<unsigned long>(bsize, 1);
+
+    for (auto & s : segs) {
+      unsigned long b = std::max(beg, s.first);
+      unsigned long e = std::min(end, s.first + s.count);
+      for (; b<e; b+=bsize) {
+	unsigned long n = std::min(bsize, e - b);
+	ret.push_back({s.base + (b - s.first)*layout.recsize, b, n, &layout});
+      }
+    }
+
+    return ret;
+  }
+
+  const Particle* PSPmap::firstParticle()
+  {
+    pnext = rbeg;
+    iseg  = 0;
+
+    part.iattrib.resize(layout.niatr);
+    part.dattrib.resize(layout.ndatr);
+    part.potext = 0.0;
+
+    return nextParticle();
+  }
+
+  const Particle* PSPmap::nextParticle()
+  {
+    if (pnext >= rend) return 0;
+
+    while (iseg < segs.size() and
+	   pnext >= segs[iseg].first + segs[iseg].count) iseg++;
+
+    if (iseg == segs.size()) return 0;
+
+    auto & s = segs[iseg];
+    PSPview v(s.base + (pnext - s.first)*layout.recsize, &layout, pnext);
+
+    part.indx = v.indx();
+    part.mass = v.mass();
+    for (int k=0; k<3; k++) {
+      part.pos[k] = v.pos(k);
+      part.vel[k] = v.vel(k);
+    }
+    part.pot = v.pot();
+    for (size_t k=0; k<layout.niatr; k++) part.iattrib[k] = v.iattr(k);
+    for (size_t k=0; k<layout.ndatr; k++) part.dattrib[k] = v.dattr(k);
+
+    pnext++;
+
+    return &part;
+  }
+  
   void PSP::ComputeStats()
   {
     cur = &(*spos);
@@ -1292,7 +1761,7 @@ namespace PR {
   
   
   std::vector<std::string> ParticleReader::readerTypes
-  {"PSPout", "PSPspl", "GadgetNative", "GadgetHDF5", "TipsyNative", "TipsyXDR", "Bonsai"};
+  {"PSPout", "PSPspl", "PSPoutMap", "PSPsplMap", "GadgetNative", "GadgetHDF5", "EXPH5", "TipsyNative", "TipsyXDR", "Bonsai"};
   
   
   std::vector<std::vector<std::string>>
@@ -1366,7 +1835,11 @@ namespace PR {
   {
     std::shared_ptr<ParticleReader> ret;
     
-    if (reader.find("PSPout") == 0)
+    if (reader.find("PSPoutMap") == 0)
+      ret = std::make_shared<PSPmap>(file, false, verbose);
+    else if (reader.find("PSPsplMap") == 0)
+      ret = std::make_shared<PSPmap>(file, true, verbose);
+    else if (reader.find("PSPout") == 0)
       ret = std::make_shared<PSPout>(file, verbose);
     else if (reader.find("PSPspl") == 0)
       ret = std::make_shared<PSPspl>(file, verbose);
@@ -1374,6 +1847,8 @@ namespace PR {
       ret = std::make_shared<GadgetNative>(file, verbose);
     else if (reader.find("GadgetHDF5") == 0)
       ret = std::make_shared<GadgetHDF5>(file, verbose);
+    else if (reader.find("EXPH5") == 0)
+      ret = std::make_shared<EXPH5>(file, verbose);
     else if (reader.find("TipsyNative") == 0)
       ret = std::make_shared<Tipsy>(file, Tipsy::TipsyType::native, verbose);
     else if (reader.find("TipsyXDR") == 0)
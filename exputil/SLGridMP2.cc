@@ -16,6 +16,8 @@
 #include <iomanip>
 #include <cstdlib>
 #include <vector>
+#include <functional>
+#include <chrono>
 
 #include <EXPException.H>
 #include <SLGridMP2.H>
@@ -78,8 +80,113 @@ std::string sledge_error(int flag)
   }
 }
 
-static double L2, M2, K2;
-static int sl_dim;
+//! Compute <code>ntab</code> independent SL tables with all threads
+//! of all processes and leave the complete set on every process.
+//! Table i belongs to process i % numprocs whose threads share its
+//! tables.  Each table is then broadcast from its owner using the
+//! class' pack/unpack members.  Threads are only used if sledge was
+//! compiled to be thread safe.  Returns the number of tables with
+//! sledge errors over all processes; in that case, the tables are not
+//! shared and the first local error message is in <code>error</code>.
+//!
+//! If the tables are in the node-shared block <code>store</code>,
+//! every node already holds the tables computed by its processes and
+//! only the node leaders take part in the broadcast, from the leader
+//! of the owner's node.
+static int SLbuildTables(const std::string& label, int ntab, bool use_mpi,
+			 bool progress, char* buf, int bufsz,
+			 std::function<void(int)> compute,
+			 std::function<int(int)> pack,
+			 std::function<void(void)> unpack,
+			 std::string& error, NodeShared* store=nullptr)
+{
+  using clock = std::chrono::steady_clock;
+
+  int myid = 0, numprocs = 1, nthrds = 1;
+  if (use_mpi) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+    MPI_Comm_size(MPI_COMM_WORLD, &numprocs);
+  }
+#ifdef HAVE_SLEDGE_OMP
+  nthrds = omp_get_max_threads();
+#endif
+
+  std::vector<int> mine;
+  for (int i=myid; i<ntab; i+=numprocs) mine.push_back(i);
+
+  auto beg = clock::now();
+  int bad = 0, done = 0, nmine = mine.size();
+  double busy = 0.0;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthrds) reduction(+:bad,busy)
+  for (int k=0; k<nmine; k++) {
+    auto t0 = clock::now();
+    try {
+      compute(mine[k]);
+    }
+    catch (std::exception& e) {
+      bad++;
+#pragma omp critical (SLbuild_error)
+      if (error.empty()) error = e.what();
+    }
+    std::chrono::duration<double> dt = clock::now() - t0;
+    busy += dt.count();
+
+    if (progress and myid==0) {
+#pragma omp critical (SLbuild_progress)
+      std::cout << label << ": table " << mine[k]
+		<< " [" << ++done << "/" << nmine << " on root] "
+		<< dt.count() << " s" << std::endl;
+    }
+  }
+
+  if (use_mpi) {
+    MPI_Allreduce(MPI_IN_PLACE, &bad,  1, MPI_INT,    MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &busy, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  }
+
+  if (bad) return bad;
+
+  if (use_mpi and numprocs>1 and store and store->shared()) {
+    store->sync();		// The owners' tables are on their nodes
+    MPI_Comm leaders = NodeShared::leaderComm();
+    if (leaders != MPI_COMM_NULL) {
+      int node;
+      MPI_Comm_rank(leaders, &node);
+      for (int i=0; i<ntab; i++) {
+	int owner = NodeShared::nodeOf(i % numprocs);
+	if (owner==node) pack(i);
+	MPI_Bcast(buf, bufsz, MPI_PACKED, owner, leaders);
+	if (owner!=node) unpack();
+      }
+    }
+    store->sync();		// Wait for the leader
+  }
+  else if (use_mpi and numprocs>1) {
+    for (int i=0; i<ntab; i++) {
+      int owner = i % numprocs;
+      if (myid==owner) pack(i);
+      MPI_Bcast(buf, bufsz, MPI_PACKED, owner, MPI_COMM_WORLD);
+      if (myid!=owner) unpack();
+    }
+  }
+
+  if (progress and myid==0) {
+    std::chrono::duration<double> wall = clock::now() - beg;
+    std::cout << label << ": " << ntab << " tables on "
+	      << numprocs << " process(es) x " << nthrds << " thread(s) in "
+	      << wall.count() << " s, solver time " << busy
+	      << " s, efficiency "
+	      << busy/(wall.count()*numprocs*nthrds) << std::endl;
+  }
+
+  return 0;
+}
+
+
+// Parameters for the coefficient callback, one copy per thread
+static thread_local double L2, M2, K2;
+static thread_local int sl_dim;
 
 
 //======================================================================
@@ -87,7 +194,8 @@ static int sl_dim;
 //======================================================================
 
 
-int SLGridSph::mpi = 0;		// initially off
+int  SLGridSph::mpi         = 0;		// initially off
+bool SLGridSph::progress    = false;	// no build report
 
 extern "C" {
   int sledge_(logical* job, doublereal* cons, logical* endfin, 
@@ -135,7 +243,7 @@ SLGridSph::SLGridSph(std::string modelname,
 		     double RMIN, double RMAX, 
 		     bool CACHE, int CMAP, double RMAP,
 		     int DIVERGE, double DFAC,
-		     std::string cachename, bool VERBOSE)
+		     std::string cachename, bool VERBOSE, bool SHARED)
 {
   if (modelname.size()) model_file_name = modelname;
   else                  model_file_name = default_model;
@@ -147,6 +255,7 @@ SLGridSph::SLGridSph(std::string modelname,
   tbdbg    = VERBOSE;
   diverge  = DIVERGE;
   dfac     = DFAC;
+  node_shared = SHARED;
 
   initialize(LMAX, NMAX, NUMR, RMIN, RMAX, CACHE, CMAP, RMAP);
 }
@@ -154,12 +263,13 @@ SLGridSph::SLGridSph(std::string modelname,
 SLGridSph::SLGridSph(std::shared_ptr<SphericalModelTable> mod,
 		     int LMAX, int NMAX, int NUMR, double RMIN, double RMAX, 
 		     bool CACHE, int CMAP, double RMAP,
-		     std::string cachename, bool VERBOSE)
+		     std::string cachename, bool VERBOSE, bool SHARED)
 {
   model    = mod;
   tbdbg    = VERBOSE;
   diverge  = 0;
   dfac     = 1;
+  node_shared = SHARED;
 
   if (cachename.size()) sph_cache_name  = cachename;
   else throw std::runtime_error("SLGridSph: you must specify a cachename");
@@ -174,6 +284,7 @@ SLGridSph::SLGridSph(std::string cachename)
   else throw std::runtime_error("SLGridSph: you must specify a cachename");
 
   tbdbg = false;
+  node_shared = false;
 
   int LMAX, NMAX, NUMR, CMAP, DIVERGE=0;
   double RMIN, RMAX, RMAP, DFAC=1.0;
@@ -228,12 +339,26 @@ SLGridSph::cacheInfo(const std::string& cachefile, bool verbose)
 }
 
 
+void SLGridSph::allocate_tables()
+{
+  const size_t blk = static_cast<size_t>(nmax)*(numr+1);
+
+  table      = table_ptr_1D(new TableSph [lmax+1]);
+  tableStore = std::make_shared<NodeShared>(blk*(lmax+1), node_shared and mpi);
+  tableStore->report("SLGridSph tables");
+
+  for (int l=0; l<=lmax; l++) {
+    double* p = tableStore->data() + blk*l;
+    table[l].l = l;
+    new (&table[l].ev) Eigen::Map<Eigen::VectorXd>(p, nmax);
+    new (&table[l].ef) Eigen::Map<Eigen::MatrixXd>(p + nmax, nmax, numr);
+  }
+}
+
 void SLGridSph::initialize(int LMAX, int NMAX, int NUMR,
 			   double RMIN, double RMAX, 
 			   bool CACHE, int CMAP, double RMAP)
 {
-  int l;
-
   lmax  = LMAX;
   nmax  = NMAX;
   numr  = NUMR;
@@ -255,194 +380,79 @@ void SLGridSph::initialize(int LMAX, int NMAX, int NUMR,
       std::cout << "Process " << myid << ": MPI is off!" << std::endl;
   }
 
-  table = 0;
-  
-  if (not ReadH5Cache()) {
-
-    // MPI loop
-    //
-    if (mpi) {
-
-      table = table_ptr_1D(new TableSph [lmax+1]);
-      
-      mpi_setup();
-      
-      int totbad = 0;		// Count total number of sledge errors
-
-      if (mpi_myid) {		// Begin workers
-	compute_table_worker();
-	
-	//
-	// <Receive completed table from root>
-	//
-
-	for (l=0; l<=lmax; l++) {
-
-	  MPI_Bcast(&mpi_buf[0], mpi_bufsz, MPI_PACKED, 0, MPI_COMM_WORLD);
-    
-	  mpi_unpack_table();      
-	}
-	
-      }
-      else {			// BEGIN Root
-	
-	int worker = 0;
-	int request_id = 1;
-
-	l=0;
-
-	while (l<=lmax) {
-
-	  if (worker<mpi_numprocs-1) { // Send request to worker
-	    worker++;
-	    
-	    
-	    if (tbdbg)
-	      std::cout << "Root sending orders to Worker " << worker 
-			<< ": l=" << l << std::endl; 
-	    
-	    MPI_Send(&request_id, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-	    MPI_Send(&l, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-	    
-	    if (tbdbg)
-	      std::cout << "Root gave orders to Worker " << worker 
-			<< ": l=" << l << std::endl;
-	    
-	    // Increment counters
-	    l++;
-	  }
-	  
-	  if (worker == mpi_numprocs-1 && l<=lmax) {
-	  
-	    //
-	    // <Wait and receive>
-	    //
-	    
-#ifdef SLEDGE_THROW
-	    int bad;		// Get the sledge error count from a
-				// worker
-	    MPI_Recv(&bad, 1, MPI_INT, MPI_ANY_SOURCE, 10,
-		     MPI_COMM_WORLD, &status);
-	    totbad += bad;
-	    int retid = status.MPI_SOURCE;
-	    MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, retid, 11,
-		     MPI_COMM_WORLD, &status);
-#else
-	    MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, MPI_ANY_SOURCE, 
-		     MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-	    
-	    int retid = status.MPI_SOURCE;
-#endif
-	  
-	    mpi_unpack_table();      
-
-	    //
-	    // <Send new request>
-	    //
-	    
-	    MPI_Send(&request_id, 1, MPI_INT, retid, 11, MPI_COMM_WORLD);
-	    MPI_Send(&l, 1, MPI_INT, retid, 11, MPI_COMM_WORLD);
-	    
-	    if (tbdbg) 
-	      std::cout << "Root g orders to Worker " << retid
-			<< ": l=" << l << std::endl;
-	    
-	    // Increment counters
-	    l++;
-	  }
-	}
-	
-	//
-	// <Wait for all workers to return>
-	//
-      
-	while (worker) {
-#ifdef SLEDGE_THROW
-	  int bad;		// Get the sledge error count from a
-				// worker
-	  MPI_Recv(&bad, 1, MPI_INT, MPI_ANY_SOURCE, 10,
-		   MPI_COMM_WORLD, &status);
-	  totbad += bad;
-
-	  int retid = status.MPI_SOURCE;
-	  MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, retid, 11,
-		   MPI_COMM_WORLD, &status);
-#else
-	  MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, MPI_ANY_SOURCE, 11,
-		   MPI_COMM_WORLD, &status);
-	  
-#endif
-	  mpi_unpack_table();      
-	  
-	  worker--;
-	}
-
-	//
-	// <Tell workers to continue>
-	//
-      
-	request_id = -1;
-	for (worker=1; worker < mpi_numprocs; worker++)
-	  MPI_Send(&request_id, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-
-
-	//
-	// <Send table to workers>
-	//
-
-	for (l=0; l<=lmax; l++) {
-	  int position = mpi_pack_table(&table[l], l);
+  allocate_tables();
 
-	  MPI_Bcast(&mpi_buf[0], position, MPI_PACKED, 0, MPI_COMM_WORLD);
-	}
-
-      }
-      // END Root
-
-#ifdef SLEDGE_THROW
-      // Share the total sledge error count with all nodes
-      MPI_Bcast(&totbad, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-      // Emit runtime exception on sledge errors
-      if (totbad) {
-	std::ostringstream sout;
+  // Only the node leaders read a shared table, so all processes must
+  // agree on the outcome
+  //
+  auto agree = [this](bool found)
+  {
+    if (not tableStore->shared()) return found;
+    int ok = found;
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    return ok>0;
+  };
+
+  // A matching named cache is used first.  Otherwise, look in the
+  // shared basis store, if configured.
+  //
+  bool store = cache and BasisCache::enabled();
+  bool found = agree(ReadH5Cache());
 
-	if (myid==0) {
-	  sout << std::endl
-	       << "SLGridSph found " << totbad
-	       << " tolerance errors in computing SL solutions." << std::endl
-	       << "We suggest checking your model file for smoothness and for"
-	       << std::endl
-	       << "a sufficient number grid points that the relative difference"
-	       << std::endl
-	       << "between field quantities is <= 0.3";
-	} else {
-	  sout << std::endl << "sledge tolerance failure";
-	}
+  if (not found and store) {
+    from_store = true;
+    found = agree(BasisCache::read(cacheKey(), sph_cache_name,
+				   [this]() { return ReadH5Cache(); }));
+    from_store = false;
+  }
 
-	throw GenericError(sout.str(), __FILE__, __LINE__);
-      }
-#endif
-    }
-    // END MPI stanza, BEGIN single-process stanza
-    else {
+  if (found) tableStore->sync();
+  else {
 
-      table = table_ptr_1D(new TableSph [lmax+1]);
+    if (mpi) mpi_setup();
 
-      for (l=0; l<=lmax; l++) {
-	if (tbdbg) std::cerr << "Begin [" << l << "] . . ." << std::endl;
-	compute_table(&(table[l]), l);
-	if (tbdbg) std::cerr << ". . . done" << std::endl;
+    // Each harmonic is an independent SL problem
+    //
+    std::string error;
+    int totbad = SLbuildTables
+      ("SLGridSph", lmax+1, mpi, progress, mpi_buf.get(), mpi_bufsz,
+       [this](int l) { compute_table(&table[l], l); },
+       [this](int l) { return mpi_pack_table(&table[l], l); },
+       [this]()      { mpi_unpack_table(); },
+       error, tableStore.get());
+
+    // Emit runtime exception on sledge errors
+    //
+    if (totbad) {
+      std::ostringstream sout;
+      if (error.size()) sout << error;
+      else {
+	sout << std::endl
+	     << "SLGridSph found tolerance errors in " << totbad
+	     << " of " << lmax+1 << " SL tables." << std::endl
+	     << "We suggest checking your model file for smoothness and for"
+	     << std::endl
+	     << "a sufficient number grid points that the relative difference"
+	     << std::endl
+	     << "between field quantities is <= 0.3";
       }
+      throw GenericError(sout.str(), __FILE__, __LINE__);
     }
-    // END single process stanza
 
     // Write cache
     //
-    if (myid==0 and cache) WriteH5Cache();
+    if (myid==0 and cache) {
+      if (store)
+	BasisCache::write(cacheKey(), sph_cache_name,
+			  [this]() { WriteH5Cache(); });
+      else
+	WriteH5Cache();
+    }
   }
   // END: make tables
 
+  make_batch_tables();
+
   if (tbdbg)
     std::cerr << "Process " << myid << ": exiting constructor" << std::endl;
   
@@ -554,7 +564,8 @@ bool SLGridSph::ReadH5Cache(void)
 
     // Parameter check
     //
-    if (not checkStr(modl,     "model"))     return false;
+    if (not from_store and
+	not checkStr(modl,     "model"))     return false;
     if (not checkInt(lmax,     "lmax"))      return false;
     if (not checkInt(nmax,     "nmax"))      return false;
     if (not checkInt(numr,     "numr"))      return false;
@@ -576,19 +587,23 @@ bool SLGridSph::ReadH5Cache(void)
     //
     auto harmonic = h5file.getGroup("Harmonic");
 
-    // Create table instances
+    // Only the node leader fills a shared table
     //
-    table = table_ptr_1D(new TableSph [lmax+1]);
+    bool fill = not tableStore->shared() or NodeShared::nodeRank()==0;
 
-    for (int l=0; l<=lmax; l++) {
+    for (int l=0; fill and l<=lmax; l++) {
       std::ostringstream sout;
       sout << l;
       auto arrays = harmonic.getGroup(sout.str());
       
-      // Table arrays will be allocated
-      //
-      arrays.getDataSet("ev").read<Eigen::VectorXd>(table[l].ev);
-      arrays.getDataSet("ef").read<Eigen::MatrixXd>(table[l].ef);
+      auto ev = arrays.getDataSet("ev").read<Eigen::VectorXd>();
+      auto ef = arrays.getDataSet("ef").read<Eigen::MatrixXd>();
+
+      if (ev.size() != nmax or ef.rows() != nmax or ef.cols() != numr)
+	return false;
+
+      table[l].ev = ev;
+      table[l].ef = ef;
     }
     
     if (myid==0)
@@ -611,6 +626,41 @@ bool SLGridSph::ReadH5Cache(void)
 
 
 
+BasisCache::Key SLGridSph::cacheKey()
+{
+  // sledge evaluates the model between the grid nodes, so the model
+  // enters through its full table and interpolation settings as well
+  // as its potential and density on the grid
+  //
+  BasisCache::Key key("SLGridSph", Version);
+  key.add("lmax",     lmax)
+     .add("nmax",     nmax)
+     .add("numr",     numr)
+     .add("cmap",     cmap)
+     .add("rmin",     rmin)
+     .add("rmax",     rmax)
+     .add("rmapping", rmap)
+     .add("diverge",  diverge)
+     .add("dfac",     dfac)
+     .add("p0",       p0)
+     .add("d0",       d0);
+
+  if (auto tbl = std::dynamic_pointer_cast<SphericalModelTable>(model)) {
+    key.add("model_r", tbl->density_table().x)
+       .add("model_d", tbl->density_table().y)
+       .add("model_m", tbl->mass_table().y)
+       .add("model_p", tbl->pot_table().y)
+       .add("linear",  SphericalModelTable::linear)
+       .add("even",    SphericalModelTable::even)
+       .add("chebyN",  SphericalModelTable::chebyN);
+  } else {
+    key.add("model", model_file_name);
+  }
+
+  return key;
+}
+
+
 void SLGridSph::WriteH5Cache(void)
 {
   if (myid) return;
@@ -674,8 +724,8 @@ void SLGridSph::WriteH5Cache(void)
       sout << l;
       auto arrays = harmonic.createGroup(sout.str());
       
-      arrays.createDataSet("ev",   table[l].ev);
-      arrays.createDataSet("ef",   table[l].ef);
+      arrays.createDataSet("ev",   Eigen::VectorXd(table[l].ev));
+      arrays.createDataSet("ef",   Eigen::MatrixXd(table[l].ef));
     }
     
   } catch (HighFive::Exception& err) {
@@ -977,6 +1027,151 @@ void SLGridSph::get_force(Eigen::MatrixXd& mat, double x, int which)
 }
 
 
+void SLGridSph::make_batch_tables()
+{
+  const int    L1 = lmax + 1;
+  const size_t LN = static_cast<size_t>(L1)*nmax;
+
+  batchStore = std::make_shared<NodeShared>(3*LN*numr, tableStore->shared());
+  batchStore->report("SLGridSph batch tables");
+
+  potB   = batchStore->data();
+  densB  = potB  + LN*numr;
+  forceB = densB + LN*numr;
+
+  // Only the node leader fills shared tables
+  //
+  bool fill = not batchStore->shared() or NodeShared::nodeRank()==0;
+
+  for (int i=0; fill and i<numr; i++) {
+    double *pp = &potB[LN*i], *dd = &densB[LN*i], *ff = &forceB[LN*i];
+
+    for (int l=0; l<=lmax; l++) {
+      for (int n=0; n<nmax; n++) {
+	double ef  = table[l].ef(n, i);
+	double sev = sqrt(table[l].ev[n]);
+	int k = l + n*L1;
+	pp[k] = ef/sev;
+	dd[k] = ef*sev;
+	ff[k] = ef*p0[i]/sev;
+      }
+    }
+  }
+
+  batchStore->sync();
+}
+
+
+double SLGridSph::batch_xi(double x, int which)
+{
+  if (which || !cmap)
+    x = r_to_xi(x);
+  else {
+    if (cmap==1) {
+      if (x<-1.0) x=-1.0;
+      if (x>=1.0) x=1.0-XOFFSET;
+    }
+    if (cmap==2) {
+      if (x<xmin) x=xmin;
+      if (x>xmax) x=xmax;
+    }
+  }
+
+  return x;
+}
+
+
+void SLGridSph::get_pot(std::vector<Eigen::MatrixXd>& tab, const double* x,
+			int N, int which)
+{
+  const int LN = (lmax+1)*nmax;
+
+  if (tab.size() < static_cast<size_t>(N)) tab.resize(N);
+
+  for (int k=0; k<N; k++) {
+    double xx = batch_xi(x[k], which);
+
+    int indx = (int)( (xx-xmin)/dxi );
+    if (indx<0) indx = 0;
+    if (indx>numr-2) indx = numr - 2;
+
+    double x1 = (xi[indx+1] - xx)/dxi;
+    double x2 = (xx - xi[indx])/dxi;
+    double pf = x1*p0[indx] + x2*p0[indx+1];
+    double w1 = x1*pf, w2 = x2*pf;
+
+    tab[k].resize(lmax+1, nmax);
+
+    const double *a = &potB[static_cast<size_t>(LN)*indx], *b = a + LN;
+    double *t = tab[k].data();
+#pragma omp simd
+    for (int j=0; j<LN; j++) t[j] = w1*a[j] + w2*b[j];
+  }
+}
+
+
+void SLGridSph::get_dens(std::vector<Eigen::MatrixXd>& tab, const double* x,
+			 int N, int which)
+{
+  const int LN = (lmax+1)*nmax;
+
+  if (tab.size() < static_cast<size_t>(N)) tab.resize(N);
+
+  for (int k=0; k<N; k++) {
+    double xx = batch_xi(x[k], which);
+
+    int indx = (int)( (xx-xmin)/dxi );
+    if (indx<0) indx = 0;
+    if (indx>numr-2) indx = numr - 2;
+
+    double x1 = (xi[indx+1] - xx)/dxi;
+    double x2 = (xx - xi[indx])/dxi;
+    double df = x1*d0[indx] + x2*d0[indx+1];
+    double w1 = x1*df, w2 = x2*df;
+
+    tab[k].resize(lmax+1, nmax);
+
+    const double *a = &densB[static_cast<size_t>(LN)*indx], *b = a + LN;
+    double *t = tab[k].data();
+#pragma omp simd
+    for (int j=0; j<LN; j++) t[j] = w1*a[j] + w2*b[j];
+  }
+}
+
+
+void SLGridSph::get_force(std::vector<Eigen::MatrixXd>& tab, const double* x,
+			  int N, int which)
+{
+  const int LN = (lmax+1)*nmax;
+
+  if (tab.size() < static_cast<size_t>(N)) tab.resize(N);
+
+  for (int k=0; k<N; k++) {
+    double xx = batch_xi(x[k], which);
+
+    int indx = (int)( (xx-xmin)/dxi );
+    if (indx<1) indx = 1;
+    if (indx>numr-2) indx = numr - 2;
+
+    double p   = (xx - xi[indx])/dxi;
+    double fac = d_xi_to_r(xx)/dxi;
+
+				// Three point formula weights
+    double w0 =  fac*(p - 0.5);
+    double w1 = -fac*2.0*p;
+    double w2 =  fac*(p + 0.5);
+
+    tab[k].resize(lmax+1, nmax);
+
+    const double *a = &forceB[static_cast<size_t>(LN)*(indx-1)];
+    const double *b = a + LN, *c = b + LN;
+    double *t = tab[k].data();
+#pragma omp simd
+    for (int j=0; j<LN; j++) t[j] = w0*a[j] + w1*b[j] + w2*c[j];
+  }
+}
+
+
 void SLGridSph::get_pot(Eigen::VectorXd& vec, double x, int l, int which)
 {
   if (which || !cmap)
@@ -1181,50 +1376,44 @@ void SLGridSph::compute_table(struct TableSph* table, int l)
 
   std::ostringstream sout;
 
-  // Print info if we have errors and throw a runtime error
+  // Format the solver report into the exception message rather than
+  // std::cout: tables are computed concurrently by OpenMP threads
   if (bad>0) {
 
-    if (myid==0) {
+    sout.precision(6);
+    sout.setf(ios::scientific);
+    sout << std::left;
 
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-      std::cout << std::left;
-    
-      std::cout << std::endl
-		<< "Tolerance errors in Sturm-Liouville solver for l=" << l
-		<<  std::endl << std::endl;
-
-      std::cout << std::setw(15) << "order"
-		<< std::setw(15) << "eigenvalue"
-		<< std::setw(40) << "condition"
-		<< std::endl
-		<< std::setw(15) << "-----"
-		<< std::setw(15) << "----------"
-		<< std::setw(40) << "---------"
-		<< std::endl;
-      
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw(40) << sledge_error(iflag[i])
-		  << std::endl;
-      }
-      std::cout << std::endl;
-      
-      sout << std::endl
-	   << "SLGridSph found " << bad
-	   << " tolerance errors in computing SL solutions." << std::endl
-	   << "We suggest checking your model file for smoothness and ensure"
-	   << std::endl
-	   << "a sufficient number grid points that the relative difference"
-	   << std::endl
-	   << "between field quantities is <= 0.3";
+    sout << std::endl
+	 << "Tolerance errors in Sturm-Liouville solver for l=" << l
+	 << std::endl << std::endl;
 
-      throw GenericError(sout.str(), __FILE__, __LINE__);
-    }
-    else {
-      throw GenericError("sledge errors", __FILE__, __LINE__);
+    sout << std::setw(15) << "order"
+	 << std::setw(15) << "eigenvalue"
+	 << std::setw(40) << "condition"
+	 << std::endl
+	 << std::setw(15) << "-----"
+	 << std::setw(15) << "----------"
+	 << std::setw(40) << "---------"
+	 << std::endl;
+
+    for (int i=0; i<N; i++) {
+      sout << std::setw(15) << invec[3+i]
+	   << std::setw(15) << ev[i]
+	   << std::setw(40) << sledge_error(iflag[i])
+	   << std::endl;
     }
+
+    sout << std::endl
+	 << "SLGridSph found " << bad
+	 << " tolerance errors in computing SL solutions." << std::endl
+	 << "We suggest checking your model file for smoothness and ensure"
+	 << std::endl
+	 << "a sufficient number grid points that the relative difference"
+	 << std::endl
+	 << "between field quantities is <= 0.3";
+
+    throw GenericError(sout.str(), __FILE__, __LINE__);
   }
 #endif
 
@@ -1232,43 +1421,43 @@ void SLGridSph::compute_table(struct TableSph* table, int l)
   //     Print results:
   //
   if (tbdbg) {
-    std::cout.precision(6);
-    std::cout.setf(ios::scientific);
+    std::ostringstream dout;
+    dout.precision(6);
+    dout.setf(ios::scientific);
 
     for (int i=0; i<N; i++) {
-      std::cout << std::setw(15) << invec[3+i] 
-		<< std::setw(15) << ev[i]
-		<< std::setw( 5) << iflag[i]
-		<< std::endl;
+      dout << std::setw(15) << invec[3+i] 
+	   << std::setw(15) << ev[i]
+	   << std::setw( 5) << iflag[i]
+	   << std::endl;
       
       if (VERBOSE) {
 	
 	if (iflag[i] > -10) {
-	  std::cout << std::setw(14) << "x"
-		    << std::setw(25) << "u(x)"
-		    << std::setw(25) << "(pu`)(x)"
-		    << std::endl;
+	  dout << std::setw(14) << "x"
+	       << std::setw(25) << "u(x)"
+	       << std::setw(25) << "(pu`)(x)"
+	       << std::endl;
 	  int k = NUM*i;
 	  for (int j=0; j<NUM; j++) {
-	    std::cout << std::setw(25) << xef[j]
-		      << std::setw(25) << ef[j+k]
-		      << std::setw(25) << pdef[j+k]
-		      << std::endl;
+	    dout << std::setw(25) << xef[j]
+		 << std::setw(25) << ef[j+k]
+		 << std::setw(25) << pdef[j+k]
+		 << std::endl;
 	  }
 	}
 	
       }
 
     }
+
+    std::cout << dout.str();
   }
   
 				// Load table
 
-  table->ev.resize(N);
   for (int i=0; i<N; i++) table->ev[i] = ev[i];
 
-  table->ef.resize(N, numr);
-
   // Choose sign conventions for the ef table
   //
   int nfid = std::min<int>(nevsign, NUM) - 1;
@@ -1313,239 +1502,14 @@ void SLGridSph::init_table(void)
     xmin = rmin;
     xmax = rmax;
   }
-  dxi = (xmax-xmin)/(numr-1);
-    
-  for (int i=0; i<numr; i++) {
-    xi[i] = xmin + dxi*i;
-    r[i]  = xi_to_r(xi[i]);
-    p0[i] = sphpot(r[i]);
-    d0[i] = sphdens(r[i]);
-  }
-
-}
-
-
-void SLGridSph::compute_table_worker(void)
-{
-
-  double cons[8] = {0.0, 0.0, 0.0, 0.0,   0.0, 0.0,   0.0, 0.0};
-  double tol [6] = {1.0e-1*rmap, 1.0e-6,  
-                    1.0e-1*rmap, 1.0e-6,  
-		    1.0e-1*rmap, 1.0e-6};
-
-  int VERBOSE=0;
-  integer NUM;
-  logical type[8] = {0, 0, 1, 0, 0, 0, 1, 0};
-  logical endfin[2] = {1, 1};
-  
-  struct TableSph table;
-  int L, N;
-
-#ifdef DEBUG_SLEDGE
-  if (myid==0) VERBOSE = SLEDGE_VERBOSE;
-#endif
-
-#ifdef DEBUG
-  std::cout << "Worker " << mpi_myid << " begins . . ." << std::endl;
-#endif
-
-  //
-  // <Wait for orders>
-  //
-  
-  int request_id;
-
-  while(1) {
-
-    MPI_Recv(&request_id, 1, 
-	     MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-    if (request_id < 0) break;	// Good-bye
-
-    MPI_Recv(&L, 1, 
-	     MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-
-    if (tbdbg)
-      std::cout << "Worker " <<  mpi_myid << ": ordered to compute l = " << L << "" << std::endl;
-
-    cons[0] = cons[1] = cons[2] = cons[3] = cons[4] = cons[5] = 0.0;
-    cons[6] = rmin;
-    cons[7] = rmax;
-    L2 = L*(L+1);
-    NUM = numr;
-    N = nmax;
-
-    // integer iflag[nmax], invec[nmax+3];
-    integer *iflag = new integer [nmax];
-    integer *invec = new integer [nmax+3];
-
-    double *t=0, *rho=0;
-    double *ev    = new double [N];
-    double *store = new double [26*(NUM+16)];
-    double *xef   = new double [NUM+16];
-    double *ef    = new double [NUM*N];
-    double *pdef  = new double [NUM*N];
-    double f;
-
-    f = sphpot(cons[6]);
-    cons[2] = -1.0/(cons[6]*cons[6]*f*f);
-    cons[4] = L/cons[7];
-    f = sphpot(cons[7]);
-    cons[5] = 1.0/(cons[7]*cons[7]*f*f);
-
-    //
-    //     Initialize the vector INVEC(*):
-    //       estimates for the eigenvalues/functions specified
-    //
-
-    invec[0] = VERBOSE;		// little printing (1), no printing (0)
-    invec[1] = 3;		// spectrum is ignored
-    invec[2] = N;		// estimates for N eigenvalues/functions
-
-    for (int i=0; i<N; i++) invec[3+i] = i;
-
-    //
-    //     Set the JOB(*) vector:
-    //        estimate both eigenvalues and eigenvectors,
-    //        don't estimate the spectral density function,
-    //        classify,
-    //        let SLEDGE choose the initial mesh
-    //
-    logical job[5] = {0,1,0,1,0};
-
-    //
-    //     Output mesh
-    //
-    for (int i=0; i<NUM; i++) xef[i] = r[i];
-
-    //     
-    //     Open file for output.
-    //
-    sl_dim = 3;
-
-    sledge_(job, cons, endfin, invec, tol, type, ev, &NUM, xef, ef, pdef,
-	    t, rho, iflag, store);
-
-    //
-    //     Check for errors
-    //
-#ifdef SLEDGE_THROW
-    // Get sledge error count
-    unsigned bad = 0;
-    for (int i=0; i<N; i++) {
-      if (iflag[i] != 0) bad++;
-    }
-    
-    std::ostringstream sout;
-
-    // Print info if we have errors.  Number of errors will be sent to
-    // and accumulated by the root node.
-    if (bad>0) {
-
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-      std::cout << std::left;
-    
-      std::cout << std::endl
-		<< "Tolerance errors in Sturm-Liouville solver for l=" << L
-		<<  std::endl << std::endl;
-
-      std::cout << std::setw(15) << "order"
-		<< std::setw(15) << "eigenvalue"
-		<< std::setw(40) << "condition"
-		<< std::endl
-		<< std::setw(15) << "-----"
-		<< std::setw(15) << "----------"
-		<< std::setw(40) << "---------"
-		<< std::endl;
-      
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw(40) << sledge_error(iflag[i])
-		  << std::endl;
-      }
-      std::cout << std::endl;
-      
-    }
-#endif
-
-    //
-    //     Print results:
-    //
-    if (tbdbg) {
-      std::cout << "Worker " <<  mpi_myid << ": computed l = " << L << "" << std::endl;
-
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw( 5) << iflag[i]
-		  << std::endl;
-	
-	if (VERBOSE) {
-
-	  if (iflag[i] > -10) {
-	    std::cout << std::setw(14) << "x"
-		      << std::setw(25) << "u(x)"
-		      << std::setw(25) << "(pu`)(x)"
-		      << std::endl;
-	    int k = NUM*i;
-	    for (int j=0; j<NUM; j++) {
-	      std::cout << std::setw(25) << xef[j]
-			<< std::setw(25) << ef[j+k]
-			<< std::setw(25) << pdef[j+k]
-			<< std::endl;
-	    }
-	  }
-	}
-      }
-    }
-
-    // Load table
-    //
-    table.ev.resize(N);
-    for (int i=0; i<N; i++) table.ev[i] = ev[i];
-
-    // Choose sign conventions for the ef table
-    //
-    int nfid = std::min<int>(nevsign, NUM) - 1;
-    Eigen::VectorXi sgn = Eigen::VectorXi::Ones(N);
-    for (int j=0; j<N; j++) {
-      if (ef[j*NUM+nfid]<0.0) sgn(j) = -1;
-    }
-
-    table.ef.resize(N, numr);
-    for (int i=0; i<numr; i++) {
-      for (int j=0; j<N; j++) 
-	table.ef(j, i) = ef[j*NUM+i] * sgn(j);
-    }
-
-    table.l = L;
-  
-#ifdef SLEDGE_THROW
-    // Send sledge error count to root
-    MPI_Send(&bad, 1, MPI_INT, 0, 10, MPI_COMM_WORLD);
-#endif
-    // Send sledge comptuation to root
-    int position = mpi_pack_table(&table, L);
-    MPI_Send(&mpi_buf[0], position, MPI_PACKED, 0, 11, MPI_COMM_WORLD);
-
-    if (tbdbg)
-      std::cout << "Worker " <<  mpi_myid << ": send to root l = " << L << "" << std::endl;
-
-    delete [] iflag;
-    delete [] invec;
-    delete [] ev;
-    delete [] store;
-    delete [] xef;
-    delete [] ef;
-    delete [] pdef;
-
-  }
+  dxi = (xmax-xmin)/(numr-1);
+    
+  for (int i=0; i<numr; i++) {
+    xi[i] = xmin + dxi*i;
+    r[i]  = xi_to_r(xi[i]);
+    p0[i] = sphpot(r[i]);
+    d0[i] = sphdens(r[i]);
+  }
 
 }
 
@@ -1613,8 +1577,6 @@ void SLGridSph::mpi_unpack_table(void)
 
 
   table[l].l = l;
-  table[l].ev.resize(nmax);
-  table[l].ef.resize(nmax, numr);
 
   for (int j=0; j<nmax; j++)
     MPI_Unpack( &mpi_buf[0], length, &position, &table[l].ev[j], 1, MPI_DOUBLE,
@@ -1750,13 +1712,14 @@ std::vector<Eigen::MatrixXd> SLGridSph::orthoCheck(int num)
 
 
 int    SLGridSlab::mpi   = 0;	// initially off
+bool   SLGridSlab::progress = false; // no build report
 int    SLGridSlab::cache = 1;	// initially yes
 double SLGridSlab::H     = 0.1;	// Scale height
 double SLGridSlab::L     = 1.0;	// Periodic box size
 double SLGridSlab::ZBEG  = 0.0;	// Offset on from origin
 double SLGridSlab::ZEND  = 0.0;	// Offset on potential zero
 
-static double KKZ;
+static thread_local double KKZ;
 
 static double poffset=0.0;
 
@@ -1911,201 +1874,72 @@ SLGridSlab::SLGridSlab(int NUMK, int NMAX, int NUMZ, double ZMAX,
   for (kx=0; kx<=numk; kx++)
     table[kx] = table_ptr_1D(new TableSlab [kx+1]);
 
-  if (mpi) {
+  if (mpi) mpi_setup();
 
-    mpi_setup();
-
-    int totbad = 0;		// Accumulate total sledge error count
-
-    if (mpi_myid) {
+  // The root reads the cache and shares it
+  //
+  bool store = cache and BasisCache::enabled();
 
-      compute_table_worker();
+  int cached = 0;
+  if (not mpi or myid==0) {
+    cached = ReadH5Cache();
+    if (not cached and store)
+      cached = BasisCache::read(cacheKey(), slab_cache_name,
+				[this]() { return ReadH5Cache(); });
+  }
+  if (mpi) MPI_Bcast(&cached, 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-      //
-      // <Receive completed table from root>
-      //
+  // Each wave number pair is an independent SL problem
+  //
+  std::vector<std::pair<int, int>> kxy;
+  for (kx=0; kx<=numk; kx++) {
+    for (ky=0; ky<=kx; ky++) kxy.push_back({kx, ky});
+  }
 
-      for (kx=0; kx<=numk; kx++) {
-	for (ky=0; ky<=kx; ky++) {
-	  MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, 0,
-		   MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-    
-	  mpi_unpack_table();      
-	}
+  if (cached) {
+    if (mpi) {
+      for (auto v : kxy) {
+	if (myid==0) mpi_pack_table(&table[v.first][v.second], v.first, v.second);
+	MPI_Bcast(&mpi_buf[0], mpi_bufsz, MPI_PACKED, 0, MPI_COMM_WORLD);
+	if (myid) mpi_unpack_table();
       }
-      
     }
-    else {			// BEGIN Root
-
-      int worker = 0;
-      int request_id = 1;
-
-      if (!ReadH5Cache()) {
-
-	kx = 0;
-	ky = 0;
-
-	while (kx<=numk) {
-
-	  if (worker<mpi_numprocs-1) { // Send request to worker
-	    worker++;
-      
-	    if (tbdbg)
-	      std::cout << "Root sending orders to Worker " << worker 
-			<< ": Kx=" << kx << ", Ky=" << ky << std::endl;
-
-	    MPI_Send(&request_id, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-	    MPI_Send(&kx, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-	    MPI_Send(&ky, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-      
-	    if (tbdbg)
-	      std::cout << "Root gave orders to Worker " << worker 
-			<< ": Kx=" << kx << ", Ky=" << ky << std::endl;
-
-				// Increment counters
-	    ky++;
-	    if (ky>kx) {
-	      kx++;
-	      ky = 0;
-	    }
-	    
-	  }
-
-	  if (worker == mpi_numprocs-1 && kx<=numk) {
-	  
-	    //
-	    // <Wait and receive>
-	    //
-#ifdef SLEDGE_THROW
-	    int bad;		// Get sledge error count
-	    MPI_Recv(&bad, 1, MPI_INT, MPI_ANY_TAG, 10,
-		     MPI_COMM_WORLD, &status);
-	    totbad += bad;
-				// Get sledge computation result
-	    int retid = status.MPI_SOURCE;
-	    MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, retid, 11,
-		     MPI_COMM_WORLD, &status);
-#else
-	    MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, MPI_ANY_SOURCE, 
-		     MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-	    
-	    int retid = status.MPI_SOURCE;
-#endif
-
-	    mpi_unpack_table();      
-
-	    //
-	    // <Send new request>
-	    //
-
-	    MPI_Send(&request_id, 1, MPI_INT, retid, 11, MPI_COMM_WORLD);
-	    MPI_Send(&kx, 1, MPI_INT, retid, 11, MPI_COMM_WORLD);
-	    MPI_Send(&ky, 1, MPI_INT, retid, 11, MPI_COMM_WORLD);
-      
-	    if (tbdbg)
-	      std::cout << "Root gave orders to Worker " << retid 
-			<< ": Kx=" << kx << ", Ky=" << ky << std::endl;
-
-				// Increment counters
-	    ky++;
-	    if (ky>kx) {
-	      kx++;
-	      ky = 0;
-	    }
-
-	  }
-	}
-      
-	//
-	// <Wait for all workers to return>
-	//
-  
-	while (worker) {
-	
-#ifdef SLEDGE_THROW
-	  // Get sledge error count
-	  int bad;
-	  MPI_Recv(&bad, 1, MPI_INT, MPI_ANY_SOURCE, 10, MPI_COMM_WORLD,
-		   &status);
-	  totbad += bad;
-	  // Get sledge computation result
-	  int retid = status.MPI_SOURCE;
-	  MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, retid, 11,
-		   MPI_COMM_WORLD, &status);
-#else
-	  MPI_Recv(&mpi_buf[0], mpi_bufsz, MPI_PACKED, MPI_ANY_SOURCE, 11,
-		   MPI_COMM_WORLD, &status);
-#endif
-	  mpi_unpack_table();      
-
-	  worker--;
-	}
-
-	if (cache) WriteH5Cache();
-
-      }
-
-      //
-      // <Tell workers to continue>
-      //
-
-      request_id = -1;
-      for (worker=1; worker < mpi_numprocs; worker++)
-	MPI_Send(&request_id, 1, MPI_INT, worker, 11, MPI_COMM_WORLD);
-
-
-      //
-      // <Send table to workers>
-      //
-
-      for (kx=0; kx<=numk; kx++) {
-	for (ky=0; ky<=kx; ky++) {
-	  int position = mpi_pack_table(&table[kx][ky], kx, ky);
-	  for (worker=1; worker < mpi_numprocs; worker++)
-	    MPI_Send(&mpi_buf[0], position, MPI_PACKED, worker, 11, MPI_COMM_WORLD);
-	}
-      }
-
-
-    } // END Root
-
-#ifdef SLEDGE_THROW
-    // Share total sledge error count with all nodes
-    MPI_Bcast(&totbad, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  } else {
 
-    // Throw runtime error if sledge comtputation has errors
+    std::string error;
+    int totbad = SLbuildTables
+      ("SLGridSlab", kxy.size(), mpi, progress, mpi_buf.get(), mpi_bufsz,
+       [&](int i) {
+	 compute_table(&table[kxy[i].first][kxy[i].second],
+		       kxy[i].first, kxy[i].second); },
+       [&](int i) {
+	 return mpi_pack_table(&table[kxy[i].first][kxy[i].second],
+			       kxy[i].first, kxy[i].second); },
+       [this]() { mpi_unpack_table(); },
+       error);
+
+    // Throw runtime error if sledge computation has errors
+    //
     if (totbad) {
       std::ostringstream sout;
-      
-      if (myid==0) {
-	sout << std::endl << "SLGridSlab found " << totbad
-	     << " tolerance errors in computing SL solutions." << std::endl
+      if (error.size()) sout << error;
+      else {
+	sout << std::endl << "SLGridSlab found tolerance errors in " << totbad
+	     << " of " << kxy.size() << " SL tables." << std::endl
 	     << "We suggest checking your model parameters to ensure a"
 	     << std::endl
 	     << "sufficient number of grid points that the relative difference"
 	     << std::endl << "between field quantities is <= 0.3";
-      } else {
-	sout << std::endl << "sledge tolerance failure";
       }
-
       throw GenericError(sout.str(), __FILE__, __LINE__);
     }
-#endif
-  }
-  else {
-
-    if (!ReadH5Cache()) {
-
-      for (kx=0; kx<=numk; kx++) {
-	for (ky=0; ky<=kx; ky++) {
-	  if (tbdbg) std::cerr << "Begin [" << kx << ", " << ky << "] . . ."
-			       << std::endl;
-	  compute_table(&(table[kx][ky]), kx, ky);
-	  if (tbdbg) std::cerr << ". . . done" << std::endl;
-	}
-      }
 
-      if (cache) WriteH5Cache();
+    if (cache and myid==0) {
+      if (store)
+	BasisCache::write(cacheKey(), slab_cache_name,
+			  [this]() { WriteH5Cache(); });
+      else
+	WriteH5Cache();
     }
   }
 
@@ -2114,7 +1948,25 @@ SLGridSlab::SLGridSlab(int NUMK, int NMAX, int NUMZ, double ZMAX,
 }
 
 
-const string slab_cache_name = ".slgrid_slab_cache";
+BasisCache::Key SLGridSlab::cacheKey()
+{
+  // The slab models are analytic, so the model type identifies the
+  // functions sledge evaluates between the grid nodes
+  //
+  BasisCache::Key key("SLGridSlab", "1.0");
+  key.add("type", type)
+     .add("numk", numk)
+     .add("nmax", nmax)
+     .add("numz", numz)
+     .add("H",    H)
+     .add("L",    L)
+     .add("zmax", zmax)
+     .add("ZBEG", ZBEG)
+     .add("ZEND", ZEND)
+     .add("p0",   p0)
+     .add("d0",   d0);
+  return key;
+}
 
 
 bool SLGridSlab::ReadH5Cache(void)
@@ -2763,49 +2615,44 @@ void SLGridSlab::compute_table(struct TableSlab* table, int KX, int KY)
 
   std::ostringstream sout;	// Runtime error message
 
-  // Print info if we have sledge errors and throw a runtime
-  // exception
+  // Format the solver report into the exception message rather than
+  // std::cout: tables are computed concurrently by OpenMP threads
   if (bad>0) {
 
-    if (myid==0) {
+    sout.precision(6);
+    sout.setf(ios::scientific);
+    sout << std::left;
 
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-      std::cout << std::left;
-      
-      std::cout << std::endl
-		<< "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
-		<< " Ky=" << KY << ", even" <<  std::endl << std::endl;
-
-      std::cout << std::setw(15) << "order"
-		<< std::setw(15) << "eigenvalue"
-		<< std::setw(40) << "condition"
-		<< std::endl
-		<< std::setw(15) << "-----"
-		<< std::setw(15) << "----------"
-		<< std::setw(40) << "---------"
-		<< std::endl;
-      
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw(40) << sledge_error(iflag[i])
-		  << std::endl;
-      }
-      std::cout << std::endl;
-      
-      sout << std::endl
-	   << "SLGridSlab found " << bad
-	   << " tolerance errors in computing SL solutions." << std::endl
-	   << "We suggest checking your model parameters to ensure a"
-	   << std::endl
-	   << "sufficient number of grid points that the relative difference"
-	   << std::endl << "between field quantities is <= 0.3";
+    sout << std::endl
+	 << "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
+	 << " Ky=" << KY << ", even"
+	 << std::endl << std::endl;
 
-      throw GenericError(sout.str(), __FILE__, __LINE__);
-    } else {
-      throw GenericError("sledge errors", __FILE__, __LINE__);
+    sout << std::setw(15) << "order"
+	 << std::setw(15) << "eigenvalue"
+	 << std::setw(40) << "condition"
+	 << std::endl
+	 << std::setw(15) << "-----"
+	 << std::setw(15) << "----------"
+	 << std::setw(40) << "---------"
+	 << std::endl;
+
+    for (int i=0; i<N; i++) {
+      sout << std::setw(15) << invec[3+i]
+	   << std::setw(15) << ev[i]
+	   << std::setw(40) << sledge_error(iflag[i])
+	   << std::endl;
     }
+
+    sout << std::endl
+	 << "SLGridSlab found " << bad
+	 << " tolerance errors in computing SL solutions." << std::endl
+	 << "We suggest checking your model parameters to ensure a"
+	 << std::endl
+	 << "sufficient number of grid points that the relative difference"
+	 << std::endl << "between field quantities is <= 0.3";
+
+    throw GenericError(sout.str(), __FILE__, __LINE__);
   }
 #endif
 
@@ -2814,35 +2661,38 @@ void SLGridSlab::compute_table(struct TableSlab* table, int KX, int KY)
   //
   if (tbdbg) {
 
-    std::cout.precision(6);
-    std::cout.setf(ios::scientific);
+    std::ostringstream dout;
+    dout.precision(6);
+    dout.setf(ios::scientific);
 
-    std::cout << "Even:" << std::endl;
+    dout << "Even:" << std::endl;
     for (int i=0; i<N; i++) {
-      std::cout << std::setw(15) << invec[3+i] 
-		<< std::setw(15) << ev[i]
-		<< std::setw( 5) << iflag[i]
-		<< std::endl;
+      dout << std::setw(15) << invec[3+i] 
+	   << std::setw(15) << ev[i]
+	   << std::setw( 5) << iflag[i]
+	   << std::endl;
   
       if (VERBOSE) {
 
 	if (iflag[i] > -10) {
-	  cout << std::setw(14) << "x"
+	  dout << std::setw(14) << "x"
 	       << std::setw(25) << "u(x)"
 	       << std::setw(25) << "(pu`)(x)"
 	       << std::endl;
 	  int k = NUM*i;
 	  for (int j=0; j<NUM; j++) {
-	    std::cout << std::setw(25) << xef[j]
-		      << std::setw(25) << ef[j+k]
-		      << std::setw(25) << pdef[j+k]
-		      << std::endl;
+	    dout << std::setw(25) << xef[j]
+		 << std::setw(25) << ef[j+k]
+		 << std::setw(25) << pdef[j+k]
+		 << std::endl;
 	  }
 	}
 	
       }
 
     }
+
+    std::cout << dout.str();
   }
 
 
@@ -2890,47 +2740,44 @@ void SLGridSlab::compute_table(struct TableSlab* table, int KX, int KY)
 
   sout.str("");
 
-  // Print info if we have errors and throw a runtime exception
+  // Format the solver report into the exception message rather than
+  // std::cout: tables are computed concurrently by OpenMP threads
   if (bad>0) {
 
-    if (myid==0) {
+    sout.precision(6);
+    sout.setf(ios::scientific);
+    sout << std::left;
 
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-      std::cout << std::left;
-    
-      std::cout << std::endl
-		<< "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
-		<< " Ky=" << KY << ", odd" <<  std::endl;
-
-      std::cout << std::setw(15) << "order"
-		<< std::setw(15) << "eigenvalue"
-		<< std::setw(40) << "condition"
-		<< std::endl
-		<< std::setw(15) << "-----"
-		<< std::setw(15) << "----------"
-		<< std::setw(40) << "---------"
-		<< std::endl;
-      
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw(40) << sledge_error(iflag[i])
-		  << std::endl;
-      }
-      std::cout << std::endl;
-      
-      sout << std::endl << "SLGridSph found " << bad
-	   << " tolerance errors in computing SL solutions." << std::endl
-	   << "We suggest checking your model parameters to ensure a"
-	   << std::endl
-	   << "sufficient number of grid points that the relative difference"
-	   << std::endl << "between field quantities is <= 0.3";
+    sout << std::endl
+	 << "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
+	 << " Ky=" << KY << ", odd"
+	 << std::endl << std::endl;
 
-      throw GenericError(sout.str(), __FILE__, __LINE__);
-    } else {
-      throw GenericError("sledge errors", __FILE__, __LINE__);
+    sout << std::setw(15) << "order"
+	 << std::setw(15) << "eigenvalue"
+	 << std::setw(40) << "condition"
+	 << std::endl
+	 << std::setw(15) << "-----"
+	 << std::setw(15) << "----------"
+	 << std::setw(40) << "---------"
+	 << std::endl;
+
+    for (int i=0; i<N; i++) {
+      sout << std::setw(15) << invec[3+i]
+	   << std::setw(15) << ev[i]
+	   << std::setw(40) << sledge_error(iflag[i])
+	   << std::endl;
     }
+
+    sout << std::endl
+	 << "SLGridSlab found " << bad
+	 << " tolerance errors in computing SL solutions." << std::endl
+	 << "We suggest checking your model parameters to ensure a"
+	 << std::endl
+	 << "sufficient number of grid points that the relative difference"
+	 << std::endl << "between field quantities is <= 0.3";
+
+    throw GenericError(sout.str(), __FILE__, __LINE__);
   }
 #endif
 
@@ -2939,33 +2786,36 @@ void SLGridSlab::compute_table(struct TableSlab* table, int KX, int KY)
   //
   if (tbdbg) {
   
-    std::cout.precision(6);
-    std::cout.setf(ios::scientific);
+    std::ostringstream dout;
+    dout.precision(6);
+    dout.setf(ios::scientific);
     
-    std::cout << "Odd:" << std::endl;
+    dout << "Odd:" << std::endl;
     for (int i=0; i<N; i++) {
-      std::cout << std::setw(15) << invec[3+i] 
-		<< std::setw(15) << ev[i]
-		<< std::setw( 5) << iflag[i]
-		<< std::endl;
+      dout << std::setw(15) << invec[3+i] 
+	   << std::setw(15) << ev[i]
+	   << std::setw( 5) << iflag[i]
+	   << std::endl;
   
       if (VERBOSE) {
 
 	if (iflag[i] > -10) {
-	  cout << std::setw(14) << "x"
+	  dout << std::setw(14) << "x"
 	       << std::setw(25) << "u(x)"
 	       << std::setw(25) << "(pu`)(x)"
 	       << std::endl;
 	  int k = NUM*i;
 	  for (int j=0; j<NUM; j++) {
-	    std::cout << std::setw(25) << xef[j]
-		      << std::setw(25) << ef[j+k]
-		      << std::setw(25) << pdef[j+k]
-		      << std::endl;
+	    dout << std::setw(25) << xef[j]
+		 << std::setw(25) << ef[j+k]
+		 << std::setw(25) << pdef[j+k]
+		 << std::endl;
 	  }
 	}
       }
     }
+
+    std::cout << dout.str();
   }
 
 				// Load table
@@ -3027,375 +2877,6 @@ void SLGridSlab::init_table(void)
 }
 
 
-void SLGridSlab::compute_table_worker(void)
-{
-  double tol[6]     = {1.0e-6,1.0e-7,  1.0e-6,1.0e-7,  1.0e-6,1.0e-7};
-  logical type[8]   = {1, 0, 0, 0, 1, 0, 0, 0};
-  logical endfin[2] = {1, 1};
-  double cons[8];
-  int VERBOSE=0;
-  integer NUM;
-  
-  struct TableSlab table;
-  int KX, KY, N;
-
-#ifdef DEBUG_SLEDGE
-  if (myid==0) VERBOSE = SLEDGE_VERBOSE;
-#endif
-
-#ifdef DEBUG
-  std::cout << "Worker " << mpi_myid << " begins . . ." << std::endl;
-#endif
-
-  //
-  // <Wait for orders>
-  //
-  
-  int request_id;
-
-  while(1) {
-
-    MPI_Recv(&request_id, 1, 
-	     MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-    if (request_id < 0) break;	// Good-bye
-
-    MPI_Recv(&KX, 1, 
-	     MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-    MPI_Recv(&KY, 1, 
-	     MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-    if (tbdbg)
-      std::cout << "Worker " << mpi_myid << ": ordered to compute Kx, Ky = "
-		<< KX << ", " << KY << "" << std::endl;
-
-    cons[0] = cons[1] = cons[2] = cons[3] = cons[4] = cons[5] = 0.0;
-    cons[6] =  ZBEG;
-    cons[7] =  zmax;
-    NUM = numz;
-				// Divide total functions into symmetric
-				// and antisymmetric (keeping equal number
-				// of each or one more symmetric
-    N = (int)( 0.5*nmax + 0.501);
-
-    integer *iflag = new integer [nmax];
-    integer *invec = new integer [nmax+3];
-
-    double *t=0, *rho=0;
-    double *ev    = new double [N];
-    double *store = new double [26*(NUM+16)];
-    double *xef   = new double [NUM+16];
-    double *ef    = new double [NUM*N];
-    double *pdef  = new double [NUM*N];
-    double f, df;
-
-    KKZ = 2.0*M_PI/L * sqrt((double)(KX*KX + KY*KY));
-
-				// Even BC, inner has zero gradient
-    f = slab->pot(cons[6]);
-    cons[2] = -1.0/(f*f);
-
-    if (tbdbg) {
-      std::cout << "Worker " << mpi_myid << ": Kx, Ky = " 
-		<< KX << ", " << KY << " [Even inputs]" << std::endl;
-      for (int n=0; n<8; n++)
-	std::cout << std::setw(5) << n << std::setw(15) << cons[n] << endl;
-    }
-				// Outer
-    if (KKZ>1.0e-4) {
-      f = slab->pot(cons[7]);
-      df = slab->dpot(cons[7]);
-      cons[4] = (df + KKZ*f)*f;
-    }
-    cons[5] = 1.0;
-
-    //
-    //     Initialize the vector INVEC(*):
-    //       estimates for the eigenvalues/functions specified
-    //
-
-    invec[0] = VERBOSE;		// little printing (1), no printing (0)
-    invec[1] = 3;		// spectrum is ignored
-    invec[2] = N;		// estimates for N eigenvalues/functions
-
-    for (int i=0; i<N; i++) invec[3+i] = i;
-
-    //
-    //     Set the JOB(*) vector:
-    //        estimate both eigenvalues and eigenvectors,
-    //        don't estimate the spectral density function,
-    //        don't classify,
-    //        we choose the initial mesh
-    //
-    logical job[5] = {0,1,0,1,0};
-
-    //
-    //     Output mesh
-    //
-    for (int i=0; i<NUM; i++) xef[i] = z[i];
-
-    //     
-    //     Open file for output.
-    //
-    sl_dim = 1;
-
-    sledge_(job, cons, endfin, invec, tol, type, ev, &NUM, xef, ef, pdef,
-	    t, rho, iflag, store);
-    //
-    //     Print results:
-    //
-    
-    //
-    //     Check for errors
-    //
-#ifdef SLEDGE_THROW
-    unsigned bad = 0;		// Number of non-zero iflag values
-    for (int i=0; i<N; i++) {
-      if (iflag[i] != 0) bad++;
-    }
-    
-    std::ostringstream sout;	// Runtime error message
-
-    // Print info if we have errors.  Number of errors will be sent to
-    // and accumulated by the root node.
-    if (bad>0) {
-
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-      std::cout << std::left;
-    
-      std::cout << std::endl
-		<< "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
-		<< " Ky=" << KY << ", even" <<  std::endl << std::endl;
-
-      std::cout << std::setw(15) << "order"
-		<< std::setw(15) << "eigenvalue"
-		<< std::setw(40) << "condition"
-		<< std::endl
-		<< std::setw(15) << "-----"
-		<< std::setw(15) << "----------"
-		<< std::setw(40) << "---------"
-		<< std::endl;
-
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw(40) << sledge_error(iflag[i])
-		  << std::endl;
-      }
-      std::cout << std::endl;
-    }
-#endif
-
-    if (tbdbg) {
-      std::cout << "Worker " << mpi_myid << ": computed Kx, Ky = " 
-		<< KX << ", " << KY << " [Even]" << std::endl;
-
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw( 5) << iflag[i]
-		  << std::endl;
-  
-	if (VERBOSE) {
-
-	  if (iflag[i] > -10) {
-	    std::cout << std::setw(14) << "x"
-		      << std::setw(25) << "u(x)"
-		      << std::setw(25) << "(pu`)(x)"
-		      << std::endl;
-	    int k = NUM*i;
-	    for (int j=0; j<NUM; j++) {
-	      std::cout << std::setw(25) << xef[j]
-			<< std::setw(25) << ef[j+k]
-			<< std::setw(25) << pdef[j+k]
-			<< std::endl;
-	    }
-	  }
-	  
-	}
-	
-      }
-  
-    }
-
-    // Allocate memory for table (even and odd)
-    //
-    table.ev.resize(nmax);
-    table.ef.resize(nmax, numz);
-    
-    // Load table (even)
-    //
-    for (int i=0; i<N; i++) table.ev[i*2] = ev[i];
-
-    // Choose sign conventions for the ef table
-    //
-    {
-      int nfid = std::min<int>(nevsign, NUM) - 1;
-      Eigen::VectorXi sgn = Eigen::VectorXi::Ones(N);
-      for (int j=0; j<N; j++) {
-	if (ef[j*NUM+nfid]<0.0) sgn(j) = -1;
-      }
-  
-      for (int i=0; i<numz; i++) {
-	for (int j=0; j<N; j++) 
-	  table.ef(j*2, i) = ef[j*NUM+i] * sgn(j);
-      }
-    }
-
-				// Odd BC, inner zero value
-    cons[0] = 1.0;
-    cons[2] = 0.0;
-
-				// Redo to get antisymmetric functions
-
-    sledge_(job, cons, endfin, invec, tol, type, ev, &NUM, xef, ef, pdef,
-	    t, rho, iflag, store);
-
-    //
-    //     Check for errors
-    //
-#ifdef SLEDGE_THROW
-    // Accumulate sledge error count
-    bad = 0;
-    for (int i=0; i<N; i++) {
-      if (iflag[i] != 0) bad++;
-    }
-
-    sout.str("");
-
-    if (bad>0) {
-
-      // Print sledge error info and throw runtime exception
-      if (myid==0) {
-
-	std::cout.precision(6);
-	std::cout.setf(ios::scientific);
-	std::cout << std::left;
-    
-	std::cout << std::endl
-		  << "Tolerance errors in Sturm-Liouville solver for Kx=" << KX
-		  << " Ky=" << KY << ", odd" <<  std::endl << std::endl;
-
-	std::cout << std::setw(15) << "order"
-		  << std::setw(15) << "eigenvalue"
-		  << std::setw(40) << "condition"
-		  << std::endl
-		  << std::setw(15) << "-----"
-		  << std::setw(15) << "----------"
-		  << std::setw(40) << "---------"
-		  << std::endl;
-	
-	for (int i=0; i<N; i++) {
-	  std::cout << std::setw(15) << invec[3+i] 
-		    << std::setw(15) << ev[i]
-		    << std::setw(40) << sledge_error(iflag[i])
-		    << std::endl;
-	}
-	std::cout << std::endl;
-      
-	sout << std::endl << "SLGridSlab found " << bad
-	     << " tolerance errors in computing SL solutions" << std::endl
-	     << "We suggest checking your model parameters to ensure a"
-	     << std::endl
-	     << "sufficient number of grid points that the relative difference"
-	     << std::endl << "between field quantities is <= 0.3";
-
-	throw GenericError(sout.str(), __FILE__, __LINE__);
-      } else {
-	throw GenericError("sledge errors", __FILE__, __LINE__);
-      }
-    }
-#endif
-
-    //     Print results:
-    //
-    if (tbdbg) {
-
-      std::cout << "Worker " << mpi_myid << ": computed Kx, Ky = " 
-		<< KX << ", " << KY << " [Odd]" << std::endl;
-
-      std::cout.precision(6);
-      std::cout.setf(ios::scientific);
-
-      for (int i=0; i<N; i++) {
-	std::cout << std::setw(15) << invec[3+i] 
-		  << std::setw(15) << ev[i]
-		  << std::setw( 5) << iflag[i]
-		  << std::endl;
-	
-	if (VERBOSE) {
-
-	  if (iflag[i] > -10) {
-	    std::cout << std::setw(14) << "x"
-		      << std::setw(25) << "u(x)"
-		      << std::setw(25) << "(pu`)(x)"
-		      << std::endl;
-	    int k = NUM*i;
-	    for (int j=0; j<NUM; j++) {
-	      std::cout << std::setw(25) << xef[j]
-			<< std::setw(25) << ef[j+k]
-			<< std::setw(25) << pdef[j+k]
-			<< std::endl;
-	    }
-	  }
-	}
-      }
-    }
-  
-    // Load table (odd)
-    //
-    N = nmax - N;
-
-    for (int i=0; i<N; i++) table.ev[i*2+1] = ev[i];
-
-    // Choose sign conventions for the ef table
-    //
-    {
-      int nfid = std::min<int>(nevsign, NUM) - 1;
-      Eigen::VectorXi sgn = Eigen::VectorXi::Ones(N);
-      for (int j=0; j<N; j++) {
-	if (ef[j*NUM+nfid]<0.0) sgn(j) = -1;
-      }
-  
-      for (int i=0; i<numz; i++) {
-	for (int j=0; j<N; j++) 
-	  table.ef(j*2+1, i) = ef[j*NUM+i] * sgn(j);
-      }
-    }
-
-				// Correct for symmetrizing
-    table.ef *= 7.071067811865475e-01;
-    table.kx = KX;
-    table.ky = KY;
-  
-#ifdef SLEDGE_THROW
-    // Send sledge error count to root
-    MPI_Send(&bad, 1, MPI_INT, 0, 10, MPI_COMM_WORLD);
-#endif
-    int position = mpi_pack_table(&table, KX, KY);
-    MPI_Send(&mpi_buf[0], position, MPI_PACKED, 0, 11, MPI_COMM_WORLD);
-
-    if (tbdbg)
-      std::cout << "Worker " << mpi_myid << ": sent to root Kx, Ky = "
-		<< KX << ", " <<  KY << std::endl;
-
-    delete [] iflag;
-    delete [] invec;
-    delete [] ev;
-    delete [] store;
-    delete [] xef;
-    delete [] ef;
-    delete [] pdef;
-  }
-
-}
-
-
 void SLGridSlab::mpi_setup(void)
 {
 				// Get MPI id
@@ -3448,7 +2929,7 @@ void SLGridSlab::mpi_unpack_table(void)
   int kx, ky;
   int retid = status.MPI_SOURCE;
 
-  MPI_Get_count( &status, MPI_PACKED, &length);
+  length = mpi_bufsz;		// The buffer may come from a broadcast
 
 
   MPI_Unpack( &mpi_buf[0], length, &position, &kx, 1, MPI_INT,
@@ -69,6 +69,12 @@ C
 C      There are 4 blocks of labeled COMMON with the names SLREAL,
 C      SLINT, SLLOG, and SLCLSS.
 C
+C      EXP: the COMMON blocks and the SAVEd locals are declared
+C      THREADPRIVATE so that separate OpenMP threads may call SLEDGE
+C      concurrently.  This requires compiling with OpenMP (which also
+C      makes the remaining locals automatic); otherwise the
+C      directives are comments and SLEDGE is serial only.
+C
 C      This is the double precision version of the code; all floating
 C      point variables should be declared DOUBLE PRECISION in the
 C      calling program.  In these subprograms all such local
@@ -839,11 +845,13 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0, TWO = 2.0, 
      &           FOUR = 4.0, TOLMAX = 1.D-4)
       DATA DENSLO,DENSOP,DENSHI/4.0, 6.0, 12.0/
       DATA ENDI/12.0, 20.0, 85.0, 240.0, 500.0/
       DATA ZETAI/2.2, 2.0, 1.5, 1.4, 1.3/
+C$OMP THREADPRIVATE(DENSLO,DENSOP,DENSHI)
 C
 C     Initialize.
 C
@@ -1327,7 +1335,9 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLINT/,/SLLOG/,/SLREAL/)
       SAVE CUTOFF
+C$OMP THREADPRIVATE(CUTOFF)
 C
       NFIRST = -5
       NLAST = -5
@@ -1462,6 +1472,7 @@ C
      &                 ZERO,HALF,ONE,TWO,PI
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0, TWO = 2.0,
      &           PI = 3.14159265358979324D0)
 C
@@ -1552,6 +1563,7 @@ C
      &                 ZERO,HALF,ONE,TWO,PI
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0, TWO = 2.0,
      &           PI = 3.14159265358979324D0)
 C
@@ -1627,6 +1639,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, TWO = 2.0)
 C
 C     Set COUNTZ so that zeros are counted in SHOOT.
@@ -1775,6 +1788,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, TENTH = 0.1D0, ONE = 1.0, TWO = 2.0,
      &           EIGHT = 8.0)
 C
@@ -1942,6 +1956,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, QUART = 0.25D0, HALF = 0.5D0, 
      &           QUART3 = 0.75D0, ONE = 1.0, TWO = 2.0, FOUR = 4.0)
 C
@@ -2500,6 +2515,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0,
      &           TWO = 2.0, THREE = 3.0, FOUR = 4.0, SIX = 6.0,
      &           EIGHT = 8.0, TEN = 10.0, TOLMIN = 5.D-3)
@@ -3344,7 +3360,9 @@ C
      &                 RTOL,T,TOL1,TOL2,VTEMP,W(40,11),
      &                 ZERO,TENTH,HALF,ONE,TWO
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLREAL/)
       SAVE R,W
+C$OMP THREADPRIVATE(R,W)
 C
 C     The local arrays RATIO(*), R(*,*), and W(*,*) must be declared to 
 C     have at least as many rows as the value of MAXLVL initialized in
@@ -3531,6 +3549,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, C10M4 = 1.D-4, HALF = 0.5D0, ONE = 1.0,
      &           TWO = 2.0, THREE = 3.0, FIVE = 5.0, C15 = 15.0,
      &           C21 = 21.0)
@@ -3911,6 +3930,7 @@ C
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLCLSS/CP,CR,CUTOFF,D,EMU,EP,EQLNF,ER,ETA,PNU,KCLASS
+C$OMP THREADPRIVATE(/SLREAL/,/SLLOG/,/SLINT/,/SLCLSS/)
       PARAMETER (ZERO = 0.0, C10M4 = 1.D-4, HALF = 0.5D0, ONE = 1.D0,
      &           TWO = 2.0, THREE = 3.0, FIVE = 5.0, C15 = 15.0,
      &           C21 = 21.0)
@@ -4010,9 +4030,11 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, TENTH = 0.1D0, HALF = 0.5D0, ONE = 1.0,
      &           TWO = 2.0, FOUR = 4.0)
       SAVE ENDA,ENDB
+C$OMP THREADPRIVATE(ENDA,ENDB)
       DATA EPS/0.0001/
 C
       IF (.NOT. JOB) THEN
@@ -4414,6 +4436,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
+C$OMP THREADPRIVATE(/SLINT/,/SLREAL/,/SLLOG/)
       PARAMETER (ZERO = 0.0, TWO = 2.0, FOUR = 4.0)
       IF (LNF) THEN
          CALL COEFF(X,PX,QX,RX)
@@ -4526,6 +4549,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0 ,ONE = 1.0, THREE = 3.0,
      &           FIVE = 5.0, TEN = 10.0, TOLMIN = 1.D-3)
 C
@@ -4754,6 +4778,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0, TWO = 2.0,
      &           PI = 3.141592653589793D0)
       DATA IMAX/1000000/
@@ -4920,6 +4945,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLINT/,/SLLOG/,/SLREAL/)
       PARAMETER (ZERO = 0.0, HALF = 0.5D0, ONE = 1.0,
      &           PIOVR2 = 1.5707963267948966D0, TWO = 2.0, FIVE = 5.0,
      &           HUNDRD = 100.0)
@@ -5042,6 +5068,7 @@ C
       COMMON /SLINT/FLAG,LEVEL,MAXEXT,MAXINT,MAXLVL,NCOEFF,NSGNF,NXINIT
       COMMON /SLLOG/AFIN,BFIN,COUNTZ,LFLAG,LNF,LC,OSC,REG
       COMMON /SLREAL/A1,A1P,A2,A2P,B1,B2,A,B,U,UNDER
+C$OMP THREADPRIVATE(/SLCLSS/,/SLINT/,/SLLOG/,/SLREAL/)
 C
       DOUBLE PRECISION DX,FP,FR,OVER,QX,T,TMU,Z,
      &            ZERO,HNDRTH,QUART,HALF,ONE,TWO,SIX,TWELVE,TWENTY
@@ -87,6 +87,12 @@ void BasisFactoryClasses(py::module &m)
     the basis is cached.  This is a safety and consistency feature that
     may be relaxed in a future version.
 
+    If the environment variable EXP_CACHE_DIR names a directory, bases
+    that are not found in their named cache file are looked up in and
+    saved to a shared store in that directory, keyed by a hash of the
+    basis parameters and model.  EXP_CACHE_LIMIT (e.g. 10G) bounds its
+    size.  Use the 'basiscache' utility to list the stored bases.
+
     Coefficient creation
     --------------------
     The Basis class creates coefficients from phase space with two
@@ -934,7 +934,23 @@ void CoefficientClasses(py::module &m) {
                 list of times
             )")
     .def("WriteH5Coefs",
-            &CoefClasses::Coefs::WriteH5Coefs,
+	 [](CoefClasses::Coefs& A, const std::string& filename, int version)
+	 {
+	   if (version != 1 and version != 2)
+	     throw std::runtime_error("version must be 1 or 2");
+
+	   // The layout is a class-wide setting; restore it afterward
+	   int save = CoefClasses::Coefs::H5Version;
+	   CoefClasses::Coefs::H5Version = version;
+	   try {
+	     A.WriteH5Coefs(filename);
+	   }
+	   catch (...) {
+	     CoefClasses::Coefs::H5Version = save;
+	     throw;
+	   }
+	   CoefClasses::Coefs::H5Version = save;
+	 },
             R"(
             Write the coefficients into an EXP HDF5 coefficient file with the given prefix name.
 
@@ -942,6 +958,10 @@ void CoefficientClasses(py::module &m) {
             ----------
             filename : str
                 the filename prefix.
+            version : int, default=1
+                file layout: 1 writes one group per snapshot; 2 writes
+                the time-series layout needed by lazy containers
+                (Coefs.factory(..., lazy=True))
 
             Returns
             -------
@@ -953,7 +973,7 @@ void CoefficientClasses(py::module &m) {
             coefficient file already exists.  This is a safety
             feature.  If you'd like a new version of this file, delete
             the old before this call.
-            )",py::arg("filename"))
+            )",py::arg("filename"), py::arg("version")=1)
     .def("ExtendH5Coefs",
             &CoefClasses::Coefs::ExtendH5Coefs,
             R"(
@@ -1091,15 +1111,47 @@ void CoefficientClasses(py::module &m) {
                    minimum time value
               tmax : float, default=inf
                    maximum time value
+              lazy : bool, default=False
+                   page snapshots from the file on demand rather than
+                   reading them all into memory.  Requires an HDF5
+                   file in the time-series layout (see coefstoh5).
+              cache_mb : float, default=1024
+                   memory budget in megabytes for resident snapshots
+                   in lazy mode
 
             Returns
             -------
             Coefs
                 the newly created Coefs object
+
+            Notes
+            -----
+            A lazy container is intended for reading: getCoefStruct(),
+            getData() and Times() see every snapshot in the file while
+            members that operate on the whole container (e.g. Power())
+            see only the resident snapshots
             )",
             py::arg("file"), py::arg("stride")=1,
             py::arg("tmin")=-std::numeric_limits<double>::max(),
-            py::arg("tmax")= std::numeric_limits<double>::max())
+            py::arg("tmax")= std::numeric_limits<double>::max(),
+            py::arg("lazy")=false, py::arg("cache_mb")=1024.0)
+    .def("isLazy", &CoefClasses::Coefs::isLazy,
+         R"(
+         Does this container page snapshots from disk?
+
+         Returns
+         -------
+         bool
+         )")
+    .def("lazyStats", &CoefClasses::Coefs::lazyStats,
+         R"(
+         Paging statistics for a lazy container
+
+         Returns
+         -------
+         tuple(int, int, int, int)
+             cache hits, cache misses, hyperslab reads and resident bytes
+         )")
     .def_static("makecoefs", &CoefClasses::Coefs::makecoefs,
 		R"(
                 make a new coefficient container instance compatible
@@ -15,11 +15,14 @@ void ParticleReaderClasses(py::module &m) {
     "The available particle readers are:\n"
     "  1. PSPout         The monolithic EXP phase-space snapshot format\n"
     "  2. PSPspl         Like PSPout, but split into multiple file chunks\n"
-    "  3. GadgetNative   The original Gadget native format\n"
-    "  4  GadgetHDF5     The newer HDF5 Gadget format\n"
-    "  5. TipsyNative    The original Tipsy format\n"
-    "  6. TipsyXDR       The original XDR Tipsy format\n"
-    "  7. Bonsai         This is the Bonsai varient of Tipsy files\n\n"
+    "  3. PSPoutMap      PSPout read through a memory map\n"
+    "  4. PSPsplMap      PSPspl read through memory maps\n"
+    "  5. GadgetNative   The original Gadget native format\n"
+    "  6  GadgetHDF5     The newer HDF5 Gadget format\n"
+    "  7. EXPH5          The columnar HDF5 EXP format written by OutH5\n"
+    "  8. TipsyNative    The original Tipsy format\n"
+    "  9. TipsyXDR       The original XDR Tipsy format\n"
+    " 10. Bonsai         This is the Bonsai varient of Tipsy files\n\n"
     "We have a helper function, getReaders, to get a list to help you\n"
     "remember.  Try: pyEXP.read.ParticleReader.getReaders()\n\n"
     "Each reader can manage snapshots split into many files by parallel,\n"
@@ -117,6 +120,72 @@ void ParticleReaderClasses(py::module &m) {
 
   };
 
+  class PyEXPH5 : public EXPH5
+  {
+  public:
+
+    // Inherit the constructors
+    using EXPH5::EXPH5;
+
+    void SelectType(const std::string& type) override {
+      PYBIND11_OVERRIDE(void, EXPH5, SelectType, type);
+    }
+    
+    std::vector<std::string> GetTypes() override {
+      PYBIND11_OVERRIDE(std::vector<std::string>, EXPH5, GetTypes,);
+    }
+    
+    unsigned long CurrentNumber() override {
+      PYBIND11_OVERRIDE(unsigned long, EXPH5, CurrentNumber,);
+    }
+    
+    double CurrentTime() override {
+      PYBIND11_OVERRIDE(double, EXPH5, CurrentTime,);
+    }
+    
+    const Particle* firstParticle() override {
+      PYBIND11_OVERRIDE(const Particle*, EXPH5, firstParticle,);
+    }
+
+    const Particle* nextParticle() override {
+      PYBIND11_OVERRIDE(const Particle*, EXPH5, nextParticle,);
+    }
+
+  };
+
+  class PyPSPmap : public PSPmap
+  {
+  public:
+
+    // Inherit the constructors
+    using PSPmap::PSPmap;
+
+    void SelectType(const std::string& type) override {
+      PYBIND11_OVERRIDE(void, PSPmap, SelectType, type);
+    }
+    
+    std::vector<std::string> GetTypes() override {
+      PYBIND11_OVERRIDE(std::vector<std::string>, PSPmap, GetTypes,);
+    }
+    
+    unsigned long CurrentNumber() override {
+      PYBIND11_OVERRIDE(unsigned long, PSPmap, CurrentNumber,);
+    }
+    
+    double CurrentTime() override {
+      PYBIND11_OVERRIDE(double, PSPmap, CurrentTime,);
+    }
+    
+    const Particle* firstParticle() override {
+      PYBIND11_OVERRIDE(const Particle*, PSPmap, firstParticle,);
+    }
+
+    const Particle* nextParticle() override {
+      PYBIND11_OVERRIDE(const Particle*, PSPmap, nextParticle,);
+    }
+
+  };
+
   class PyGadgetNative : public GadgetNative
   {
   public:
@@ -401,8 +470,9 @@ void ParticleReaderClasses(py::module &m) {
   pr.def_static("getReaders", []()
   {
     const std::vector<std::string> formats = {
-      "PSPout", "PSPspl", "GadgetNative", "GadgetHDF5", "TipsyNative",
-      "TipsyXDR", "Bonsai"};
+      "PSPout", "PSPspl", "PSPoutMap", "PSPsplMap", "GadgetNative",
+      "GadgetHDF5", "EXPH5",
+      "TipsyNative", "TipsyXDR", "Bonsai"};
 
     return formats;
     },
@@ -433,6 +503,72 @@ void ParticleReaderClasses(py::module &m) {
          ParticleReader
          )");
 
+  py::class_<EXPH5, std::shared_ptr<EXPH5>, PyEXPH5, ParticleReader>(m, "EXPH5")
+    .def(py::init<const std::vector<std::string>&, bool>(),
+	 R"(
+         Read the columnar HDF5 snapshots written by OutH5
+
+         Parameters
+         ----------
+         files : list(str)
+             List of files with phase-space segments comprising a single snapshot
+         verbose : bool, default=False
+             Verbose, diagnostic output
+
+         Returns
+         -------
+         ParticleReader
+         )")
+    .def("SelectColumns", &EXPH5::SelectColumns,
+	 R"(
+         Read only the named columns
+
+         Parameters
+         ----------
+         columns : list(str)
+             Subset of 'index', 'mass', 'pos', 'vel', 'pot', 'iattrib',
+             'dattrib'.  An empty list reads all columns.  Takes
+             effect when the particles are next read.
+
+         Returns
+         -------
+         None
+         )", py::arg("columns"))
+    .def("SelectRange", &EXPH5::SelectRange,
+	 R"(
+         Read only the particles in the index range [beg, end) of each file
+
+         Parameters
+         ----------
+         beg : int
+             first particle position
+         end : int
+             one past the last particle position
+
+         Returns
+         -------
+         None
+         )", py::arg("beg"), py::arg("end"));
+
+  py::class_<PSPmap, std::shared_ptr<PSPmap>, PyPSPmap, ParticleReader>(m, "PSPmap")
+    .def(py::init<const std::vector<std::string>&, bool, bool>(),
+	 R"(
+         Read PSP snapshots through memory maps
+
+         Parameters
+         ----------
+         files : list(str)
+             The OUT file or the SPL master file
+         split : bool
+             True for SPL files
+         verbose : bool, default=False
+             Verbose, diagnostic output
+
+         Returns
+         -------
+         ParticleReader
+         )", py::arg("files"), py::arg("split"), py::arg("verbose")=false);
+
   py::class_<GadgetNative, std::shared_ptr<GadgetNative>, PyGadgetNative, ParticleReader>(m, "GadgetNative")
     .def(py::init<const std::vector<std::string>&, bool>(),
 	 R"(
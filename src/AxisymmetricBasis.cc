@@ -28,7 +28,8 @@ AxisymmetricBasis::valid_keys =
     "vtkfreq",
     "tksmooth",
     "tkcum",
-    "tk_type"
+    "tk_type",
+    "pcalock"
   };
 
 AxisymmetricBasis:: AxisymmetricBasis(Component* c0, const YAML::Node& conf) :
@@ -58,6 +59,11 @@ AxisymmetricBasis:: AxisymmetricBasis(Component* c0, const YAML::Node& conf) :
   subsamp   = false;
   defSampT  = 1;
   sampT     = 1;
+  pcalock   = false;
+
+  pca_time_accum  = 0.0;
+  pca_time_reduce = 0.0;
+  pca_time_count  = 0;
 
   string val;
 
@@ -80,6 +86,7 @@ AxisymmetricBasis:: AxisymmetricBasis(Component* c0, const YAML::Node& conf) :
     if (conf["tksmooth"])  tksmooth   = conf["tksmooth"].as<double>();
     if (conf["tkcum"])     tkcum      = conf["tkcum"].as<double>();
     if (conf["tk_type"])   tk_type    = setTK(conf["tk_type"].as<std::string>());
+    if (conf["pcalock"])   pcalock    = conf["pcalock"].as<bool>();
 
     if (conf["Mmax"] and not conf["Lmax"]) Lmax = Mmax;
   }
@@ -1271,6 +1278,120 @@ void AxisymmetricBasis::parallel_gather_coef2(void)
   
 }
 
+void AxisymmetricBasis::pca_thread_zero(int Lsize)
+{
+  if (pcalock or nthrds==1) return;
+
+  if (pcavar) {
+
+    // Allocate on first use or if the subsample count has changed
+    //
+    if (massT1t.size() != nthrds or massT1t.back().size() != sampT) {
+
+      expcoefT1t.resize(nthrds);
+      expcoefM1t.resize(nthrds);
+      massT1t   .resize(nthrds);
+
+      for (int id=1; id<nthrds; id++) {
+	expcoefT1t[id].resize(sampT);
+	for (auto & t : expcoefT1t[id]) {
+	  t.resize(Lsize);
+	  for (auto & v : t) v = std::make_shared<Eigen::VectorXd>(nmax);
+	}
+
+	expcoefM1t[id].resize(sampT);
+	for (auto & t : expcoefM1t[id]) {
+	  t.resize(Lsize);
+	  for (auto & v : t) v = std::make_shared<Eigen::MatrixXd>(nmax, nmax);
+	}
+
+	massT1t[id].resize(sampT);
+      }
+    }
+
+    for (int id=1; id<nthrds; id++) {
+      for (auto & t : expcoefT1t[id]) { for (auto & v : t) v->setZero(); }
+      for (auto & t : expcoefM1t[id]) { for (auto & v : t) v->setZero(); }
+      std::fill(massT1t[id].begin(), massT1t[id].end(), 0.0);
+    }
+  }
+
+  if (pcaeof) {
+
+    if (tvart.size() != nthrds) {
+      tvart.resize(nthrds);
+      for (int id=1; id<nthrds; id++) {
+	tvart[id].resize(tvar.size());
+	for (auto & v : tvart[id]) v = std::make_shared<Eigen::MatrixXd>(nmax, nmax);
+      }
+    }
+
+    for (int id=1; id<nthrds; id++) {
+      for (auto & v : tvart[id]) v->setZero();
+    }
+  }
+}
+
+void AxisymmetricBasis::pca_thread_reduce()
+{
+  if (pcalock or nthrds==1) return;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  if (pcavar) {
+    for (int id=1; id<nthrds; id++) {
+      for (unsigned T=0; T<sampT; T++) {
+	massT1[T] += massT1t[id][T];
+	for (int l=0; l<expcoefT1[T].size(); l++) {
+	  *expcoefT1[T][l] += *expcoefT1t[id][T][l];
+	  *expcoefM1[T][l] += *expcoefM1t[id][T][l];
+	}
+      }
+    }
+  }
+
+  if (pcaeof) {
+    for (int id=1; id<nthrds; id++) {
+      for (int l=0; l<tvar.size(); l++) *tvar[l] += *tvart[id][l];
+    }
+  }
+
+  auto finish = std::chrono::high_resolution_clock::now();
+  pca_time_reduce += std::chrono::duration<double>(finish - start).count();
+}
+
+void AxisymmetricBasis::pca_timing_report(const std::string& label)
+{
+  if (pca_time_count==0) return;
+
+  // The slowest process determines the step time
+  //
+  double tim[2] = {pca_time_accum, pca_time_reduce}, tmax[2];
+  MPI_Reduce(tim, tmax, 2, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+  if (myid==0) {
+    std::cout << std::string(60, '=') << std::endl
+	      << "== " << label << " [" << component->name << "]" << std::endl
+	      << "== mode: " << (pcalock ? "locked" : "lock-free")
+	      << ", threads: " << nthrds
+	      << ", passes: " << pca_time_count << std::endl
+	      << std::string(60, '=') << std::endl
+	      << std::left
+	      << std::setw(20) << "Accumulate [s]"
+	      << std::setw(20) << tmax[0] << std::endl
+	      << std::setw(20) << "Reduce [s]"
+	      << std::setw(20) << tmax[1] << std::endl
+	      << std::setw(20) << "Per pass [s]"
+	      << std::setw(20) << (tmax[0] + tmax[1])/pca_time_count
+	      << std::endl << std::right
+	      << std::string(60, '=') << std::endl;
+  }
+
+  pca_time_accum  = 0.0;
+  pca_time_reduce = 0.0;
+  pca_time_count  = 0;
+}
+
 AxisymmetricBasis::TKType AxisymmetricBasis::setTK(const std::string& tk)
 {
   TKType ret = None;
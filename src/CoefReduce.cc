@@ -0,0 +1,93 @@
+#include <iomanip>
+#include <sstream>
+
+#include <EXPException.H>
+#include <CoefReduce.H>
+
+CoefReduce::Stats CoefReduce::stats;
+
+CoefReduce::~CoefReduce()
+{
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (not finalized) wait();
+}
+
+void CoefReduce::post(const std::vector<VectorP>& src,
+		      const std::vector<VectorP>& dst)
+{
+  if (src.size() != dst.size()) {
+    std::ostringstream sout;
+    sout << "CoefReduce::post: size(src)=" << src.size()
+	 << " != size(dst)=" << dst.size();
+    throw GenericError(sout.str(), __FILE__, __LINE__, 1017, true);
+  }
+
+  wait();			// Finish the previous use of the buffer
+
+  double t0 = MPI_Wtime();
+
+  size_t sz = 0;
+  for (auto & v : src) sz += v->size();
+
+  buf.resize(sz);
+
+  size_t off = 0;
+  for (auto & v : src) {
+    std::copy(v->data(), v->data() + v->size(), &buf[off]);
+    off += v->size();
+  }
+
+  target = dst;
+
+  MPI_Iallreduce(MPI_IN_PLACE, buf.data(), sz, MPI_DOUBLE, MPI_SUM,
+		 MPI_COMM_WORLD, &req);
+
+  tpost = MPI_Wtime();
+
+  stats.posts++;
+  stats.values += sz;
+  stats.pack   += tpost - t0;
+}
+
+void CoefReduce::wait()
+{
+  if (req == MPI_REQUEST_NULL) return;
+
+  double t0 = MPI_Wtime();
+  MPI_Wait(&req, MPI_STATUS_IGNORE);
+  double t1 = MPI_Wtime();
+
+  size_t off = 0;
+  for (auto & v : target) {
+    std::copy(&buf[off], &buf[off] + v->size(), v->data());
+    off += v->size();
+  }
+  target.clear();
+
+  double t2 = MPI_Wtime();
+
+  stats.overlap += t0 - tpost;
+  stats.wait    += t1 - t0;
+  stats.pack    += t2 - t1;
+}
+
+void CoefReduce::report(std::ostream& out, const std::string& label)
+{
+  out << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setw(70) << std::left << "--- " + label << std::endl
+      << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setfill(' ') << std::right
+      << std::setw(10) << "Posts"
+      << std::setw(14) << "Values"
+      << std::setw(14) << "Pack"
+      << std::setw(14) << "Overlap"
+      << std::setw(14) << "Wait" << std::endl
+      << std::setw(10) << stats.posts
+      << std::setw(14) << stats.values
+      << std::setw(14) << std::setprecision(6) << stats.pack
+      << std::setw(14) << std::setprecision(6) << stats.overlap
+      << std::setw(14) << std::setprecision(6) << stats.wait << std::endl
+      << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setfill(' ');
+}
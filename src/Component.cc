@@ -6,6 +6,8 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <limits>
+#include <climits>
 
 #include <Component.H>
 #include <Bessel.H>
@@ -20,6 +22,7 @@
 #include <NoForce.H>
 #include <Orient.H>
 #include <YamlCheck.H>
+#include <SFCKey.H>
 
 #include "expand.H"
 
@@ -84,7 +87,10 @@ const std::set<std::string> Component::valid_keys_parm =
     "ctr_name",
     "noswitch",
     "freezeL",
-    "dtreset"
+    "dtreset",
+    "soa",
+    "decomp",
+    "sfcsample"
   };
 
 const std::set<std::string> Component::valid_keys_force =
@@ -247,6 +253,9 @@ Component::Component(YAML::Node& CONF)
   noswitch    = false;		// Allow multistep switching at master step only
   dtreset     = true;		// Select time step from criteria over last step
   freezeLev   = false;		// Only compute new levels on first step
+  use_soa     = false;		// Use the level-ordered SoA slot table
+  decomp      = Decomp::count;	// Count-based load balancing
+  sfcSample   = 64;		// Splitter samples per process
 
   set_default_values();
 
@@ -358,6 +367,9 @@ void Component::set_default_values()
   if (!cconf["noswitch"])        cconf["noswitch"]    = noswitch;
   if (!cconf["freezeL"])         cconf["freezeL"]     = freezeLev;
   if (!cconf["dtreset"])         cconf["dtreset"]     = dtreset;
+  if (!cconf["soa"])             cconf["soa"]         = use_soa;
+  if (!cconf["decomp"])          cconf["decomp"]      = "count";
+  if (!cconf["sfcsample"])       cconf["sfcsample"]   = sfcSample;
 }
 
 
@@ -400,6 +412,19 @@ void * reset_level_lists_thrd(void *ptr)
 
 void Component::reset_level_lists()
 {
+				// Level changes only permute the slot
+				// arrays; the level lists follow the
+				// slot order
+  if (use_soa and soa and not soa->isStale()) {
+    soa->relevel(multistep);
+    levlist = std::vector< std::vector<int> > (multistep+1);
+    for (unsigned n=0; n<=multistep; n++)
+      levlist[n].assign(soa->indx.begin() + soa->levBeg(n),
+			soa->indx.begin() + soa->levEnd(n));
+    if (VERBOSE>10) print_level_lists();
+    return;
+  }
+
   if (td.size()==0) {
     td = vector<thrd_pass_reset>(nthrds);
 
@@ -477,8 +502,25 @@ void Component::reset_level_lists()
 			td[i].newlist[n].end());
     }
   }
+
+				// Rebuild the level-ordered slot
+				// table and lay out the level lists
+				// in slot order
+  if (use_soa) {
+    if (not soa) soa = std::make_shared<ParticleSoA>();
+    soa->release();
+    soa->build(particles, multistep);
+    for (unsigned n=0; n<=multistep; n++)
+      levlist[n].assign(soa->indx.begin() + soa->levBeg(n),
+			soa->indx.begin() + soa->levEnd(n));
+  }
   
-  if (VERBOSE>10 and particles.size()) {
+  if (VERBOSE>10) print_level_lists();
+}
+
+void Component::print_level_lists()
+{
+  if (particles.size()) {
 				// Level creation check
     for (int n=0; n<numprocs; n++) {
 
@@ -747,6 +789,9 @@ Component::Component(YAML::Node& CONF, istream *in, bool SPL) : conf(CONF)
   noswitch    = false;		// Allow multistep switching at master step only
   dtreset     = true;		// Select level from criteria over last step
   freezeLev   = false;		// Only compute new levels on first step
+  use_soa     = false;		// Use the level-ordered SoA slot table
+  decomp      = Decomp::count;	// Count-based load balancing
+  sfcSample   = 64;		// Splitter samples per process
 
   configure();
 
@@ -824,6 +869,17 @@ void Component::configure(void)
     if (cconf["noswitch"])   noswitch  = cconf["noswitch"].as<bool>();
     if (cconf["freezeL"])   freezeLev  = cconf["freezeL" ].as<bool>();
     if (cconf["dtreset"])     dtreset  = cconf["dtreset" ].as<bool>();
+    if (cconf["soa"    ])     use_soa  = cconf["soa"     ].as<bool>();
+#if HAVE_LIBCUDA==1
+    if (use_soa and use_cuda) {
+      if (myid==0) std::cout << "Component <" << name << ">: "
+			     << "soa is not used with the CUDA device kernels"
+			     << std::endl;
+      use_soa = false;
+    }
+#endif
+    if (cconf["decomp" ])     decomp   = parseDecomp(cconf["decomp"].as<std::string>());
+    if (cconf["sfcsample"]) sfcSample  = cconf["sfcsample"].as<int>();
     
     if (cconf["ton"]) {
       ton = cconf["ton"].as<double>();
@@ -1456,8 +1512,9 @@ void Component::read_bodies_and_distribute_binary_out(istream *in)
     memcpy(info.get(), header.info.get(), ninfochar);
   }
 
-  if (umagic)
-    MPI_Bcast(&rsize, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+				// Every process needs the particle
+				// size, whether or not umagic is set
+  MPI_Bcast(&rsize, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
 
 				// Broadcast attributes for this
 				// phase-space component
@@ -1568,6 +1625,28 @@ void Component::read_bodies_and_distribute_binary_out(istream *in)
 				// sizes
   if (not pf) pf = ParticleFerryPtr(new ParticleFerry(niattrib, ndattrib));
 
+				// Each process reads its own range
+				// of the file with MPI-IO
+  if (mpiio_restart) {
+				// Byte offset of the first particle
+    long long offset = 0;
+    if (myid==0) offset = in->tellg();
+    MPI_Bcast(&offset, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+
+    read_bodies_mpiio({outdir + infile}, {offset}, {nbodies_tot});
+
+				// Position the root stream at the
+				// next component header
+    if (myid==0) {
+      Particle temp(niattrib, ndattrib);
+      in->seekg(offset + nbodies_tot*temp.getMPIBufSize(rsize, indexing));
+    }
+
+    initialize();
+
+    return;
+  }
+
 				// Form cumulative and differential
 				// bodies list
   unsigned int ipart=0;
@@ -1708,6 +1787,118 @@ void Component::openNextBlob(std::ifstream& in,
 }
 
 
+void Component::read_bodies_mpiio(const std::vector<std::string>& files,
+				  const std::vector<MPI_Offset>& offsets,
+				  const std::vector<unsigned long>& counts)
+{
+				// The segments must hold exactly the
+				// component's bodies; the counts are
+				// the same on every process so all
+				// of them throw together
+  unsigned long nsum = 0;
+  for (auto c : counts) nsum += c;
+  if (nsum != static_cast<unsigned long>(nbodies_tot)) {
+    std::ostringstream sout;
+    sout << "Component::read_bodies_mpiio: the " << files.size()
+	 << " segment(s) hold " << nsum << " bodies but the component "
+	 << "header has " << nbodies_tot;
+    throw GenericError(sout.str(), __FILE__, __LINE__, 1010, true);
+  }
+
+				// Bytes per particle in the PSP
+  const size_t bSiz = Particle(niattrib, ndattrib).getMPIBufSize(rsize, indexing);
+
+				// Particles per read (buffer ~ 64MB)
+  const unsigned long nChunk =
+    std::max<unsigned long>(1, (1UL << 26)/bSiz);
+
+				// Global range for this process
+  unsigned long pbeg = myid ? nbodies_index[myid-1] : 0;
+  unsigned long pend = nbodies_index[myid];
+
+  std::vector<char> buffer(nChunk*bSiz);
+
+  double rmax1 = 0.0;
+  top_seq = 0;
+
+  unsigned long sbeg = 0;	// Global index of the first particle
+				// in the current segment
+  for (size_t s=0; s<files.size(); s++) {
+
+    unsigned long send = sbeg + counts[s];
+    unsigned long beg  = std::max<unsigned long>(pbeg, sbeg);
+    unsigned long end  = std::max<unsigned long>(beg, std::min<unsigned long>(pend, send));
+
+    MPI_File fh;
+    int ret = MPI_File_open(MPI_COMM_WORLD, files[s].c_str(),
+			    MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+
+    if (ret != MPI_SUCCESS) {
+      std::ostringstream sout;
+      sout << "Component::read_bodies_mpiio: could not open <"
+	   << files[s] << "> for MPI-IO";
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1010, true);
+    }
+				// Every process must make the same
+				// number of collective calls
+    unsigned long nround = (end - beg + nChunk - 1)/nChunk, mround;
+    MPI_Allreduce(&nround, &mround, 1, MPI_UNSIGNED_LONG, MPI_MAX,
+		  MPI_COMM_WORLD);
+
+    unsigned long next = beg;
+    for (unsigned long r=0; r<mround; r++) {
+
+      unsigned long number = std::min<unsigned long>(nChunk, end - next);
+      MPI_Offset    off    = offsets[s] + MPI_Offset(next - sbeg)*bSiz;
+      MPI_Status    status;
+
+      MPI_File_read_at_all(fh, off, buffer.data(), number*bSiz, MPI_CHAR,
+			   &status);
+
+      int bytes;
+      MPI_Get_count(&status, MPI_CHAR, &bytes);
+      if (bytes != static_cast<int>(number*bSiz)) {
+	std::ostringstream sout;
+	sout << "Component::read_bodies_mpiio: process " << myid
+	     << " read " << bytes << " of " << number*bSiz
+	     << " bytes from <" << files[s] << "> at offset " << off;
+	throw GenericError(sout.str(), __FILE__, __LINE__, 1010, true);
+      }
+
+      for (unsigned long i=0; i<number; i++) {
+	PartPtr part = std::make_shared<Particle>(niattrib, ndattrib);
+
+	part->readBinaryMPI(&buffer[i*bSiz], rsize, indexing, next + i + 1);
+
+	double r2 = 0.0;
+	for (int k=0; k<3; k++) r2 += part->pos[k]*part->pos[k];
+	rmax1 = std::max<double>(r2, rmax1);
+
+	particles[part->indx] = part;
+
+	top_seq = std::max<unsigned long>(part->indx, top_seq);
+      }
+
+      next += number;
+    }
+
+    MPI_File_close(&fh);
+
+    sbeg = send;
+  }
+
+  nbodies = particles.size();
+  if (myid==0) seq_cur = nbodies_tot;
+
+				// Default: set to max radius
+  MPI_Allreduce(MPI_IN_PLACE, &rmax1, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  rmax = sqrt(fabs(rmax1));
+
+  MPI_Allreduce(MPI_IN_PLACE, &top_seq, 1, MPI_UNSIGNED_LONG, MPI_MAX,
+		MPI_COMM_WORLD);
+}
+
+
 void Component::read_bodies_and_distribute_binary_spl(istream *in)
 {
   // Will contain the component header
@@ -1765,8 +1956,9 @@ void Component::read_bodies_and_distribute_binary_spl(istream *in)
     memcpy(info.get(), header.info.get(), ninfochar);
   }
 
-  if (umagic)
-    MPI_Bcast(&rsize, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+				// Every process needs the particle
+				// size, whether or not umagic is set
+  MPI_Bcast(&rsize, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
 
   // Broadcast attributes for this phase-space component
   //
@@ -1892,6 +2084,47 @@ void Component::read_bodies_and_distribute_binary_spl(istream *in)
 				// sizes
   if (not pf) pf = ParticleFerryPtr(new ParticleFerry(niattrib, ndattrib));
 
+				// Each process reads its own range
+				// of the blobs with MPI-IO
+  if (mpiio_restart) {
+
+    MPI_Bcast(&number, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    std::vector<std::string>   files(number);
+    std::vector<MPI_Offset>    offsets(number, sizeof(unsigned int));
+    std::vector<unsigned long> counts(number);
+
+				// Root gets the blob names and the
+				// particle count in each blob
+    if (myid==0) {
+      auto fit = parts.begin();
+      std::ifstream fin;
+      for (int n=0; n<number; n++) {
+	if (outdir.back() != '/') files[n] = outdir + '/' + *fit;
+	else                      files[n] = outdir + *fit;
+	int N;
+	openNextBlob(fin, fit, N);
+	counts[n] = N;
+      }
+    }
+
+    for (auto & f : files) {
+      int len = f.size();
+      MPI_Bcast(&len, 1, MPI_INT, 0, MPI_COMM_WORLD);
+      f.resize(len);
+      MPI_Bcast(f.data(), len, MPI_CHAR, 0, MPI_COMM_WORLD);
+    }
+
+    if (number)
+      MPI_Bcast(counts.data(), number, MPI_UNSIGNED_LONG, 0, MPI_COMM_WORLD);
+
+    read_bodies_mpiio(files, offsets, counts);
+
+    initialize();
+
+    return;
+  }
+
 				// Form cumulative and differential
 				// bodies list
   unsigned int ipart=0;
@@ -2015,6 +2248,8 @@ void Component::read_bodies_and_distribute_binary_spl(istream *in)
 
 PartPtr * Component::get_particles(int* number)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   static std::vector<unsigned> totals;
   static unsigned counter = 0;	// Counter for all
   static int      node    = 0;	// Current node
@@ -2302,6 +2537,8 @@ void Component::write_binary_header(ostream* out, bool real4, const std::string
 
 void Component::write_binary_particles(std::ostream* out, bool real4)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   unsigned int N = particles.size();
   out->write((const char*)&N, sizeof(unsigned int));
 
@@ -2326,6 +2563,8 @@ void Component::write_binary_particles(std::ostream* out, bool real4)
 void Component::write_binary_particles
 (std::vector<std::shared_ptr<std::ofstream>>& out, bool real4)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   // Set number of OpenMP threads equal to number of streams.  It's up
   // to the user to make that cores are available.
   //
@@ -2408,6 +2647,8 @@ void Component::write_binary_particles
 void Component::write_binary_particles
 (std::ostream* out, int nthreads, bool real4)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   // Set number of OpenMP threads.  It's up
   // to the user to make that cores are available.
   //
@@ -2498,6 +2739,8 @@ public:
 
 void Component::write_binary_mpi_b(MPI_File& out, MPI_Offset& offset, bool real4)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   ComponentHeader header;
   MPI_Status status;
   char err[MPI_MAX_ERROR_STRING];
@@ -2600,8 +2843,70 @@ void Component::write_binary_mpi_b(MPI_File& out, MPI_Offset& offset, bool real4
 }
 
 
+void Component::write_binary_stage(std::vector<StagedBlock>& stage,
+				   MPI_Offset& offset, bool real4)
+{
+  if (soa) soa->release();	// Particles hold the phase space
+
+  ComponentHeader header;
+
+  if (real4) rsize = sizeof(float);
+  else       rsize = sizeof(double);
+
+  if (myid == 0) {
+
+    header.nbod  = nbodies_tot;
+    header.niatr = niattrib;
+    header.ndatr = ndattrib;
+  
+    std::ostringstream outs;
+    outs << conf << std::endl;
+    strncpy(header.info.get(), outs.str().c_str(), header.ninfochar);
+
+    unsigned long cmagic = magic + rsize;
+
+    std::ostringstream sout;
+    sout.write((const char*)&cmagic, sizeof(unsigned long));
+    if (!header.write(&sout)) {
+      std::string msg("Component::write_binary_stage: Error writing particle header");
+      throw GenericError(msg, __FILE__, __LINE__, 1011, true);
+    }
+
+    std::string hdr = sout.str();
+    stage.push_back({offset, std::vector<char>(hdr.begin(), hdr.end())});
+  }
+
+  offset += sizeof(unsigned long) + header.getSize();
+
+  unsigned N = particles.size();
+  std::vector<unsigned> numP(numprocs, 0);
+
+  MPI_Allgather(&N, 1, MPI_UNSIGNED, &numP[0], 1, MPI_UNSIGNED,	MPI_COMM_WORLD);
+  
+  for (int i=1; i<numprocs; i++) numP[i] += numP[i-1];
+
+  unsigned bSiz = Particle(niattrib, ndattrib).getMPIBufSize(rsize, indexing);
+  if (myid) offset += numP[myid-1] * bSiz;
+
+  if (N) {
+    std::vector<char> buffer(N*bSiz);
+    char *buf = buffer.data();
+    for (auto & p : particles)
+      buf += p.second->writeBinaryMPI(buf, rsize, indexing);
+
+    stage.push_back({offset, std::move(buffer)});
+  }
+
+  // Position file offset at end of particles
+  //
+  offset += (numP[numprocs-1] - (myid ? numP[myid-1] : 0)) * bSiz;
+}
+
+
 void Component::write_binary_mpi_i(MPI_File& out, MPI_Offset& offset, bool real4)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   ComponentHeader header;
   MPI_Request request = MPI_REQUEST_NULL;
   MPI_Status status;
@@ -2750,6 +3055,8 @@ void Component::write_ascii(ostream* out, bool accel)
 
 void Component::initialize_com_system()
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   double mtot1;
   double *com1 = new double [3];
   double *cov1 = new double [3];
@@ -2841,12 +3148,36 @@ void * fix_positions_thread(void *ptr)
     mtotE         = &(static_cast<thrd_pass_posn*>(ptr)->mtotE[0]);
   }
 
+				// Slot arrays, if resident.  The
+				// escape check needs the Particle.
+  ParticleSoA *soa = 0;
+  if (not (consp and tidal>=0) and c->soaResident()) soa = &c->SoA();
+
   for (unsigned mm=mlevel; mm<=multistep; mm++) {
 
     int nbodies = c->levlist[mm].size();
     int nbeg    = nbodies*(id  )/nthrds;
     int nend    = nbodies*(id+1)/nthrds;
 
+				// Stream the level's slot range
+    if (soa) {
+      unsigned sbeg = soa->levBeg(mm);
+      for (int q=nbeg; q<nend; q++) {
+	unsigned s = sbeg + q;
+	if (c->freeze(soa->indx[s])) continue;
+
+	double mass = soa->mass[s];
+	mtot[mm] += mass;
+
+	for (int k=0; k<c->dim; k++) {
+	  com[3*mm+k] += mass*soa->pos[k][s];
+	  cov[3*mm+k] += mass*soa->vel[k][s];
+	  coa[3*mm+k] += mass*soa->acc[k][s];
+	}
+      }
+      continue;
+    }
+
 				// Particle loop
     for (int q=nbeg; q<nend; q++) {
     
@@ -3187,6 +3518,10 @@ void * get_angmom_thread(void *ptr)
   // Level
   //
   unsigned mlevel = static_cast<thrd_pass_angmom*>(ptr)->mlevel;
+  //
+  // Slot arrays, if resident
+  //
+  ParticleSoA *soa = c->soaResident() ? &c->SoA() : 0;
 
 
   for (unsigned mm=mlevel; mm<=multistep; mm++) {
@@ -3202,13 +3537,25 @@ void * get_angmom_thread(void *ptr)
     for (int q=nbeg; q<nend; q++) {
       
       unsigned long n = c->levlist[mm][q];
-      Particle     *p = c->Part(n);
 
       if (c->freeze(n)) continue;
 
-      mass = p->mass;
-      pos  = p->pos;
-      vel  = p->vel;
+      double spos[3], svel[3];
+      if (soa) {		// Level lists are in slot order
+	unsigned s = soa->levBeg(mm) + q;
+	mass = soa->mass[s];
+	for (int k=0; k<3; k++) {
+	  spos[k] = soa->pos[k][s];
+	  svel[k] = soa->vel[k][s];
+	}
+	pos = spos;
+	vel = svel;
+      } else {
+	Particle *p = c->Part(n);
+	mass = p->mass;
+	pos  = p->pos;
+	vel  = p->vel;
+      }
     
       angm1[3*mm + 0] += mass*(pos[1]*vel[2] - pos[2]*vel[1]);
 
@@ -3405,6 +3752,8 @@ void Component::update_indices(void)
 
 void Component::load_balance(void)
 {
+  if (soa) soa->release();	// Particles hold the phase space
+
   MPI_Status status;
   vector<unsigned int> nbodies_index1(numprocs);
   vector<unsigned int> nbodies_table1(numprocs);
@@ -3639,6 +3988,396 @@ void Component::load_balance(void)
 }
 
 
+void Component::record_force_work(unsigned mlevel, double seconds)
+{
+  if (forceWork.size() != multistep+1) forceWork.resize(multistep+1, 0.0);
+
+  size_t nactive = 0;
+  for (unsigned M=mlevel; M<=multistep; M++) nactive += levlist[M].size();
+  if (nactive==0) return;
+
+  // Each active particle was charged the same share of this step's
+  // force time
+  //
+  double share = seconds/nactive;
+  for (unsigned M=mlevel; M<=multistep; M++) forceWork[M] += share;
+}
+
+void Component::update_effort()
+{
+  double total = 0.0;
+  for (auto v : forceWork) total += v;
+  if (total<=0.0) return;
+
+  // Measured force time at each particle's current level over the
+  // balancing interval
+  //
+  for (auto & v : particles) {
+    unsigned L = std::min<unsigned>(v.second->level, forceWork.size()-1);
+    v.second->effort = forceWork[L];
+  }
+
+  std::fill(forceWork.begin(), forceWork.end(), 0.0);
+}
+
+double Component::effort_imbalance()
+{
+  std::vector<double> wproc(numprocs, 0.0);
+  for (auto & v : particles) wproc[myid] += v.second->effort;
+  MPI_Allreduce(MPI_IN_PLACE, wproc.data(), numprocs, MPI_DOUBLE,
+		MPI_SUM, MPI_COMM_WORLD);
+
+  double wall = 0.0;
+  for (auto v : wproc) wall += v;
+  if (wall<=0.0) return 0.0;
+
+  double worst = 0.0;
+  for (int n=0; n<numprocs; n++) {
+    double target = comp->rates[n]*wall;
+    if (target>0.0) worst = std::max<double>(worst, fabs(wproc[n]/target - 1.0));
+  }
+
+  return worst;
+}
+
+double Component::key_drift()
+{
+  if (soa) soa->release();	// Particles hold the phase space
+
+  if (decomp == Decomp::count or decomp == Decomp::effort) return 0.0;
+
+  // Never decomposed along the curve
+  //
+  if (not sfcValid) return 1.0;
+
+  bool useHilbert = decomp == Decomp::hilbert;
+
+  unsigned long lower = myid>0 ? sfcSplit[myid-1] : 0;
+  bool top = myid == numprocs-1;
+
+  // Keys are computed in the frame of the last decomposition
+  //
+  double cnt[2] = {0.0, static_cast<double>(particles.size())};
+  for (auto & v : particles) {
+    unsigned long key = SFC::key(v.second->pos, sfcLo, sfcLen, useHilbert);
+    if (key < lower or (not top and key >= sfcSplit[myid])) cnt[0] += 1.0;
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, cnt, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  return cnt[1]>0.0 ? cnt[0]/cnt[1] : 0.0;
+}
+
+Component::Decomp Component::parseDecomp(const std::string& name)
+{
+  if (name == "count"  ) return Decomp::count;
+  if (name == "hilbert") return Decomp::hilbert;
+  if (name == "morton" ) return Decomp::morton;
+  if (name == "effort" ) return Decomp::effort;
+
+  std::ostringstream sout;
+  sout << "Component: unknown decomposition <" << name << ">; "
+       << "choices are count, effort, hilbert or morton";
+  throw GenericError(sout.str(), __FILE__, __LINE__, 1016, false);
+}
+
+void Component::load_balance_weighted(const std::string& trigger)
+{
+  // Initialize the particle ferry instance with dynamic attribute sizes
+  if (not pf) pf = ParticleFerryPtr(new ParticleFerry(niattrib, ndattrib));
+
+  // The particle list will change
+  if (soa) soa->invalidate();
+
+  update_indices();		// Refresh particle counts
+
+  bool useCurve   = decomp != Decomp::effort;
+  bool useHilbert = decomp == Decomp::hilbert;
+
+  //
+  // Bounding cube for all particles in this component
+  //
+  double lo[3], hi[3], len = 1.0;
+
+  if (useCurve) {
+    for (int k=0; k<3; k++) {
+      lo[k] =  std::numeric_limits<double>::max();
+      hi[k] = -std::numeric_limits<double>::max();
+    }
+
+    for (auto & v : particles) {
+      for (int k=0; k<3; k++) {
+	lo[k] = std::min<double>(lo[k], v.second->pos[k]);
+	hi[k] = std::max<double>(hi[k], v.second->pos[k]);
+      }
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE, lo, 3, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, hi, 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    len = 0.0;
+    for (int k=0; k<3; k++) len = std::max<double>(len, hi[k] - lo[k]);
+    if (len <= 0.0) len = 1.0;
+    len *= 1.0 + 1.0e-12;	// Keep the upper edge inside the cube
+  }
+
+  //
+  // Keys and weights, sorted by key
+  //
+  struct KeyWeight
+  {
+    unsigned long key;
+    double weight;
+    PartPtr p;
+  };
+
+  std::vector<KeyWeight> local;
+  local.reserve(particles.size());
+
+  // The key is the curve index or, in effort mode, the process rank
+  // followed by the local ordinal in index order.  The rank-major key
+  // keeps the current assignment so that only particles near the
+  // process boundaries move.
+  //
+  double wsum = 0.0;
+  for (auto & v : particles) {
+    unsigned long key = v.first;
+    if (useCurve) key = v.second->key = SFC::key(v.second->pos, lo, len, useHilbert);
+    local.push_back({key, v.second->effort, v.second});
+    wsum += v.second->effort;
+  }
+
+  if (not useCurve) {
+    std::sort(local.begin(), local.end(),
+	      [](const KeyWeight& a, const KeyWeight& b)
+	      { return a.key < b.key; });
+    for (size_t i=0; i<local.size(); i++)
+      local[i].key = (static_cast<unsigned long>(myid) << 40) + i;
+  }
+
+  // Fall back to equal weights if no effort has been recorded
+  //
+  double wtot;
+  MPI_Allreduce(&wsum, &wtot, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  if (wtot <= 0.0) {
+    for (auto & v : local) v.weight = 1.0;
+  }
+
+  std::sort(local.begin(), local.end(),
+	    [](const KeyWeight& a, const KeyWeight& b)
+	    { return a.key < b.key; });
+
+  // Cumulative weight below each local particle
+  //
+  std::vector<double> cum(local.size()+1, 0.0);
+  for (size_t i=0; i<local.size(); i++) cum[i+1] = cum[i] + local[i].weight;
+
+  //
+  // Sample sort: each process contributes sfcSample keys at equal
+  // weight quantiles of its own list.  The gathered samples are the
+  // candidate splitters.
+  //
+  int S = std::max<int>(1, sfcSample);
+  std::vector<unsigned long> samples(S, std::numeric_limits<unsigned long>::max());
+
+  if (local.size()) {
+    size_t j = 0;
+    for (int s=0; s<S; s++) {
+      double w = cum.back()*(s + 0.5)/S;
+      while (j+1 < local.size() and cum[j+1] < w) j++;
+      samples[s] = local[j].key;
+    }
+  }
+
+  std::vector<unsigned long> cand(S*numprocs);
+  MPI_Allgather(samples.data(), S, MPI_UNSIGNED_LONG,
+		cand.data(), S, MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+
+  std::sort(cand.begin(), cand.end());
+  cand.erase(std::unique(cand.begin(), cand.end()), cand.end());
+
+  // Global weight strictly below each candidate
+  //
+  std::vector<double> below(cand.size());
+  for (size_t c=0; c<cand.size(); c++) {
+    auto it = std::lower_bound(local.begin(), local.end(), cand[c],
+			       [](const KeyWeight& a, unsigned long k)
+			       { return a.key < k; });
+    below[c] = cum[it - local.begin()];
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, below.data(), below.size(), MPI_DOUBLE,
+		MPI_SUM, MPI_COMM_WORLD);
+
+  double wall = 0.0;
+  for (auto & v : local) wall += v.weight;
+  MPI_Allreduce(MPI_IN_PLACE, &wall, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  //
+  // Splitters: process n gets the keys in [split[n-1], split[n]).
+  // Choose the candidate whose cumulative weight is closest to the
+  // rate-weighted target.
+  //
+  std::vector<unsigned long> split(numprocs-1);
+  double target = 0.0;
+  size_t c = 0;
+  for (int n=0; n<numprocs-1; n++) {
+    target += comp->rates[n]*wall;
+    while (c+1 < cand.size() and
+	   fabs(below[c+1] - target) <= fabs(below[c] - target)) c++;
+    split[n] = cand.size() ? cand[c] : 0;
+  }
+
+  // Keep the curve frame for the drift check
+  //
+  if (useCurve) {
+    sfcSplit = split;
+    for (int k=0; k<3; k++) sfcLo[k] = lo[k];
+    sfcLen   = len;
+    sfcValid = true;
+  }
+
+  //
+  // Destination lists
+  //
+  std::vector<std::vector<PartPtr>> sendlist(numprocs);
+  for (auto & v : local) {
+    int dest = std::upper_bound(split.begin(), split.end(), v.key) - split.begin();
+    if (dest != myid) sendlist[dest].push_back(v.p);
+  }
+  local.clear();
+
+  //
+  // Exchange packed particles with MPI_Alltoallv in rounds small
+  // enough for int byte counts
+  //
+  size_t bsz = pf->getBufsize();
+  size_t cap = std::max<size_t>(1, std::min<size_t>
+				(PFbufsz, INT_MAX/(bsz*numprocs)));
+
+  unsigned rounds = 0;
+  for (auto & v : sendlist)
+    rounds = std::max<unsigned>(rounds, (v.size() + cap - 1)/cap);
+  MPI_Allreduce(MPI_IN_PLACE, &rounds, 1, MPI_UNSIGNED, MPI_MAX, MPI_COMM_WORLD);
+
+  std::vector<int> scnt(numprocs), rcnt(numprocs), sdsp(numprocs), rdsp(numprocs);
+  std::vector<char> sbuf, rbuf;
+  unsigned nsent = 0, nrecv = 0;
+
+  for (unsigned r=0; r<rounds; r++) {
+
+    for (int n=0; n<numprocs; n++) {
+      size_t beg = std::min<size_t>(r*cap, sendlist[n].size());
+      size_t end = std::min<size_t>(beg + cap, sendlist[n].size());
+      scnt[n] = (end - beg)*bsz;
+    }
+
+    MPI_Alltoall(scnt.data(), 1, MPI_INT, rcnt.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+    sdsp[0] = rdsp[0] = 0;
+    for (int n=1; n<numprocs; n++) {
+      sdsp[n] = sdsp[n-1] + scnt[n-1];
+      rdsp[n] = rdsp[n-1] + rcnt[n-1];
+    }
+
+    sbuf.resize(sdsp.back() + scnt.back() + 1);
+    rbuf.resize(rdsp.back() + rcnt.back() + 1);
+
+    for (int n=0; n<numprocs; n++) {
+      size_t beg = std::min<size_t>(r*cap, sendlist[n].size());
+      size_t num = scnt[n]/bsz;
+      for (size_t i=0; i<num; i++) {
+	PartPtr p = sendlist[n][beg+i];
+	pf->particlePack(p, &sbuf[sdsp[n] + i*bsz]);
+	particles.erase(p->indx);
+	nsent++;
+      }
+    }
+
+    MPI_Alltoallv(sbuf.data(), scnt.data(), sdsp.data(), MPI_CHAR,
+		  rbuf.data(), rcnt.data(), rdsp.data(), MPI_CHAR,
+		  MPI_COMM_WORLD);
+
+    for (int n=0; n<numprocs; n++) {
+      size_t num = rcnt[n]/bsz;
+      for (size_t i=0; i<num; i++) {
+	PartPtr p = std::make_shared<Particle>(niattrib, ndattrib);
+	pf->particleUnpack(p, &rbuf[rdsp[n] + i*bsz]);
+	particles[p->indx] = p;
+	nrecv++;
+      }
+    }
+  }
+
+  //
+  // Rebuild the level lists and the process tables
+  //
+  reset_level_lists();
+
+  std::vector<unsigned> nbodies_old = nbodies_table;
+  update_indices();
+
+  //
+  // Weight per process after the exchange
+  //
+  std::vector<double> wproc(numprocs, 0.0);
+  for (auto & v : particles)
+    wproc[myid] += wtot > 0.0 ? v.second->effort : 1.0;
+  MPI_Allreduce(MPI_IN_PLACE, wproc.data(), numprocs, MPI_DOUBLE,
+		MPI_SUM, MPI_COMM_WORLD);
+
+  std::vector<unsigned> moved(2*numprocs, 0), moved1(2*numprocs, 0);
+  moved1[2*myid+0] = nsent;
+  moved1[2*myid+1] = nrecv;
+  MPI_Reduce(moved1.data(), moved.data(), 2*numprocs, MPI_UNSIGNED,
+	     MPI_SUM, 0, MPI_COMM_WORLD);
+
+  if (myid==0) {
+    std::string outrates =
+      outdir + "current.processor.rates." + name + "." + runtag;
+
+    std::ofstream out(outrates, ios::out | ios::app);
+
+    if (out) {
+      out << "# " << endl;
+      out << "# Time=" << tnow << " Component=" << name
+	  << " Decomposition="
+	  << (useCurve ? (useHilbert ? "hilbert" : "morton") : "effort")
+	  << " Candidates=" << cand.size()
+	  << " Trigger=" << trigger << endl;
+      out << "# "
+	  << setw(15) << "Norm rate"
+	  << setw(15) << "Effort frac"
+	  << setw(15) << "Current #"
+	  << setw(15) << "Previous #"
+	  << setw(15) << "Sent"
+	  << setw(15) << "Received"
+	  << endl
+	  << "# "
+	  << setw(15) << "---------"
+	  << setw(15) << "-----------"
+	  << setw(15) << "---------"
+	  << setw(15) << "----------"
+	  << setw(15) << "----"
+	  << setw(15) << "--------"
+	  << endl;
+
+      for (int n=0; n<numprocs; n++)
+	out << "  "
+	    << setw(15) << comp->rates[n]
+	    << setw(15) << wproc[n]/wall
+	    << setw(15) << nbodies_table[n]
+	    << setw(15) << nbodies_old[n]
+	    << setw(15) << moved[2*n+0]
+	    << setw(15) << moved[2*n+1]
+	    << endl;
+    } else {
+      std::cout << "*** ERROR: Component::load_balance_weighted error opening <"
+		<< outrates << ">" << std::endl;
+    }
+  }
+}
+
 template< typename T >
 typename std::vector<T>::iterator 
 insert_sorted( std::vector<T> & vec, T const& item )
@@ -3653,6 +4392,8 @@ insert_sorted( std::vector<T> & vec, T const& item )
 void Component::add_particles(int from, int to, std::vector<PartPtr>& plist)
 {
   unsigned number = plist.size();
+
+  if (soa and (myid==from or myid==to)) soa->invalidate();
   std::vector<PartPtr>::iterator it=plist.begin();
 
   unsigned icount, counter=0;
@@ -3731,10 +4472,15 @@ void Component::add_particles(int from, int to, std::vector<PartPtr>& plist)
 
 bool Component::freeze(unsigned indx)
 {
+  if (rtrunc >= 1.0e20) return false; // No truncation by default
+
+  double pos[3];
+  Pos(pos, indx);		// Routed to the slot arrays if resident
+
   double r2 = 0.0;
   for (int i=0; i<3; i++) r2 += 
-			    (particles[indx]->pos[i] - com0[i] - center[i])*
-			    (particles[indx]->pos[i] - com0[i] - center[i]);
+			    (pos[i] - com0[i] - center[i])*
+			    (pos[i] - com0[i] - center[i]);
   if (r2 > rtrunc*rtrunc) return true;
   else return false;
 }
@@ -3763,6 +4509,8 @@ void Component::redistributeByList(vector<int>& redist)
   // Initialize the particle ferry instance with dynamic attribute sizes
   if (not pf) pf = ParticleFerryPtr(new ParticleFerry(niattrib, ndattrib));
 
+  // The particle list will change
+  if (soa) soa->invalidate();
 
   vector<int>::iterator it = redist.begin();
   vector<unsigned> tlist;
@@ -3861,6 +4609,10 @@ void Component::seq_new_particles()
     return;
   }
 
+  // Slot table must be rebuilt to include the new particles
+  //
+  if (soa) soa->invalidate();
+
   // Begin sequence numbering
   //
   for (int n=0; n<numprocs; n++) {
@@ -3905,6 +4657,7 @@ void Component::seq_new_particles()
 
 void Component::DestroyPart(PartPtr p)
 {
+  if (soa) soa->invalidate();
   particles.erase(p->indx);
 
   // Remove from level list
@@ -3936,6 +4689,7 @@ void Component::DestroyPart(PartPtr p)
 
 void Component::AddPart(PartPtr p)
 {
+  if (soa) soa->invalidate();
   particles[p->indx] = p;
 
   // Refresh size of local particle list
@@ -481,6 +481,11 @@ void ComponentContainer::compute_potential(unsigned mlevel)
   //
   for (auto c : components) c->time_so_far.reset();
 
+  //
+  // Complete the non-blocking coefficient reductions
+  //
+  for (auto c : components) c->force->finish_coefficients();
+
   //
   // Compute accel for each component
   //
@@ -519,6 +524,15 @@ void ComponentContainer::compute_potential(unsigned mlevel)
       fetched[c] = false;
     } else
 #endif
+    if (c->useSoA()) {		// Levels at and above mlevel are a
+				// contiguous slot range
+      ParticleSoA& soa = c->SoA();
+      auto range = soa.levRange(mlevel, multistep);
+      std::fill(soa.potext.begin()+range.first, soa.potext.begin()+range.second, 0.0);
+      std::fill(soa.pot   .begin()+range.first, soa.pot   .begin()+range.second, 0.0);
+      for (int k=0; k<c->dim; k++)
+	std::fill(soa.acc[k].begin()+range.first, soa.acc[k].begin()+range.second, 0.0);
+    } else
       {
 				// Look for particles at this and
 				// successive levels
@@ -809,6 +823,10 @@ void ComponentContainer::compute_potential(unsigned mlevel)
 
   if (timing) timer_extrn.stop();
 
+				// Charge the measured force time to
+				// the active levels
+  for (auto c : components) c->record_force_work(mlevel, c->get_time_sofar());
+
   if (timing) timer_force.stop();
   
 
@@ -1198,8 +1216,8 @@ void ComponentContainer::fix_acceleration(void)
 
   for (auto c : components) {
 
-    pend = c->particles.end();
-    for (p=c->particles.begin(); p != pend; p++) {
+    pend = c->Particles().end();
+    for (p=c->Particles().begin(); p != pend; p++) {
     
       if (c->freeze(p->first)) continue;
 
@@ -1223,8 +1241,8 @@ void ComponentContainer::fix_acceleration(void)
 
   for (auto c : components) {
 
-    pend = c->particles.end();
-    for (p=c->particles.begin(); p != pend; p++) {
+    pend = c->Particles().end();
+    for (p=c->Particles().begin(); p != pend; p++) {
 
       if (c->freeze(p->first)) continue;
       p->second->acc[0] -= axcm;
@@ -1276,8 +1294,8 @@ void ComponentContainer::fix_positions()
 
     for (auto c : components) {
 
-      pend = c->particles.end();
-      for (p=c->particles.begin(); p != pend; p++) {
+      pend = c->Particles().end();
+      for (p=c->Particles().begin(); p != pend; p++) {
     
 	if (c->freeze(p->first)) continue;
 
@@ -1364,7 +1382,7 @@ void ComponentContainer::report_numbers(void)
 	for (auto c : components) {
 	  out << setw(20) << c->Number();
 	  double toteff = 0.0;
-	  for (auto tp : c->particles)
+	  for (auto tp : c->Particles())
 	    toteff += tp.second->effort;
 	  out << setw(20) << toteff;
 	}
@@ -1380,6 +1398,10 @@ void ComponentContainer::load_balance(void)
 {
   if (!nbalance || this_step % nbalance)  return;
 
+				// Per-particle effort over the
+				// balancing interval
+  for (auto c : components) c->update_effort();
+
 				// Query timers
   vector<double> rates1(numprocs, 0.0), trates(numprocs, 0.0);
   rates1[myid] = MPL_read_timer(1);
@@ -1456,13 +1478,47 @@ void ComponentContainer::load_balance(void)
 
 
   if (toobig) {
-
 				// Use new rates
     rates = rates1;
+  }
+				// Initiate load balancing for each
+				// component.  The weighted
+				// decompositions are only redone when
+				// the rates change, the measured
+				// effort is out of balance or the
+				// particles have drifted out of their
+				// key ranges.
+  for (auto c : components) {
+    if (c->decomp != Component::Decomp::count) {
+      double imbalance = c->effort_imbalance();
+      double drift     = c->key_drift();
+
+      std::ostringstream trigger;
+      if (toobig)
+	trigger << "rates";
+      else if (imbalance > dbthresh)
+	trigger << "effort";
+      else if (drift > dbthresh)
+	trigger << "drift";
+
+      if (myid==0) {
+	string outrates = outdir + "current.processor.rates.test." + runtag;
+	ofstream out(outrates.c_str(), ios::out | ios::app);
+	if (out) out << "# Component=" << c->name
+		     << " Effort imbalance=" << imbalance
+		     << " Key drift=" << drift
+		     << (trigger.str().size() ? " -> rebalance" : " -> skipped")
+		     << endl;
+      }
 
-				// Initiate load balancing for each component
-    for (auto c : components) c->load_balance();
-
+      if (trigger.str().size()) {
+	trigger << " (effort imbalance=" << imbalance
+		<< ", key drift=" << drift << ")";
+	c->load_balance_weighted(trigger.str());
+      }
+    }
+    else if (toobig)
+      c->load_balance();
   }
 
 }
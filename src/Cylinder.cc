@@ -77,6 +77,9 @@ Cylinder::valid_keys = {
   "nmax",
   "ncylodd",
   "ncylrecomp",
+  "eof_incremental",
+  "eof_forget",
+  "eof_tol",
   "npca",
   "npca0",
   "nvtk",
@@ -106,7 +109,10 @@ Cylinder::valid_keys = {
   "self_consistent",
   "playback",
   "coefCompute",
-  "coefMaster"
+  "coefMaster",
+  "packed",
+  "packcheck",
+  "node_shared"
 };
 
 Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
@@ -144,6 +150,9 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
   nmax            = 18;
   ncylodd         = 9;
   ncylrecomp      = -1;
+  eof_incremental = false;
+  eof_forget      = 0.5;
+  eof_tol         = 0.01;
 
   rnum            = 200;
   pnum            = 1;
@@ -179,6 +188,9 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
   coefMaster      = true;
   lastPlayTime    = -std::numeric_limits<double>::max();
   EVEN_M          = false;
+  packed          = false;
+  packcheck       = 0;
+  node_shared     = false;
   cachename       = "";
 #if HAVE_LIBCUDA==1
   cuda_aware      = true;
@@ -201,6 +213,7 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
   EmpCylSL::CMAPZ       = cmapZ;
   EmpCylSL::logarithmic = logarithmic;
   EmpCylSL::VFLAG       = vflag;
+  EmpCylSL::node_shared = node_shared;
 
   if (cachename.size()==0)
     throw std::runtime_error("EmpCylSL: you must specify a cachename");
@@ -214,6 +227,8 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
   //
   if (mlim>=0)  ortho->set_mlim(mlim);
   if (EVEN_M)   ortho->setEven(EVEN_M);
+  if (packed)   ortho->setPacked(packed);
+  if (eof_incremental) ortho->setIncremental(true, eof_forget, eof_tol);
   ortho->setSampT(defSampT);
 
   try {
@@ -324,6 +339,8 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
 		<< std::endl << sep << "mlim="        << mlim
 		<< std::endl << sep << "nmax="        << nmax
 		<< std::endl << sep << "ncylodd="     << ncylodd
+		<< std::endl << sep << "ncylrecomp="  << ncylrecomp
+		<< std::endl << sep << "eof_incremental=" << (eof_incremental ? "true" : "false")
 		<< std::endl << sep << "rcylmin="     << rcylmin
 		<< std::endl << sep << "rcylmax="     << rcylmax
 		<< std::endl << sep << "acyl="        << acyl
@@ -352,6 +369,8 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
 	      << std::endl << sep << "mlim="        << mlim
 	      << std::endl << sep << "nmax="        << nmax
 	      << std::endl << sep << "ncylodd="     << ncylodd
+	      << std::endl << sep << "ncylrecomp="  << ncylrecomp
+	      << std::endl << sep << "eof_incremental=" << (eof_incremental ? "true" : "false")
 	      << std::endl << sep << "rcylmin="     << rcylmin
 	      << std::endl << sep << "rcylmax="     << rcylmax
 	      << std::endl << sep << "acyl="        << acyl
@@ -383,6 +402,7 @@ Cylinder::Cylinder(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
 
   pos.resize(nthrds);
   frc.resize(nthrds);
+  blk.resize(nthrds);
 
 #ifdef DEBUG
   offgrid.resize(nthrds);
@@ -424,6 +444,23 @@ void Cylinder::initialize()
     if (conf["nmax"      ])       nmax  = conf["nmax"      ].as<int>();
     if (conf["ncylodd"   ])    ncylodd  = conf["ncylodd"   ].as<int>();
     if (conf["ncylrecomp"]) ncylrecomp  = conf["ncylrecomp"].as<int>();
+    if (conf["eof_incremental"]) eof_incremental = conf["eof_incremental"].as<bool>();
+    if (conf["eof_forget"]) eof_forget  = conf["eof_forget"].as<double>();
+    if (conf["eof_tol"   ])    eof_tol  = conf["eof_tol"   ].as<double>();
+
+    if (eof_forget < 0.0 or eof_forget >= 1.0) {
+      std::ostringstream sout;
+      sout << "Cylinder: eof_forget=" << eof_forget
+	   << " must satisfy 0 <= eof_forget < 1";
+      throw std::runtime_error(sout.str());
+    }
+
+    if (eof_tol < 0.0) {
+      std::ostringstream sout;
+      sout << "Cylinder: eof_tol=" << eof_tol << " must be non-negative";
+      throw std::runtime_error(sout.str());
+    }
+
     if (conf["npca"      ])       npca  = conf["npca"      ].as<int>();
     if (conf["npca0"     ])      npca0  = conf["npca0"     ].as<int>();
     if (conf["nvtk"      ])       nvtk  = conf["nvtk"      ].as<int>();
@@ -449,6 +486,9 @@ void Cylinder::initialize()
     if (conf["cmapr"     ])      cmapR  = conf["cmapr"     ].as<int>();
     if (conf["cmapz"     ])      cmapZ  = conf["cmapz"     ].as<int>();
     if (conf["vflag"     ])      vflag  = conf["vflag"     ].as<int>();
+    if (conf["packed"    ])     packed  = conf["packed"    ].as<bool>();
+    if (conf["packcheck" ])  packcheck  = conf["packcheck" ].as<int>();
+    if (conf["node_shared"]) node_shared = conf["node_shared"].as<bool>();
     
     // Deprecation warning
     if (conf["expcond"]) {
@@ -504,7 +544,7 @@ void Cylinder::initialize()
 	}
       }
 
-      playback = std::dynamic_pointer_cast<CoefClasses::CylCoefs>(CoefClasses::Coefs::factory(file));
+      playback = std::dynamic_pointer_cast<CoefClasses::CylCoefs>(CoefClasses::Coefs::factoryShared(file, node_shared));
 
       if (not playback) {
 	throw GenericError("Cylinder: failure in downcasting",
@@ -689,7 +729,9 @@ void * Cylinder::determine_coefficients_thread(void * arg)
 
     // Will use all of the bodies independent of level
     //
-    nbodies = cC->Number();
+    ParticleSoA *soa = cC->useSoA() ? &cC->SoA() : 0;
+
+    nbodies = soa ? soa->size() : cC->Number();
     
     if (nbodies==0) {
       thread_timing_end(id);
@@ -698,13 +740,23 @@ void * Cylinder::determine_coefficients_thread(void * arg)
     nbeg = nbodies*id/nthrds;
     nend = nbodies*(id+1)/nthrds;
 
-    unsigned indx;
-    PartMapItr n = cC->Particles().begin();
-    for (int i=0; i<nbeg; i++) n++; // Move to beginning iterator
+    unsigned indx, lev;
+    PartMapItr n;
+    if (not soa) {
+      n = cC->Particles().begin();
+      std::advance(n, nbeg);	// Move to beginning iterator
+    }
 
-    for (int i=nbeg; i<nend; i++, n++) {
+    for (int i=nbeg; i<nend; i++) {
 
-      indx = n->first;
+      if (soa) {
+	indx = soa->indx[i];
+	lev  = soa->level[i];
+      } else {
+	indx = n->first;
+	lev  = n->second->level;
+	n++;
+      }
 
       // Frozen particles don't contribute to field
       //
@@ -735,7 +787,7 @@ void * Cylinder::determine_coefficients_thread(void * arg)
 	mas = cC->Mass(indx);
 	phi = atan2(yy, xx);
 
-	ortho->accumulate_eof(r, zz, phi, mas, id, cC->Part(indx)->level);
+	ortho->accumulate_eof(r, zz, phi, mas, id, lev);
 	
 	use[id]++;
 	cylmass0[id] += mas;
@@ -958,6 +1010,10 @@ void Cylinder::determine_coefficients_particles(void)
   if (myid==0) cout << endl;
 #endif
     
+  // Refresh the slot table before forking the threads
+  //
+  if (cC->useSoA()) cC->SoA();
+
 #if HAVE_LIBCUDA==1
   if (component->cudaDevice>=0 and use_cuda) {
     if (cudaAccumOverride) {
@@ -1138,6 +1194,21 @@ void Cylinder::determine_coefficients_eof(void)
   ortho->make_eof();
   if (myid==0) cerr << "Cylinder: eof computed\n";
 
+  if (eof_incremental and myid==0) {
+    auto & changes = ortho->getEOFChanges();
+    int regen = 0, warm = 0, iter = 0;
+    double angle = 0.0;
+    for (auto & c : changes) {
+      if (c.regenerated) regen++;
+      if (c.warm) warm++;
+      iter  = std::max<int>(iter, c.iterations);
+      angle = std::max<double>(angle, c.angle);
+    }
+    cerr << "Cylinder: eof refresh regenerated " << regen << "/"
+	 << changes.size() << " blocks, " << warm << " warm started in <= "
+	 << iter << " iterations, max angle=" << angle << "\n";
+  }
+
   ortho->make_coefficients();
   if (myid==0) cerr << "Cylinder: coefs computed\n";
 
@@ -1210,125 +1281,175 @@ void * Cylinder::determine_acceleration_and_potential_thread(void * arg)
 	 << " nend=" << nend << endl;
 #endif
 
-    for (int q=nbeg; q<nend; q++) {
+    // Process the particles in blocks: pass 1 finds the positions
+    // and blending fractions, the basis is evaluated for all in-grid
+    // points of the block in one call, and pass 2 applies the forces
+    //
+    for (int qbeg=nbeg; qbeg<nend; qbeg+=Block::size) {
 
-      unsigned indx = cC->levlist[lev][q];
+      int nb = std::min<int>(Block::size, nend - qbeg);
+      int ng = 0;		// Number of in-grid points
 
-      // Deep debug
-      /*
-      if (indx<1 || indx>cC->CurTotal()) {
-	cout << "Process " << myid << " id=" << id 
-	     << ": index error in Cylinder q=" << q
-	     << " indx=" << indx << endl;
-      }
-      */
+      // BEG: pass 1
+      for (int j=0; j<nb; j++) {
 
-      if (mix) {
+	unsigned indx = cC->levlist[lev][qbeg+j];
 
-	if (use_external) {
-	  cC->Pos(pos[id].data(), indx, Component::Inertial);
-	  component->ConvertPos(pos[id].data(), Component::Local);
-	} else
-	  cC->Pos(pos[id].data(), indx, Component::Local);
+	if (mix) {
 
-	// Only apply this fraction of the force
-	mfactor = mix->Mixture(pos[id].data());
-	for (int k=0; k<3; k++) pos[id][k] -= ctr[k];
+	  if (use_external) {
+	    cC->Pos(pos[id].data(), indx, Component::Inertial);
+	    component->ConvertPos(pos[id].data(), Component::Local);
+	  } else
+	    cC->Pos(pos[id].data(), indx, Component::Local);
 
-      } else {
+	  // Only apply this fraction of the force
+	  mfactor = mix->Mixture(pos[id].data());
+	  for (int k=0; k<3; k++) pos[id][k] -= ctr[k];
 
-	if (use_external) {
-	  cC->Pos(pos[id].data(), indx, Component::Inertial);
-	  component->ConvertPos(pos[id].data(), Component::Local | Component::Centered);
-	} else
-	  cC->Pos(pos[id].data(), indx, Component::Local | Component::Centered);
+	} else {
 
-      }
+	  if (use_external) {
+	    cC->Pos(pos[id].data(), indx, Component::Inertial);
+	    component->ConvertPos(pos[id].data(), Component::Local | Component::Centered);
+	  } else
+	    cC->Pos(pos[id].data(), indx, Component::Local | Component::Centered);
 
-      if ( (component->EJ & Orient::AXIS) && !component->EJdryrun) 
-	pos[id] = component->orient->transformBody() * pos[id];
+	}
 
-      xx    = pos[id][0];
-      yy    = pos[id][1];
-      zz    = pos[id][2];
+	if ( (component->EJ & Orient::AXIS) && !component->EJdryrun) 
+	  pos[id] = component->orient->transformBody() * pos[id];
+
+	xx    = pos[id][0];
+	yy    = pos[id][1];
+	zz    = pos[id][2];
       
-      r2    = xx*xx + yy*yy;
-      r     = sqrt(r2) + DSMALL;
-      phi   = atan2(yy, xx);
-      pa    = 0.0;
+	r2    = xx*xx + yy*yy;
+	r     = sqrt(r2) + DSMALL;
+	phi   = atan2(yy, xx);
+
+	ratio = sqrt( (r2 + zz*zz)/R2 );
+
+	if (ratio >= 1.0) {
+	  frac  = 0.0;
+	  cfrac = 1.0;
+	} else if (ratio > ratmin) {
+	  frac  = 0.5*(1.0 - erf( (ratio - midpt)/rsmth ));
+	  cfrac = 1.0 - frac;
+	} else {
+	  cfrac = 0.0;
+	  frac  = 1.0;
+	}
+	
+	auto & b = blk[id];
+
+	b.indx [j] = indx;
+	b.x    [j] = xx;
+	b.y    [j] = yy;
+	b.z    [j] = zz;
+	b.r    [j] = r;
+	b.ratio[j] = ratio;
+	b.frac [j] = frac  * mfactor;
+	b.cfrac[j] = cfrac * mfactor;
+	b.grid [j] = -1;
+
+	if (ratio < 1.0) {
+	  b.grid[j]  = ng;
+	  b.gr  [ng] = r;
+	  b.gz  [ng] = zz;
+	  b.gphi[ng] = phi;
+	  ng++;
+	}
+      }
+      // END: pass 1
+
+      auto & b = blk[id];
+
+      // Basis fields for the in-grid points of the block
+      //
+      ortho->accumulated_eval_batch(ng, b.gr.data(), b.gz.data(), b.gphi.data(),
+				    b.p0.data(), b.p.data(),
+				    b.fr.data(), b.fz.data(), b.fp.data());
 
-      ratio = sqrt( (r2 + zz*zz)/R2 );
+      // BEG: pass 2
+      for (int j=0; j<nb; j++) {
+
+	unsigned indx = b.indx[j];
+
+	xx    = b.x[j];
+	yy    = b.y[j];
+	zz    = b.z[j];
+	r     = b.r[j];
+	r2    = xx*xx + yy*yy;
+	ratio = b.ratio[j];
+	frac  = b.frac[j];
+	cfrac = b.cfrac[j];
+	pa    = 0.0;
 
-      if (ratio >= 1.0) {
-	frac       = 0.0;
-	cfrac      = 1.0;
 	frc[id][0] = 0.0;
 	frc[id][1] = 0.0;
 	frc[id][2] = 0.0;
-      } else if (ratio > ratmin) {
-	frac  = 0.5*(1.0 - erf( (ratio - midpt)/rsmth ));
-	cfrac = 1.0 - frac;
-      } else {
-	cfrac = 0.0;
-	frac  = 1.0;
-      }
-	
-      cfrac *= mfactor;
-      frac  *= mfactor;
 
-      if (ratio < 1.0) {
+	if (ratio < 1.0) {
 
-	ortho->accumulated_eval(r, zz, phi, p0, p, fr, fz, fp);
+	  int g = b.grid[j];
+	  p  = b.p [g];
+	  fr = b.fr[g];
+	  fz = b.fz[g];
+	  fp = b.fp[g];
 #ifdef DEBUG
-	check_force_values(phi, p, fr, fz, fp);
+	  check_force_values(b.gphi[g], p, fr, fz, fp);
 #endif
-	frc[id][0] = ( fr*xx/r - fp*yy/r2 ) * frac;
-	frc[id][1] = ( fr*yy/r + fp*xx/r2 ) * frac;
-	frc[id][2] = fz * frac;
-	pa         = p  * frac;
+	  frc[id][0] = ( fr*xx/r - fp*yy/r2 ) * frac;
+	  frc[id][1] = ( fr*yy/r + fp*xx/r2 ) * frac;
+	  frc[id][2] = fz * frac;
+	  pa         = p  * frac;
 	
 #ifdef DEBUG
-	flg = 1;
+	  flg = 1;
 #endif
-      }
+	}
 
-      if (ratio > ratmin) {
+	if (ratio > ratmin) {
 
-	r3 = r2 + zz*zz;
-	p = -cylmass/sqrt(r3);	// -M/r
-	fr = p/r3;		// -M/r^3
+	  r3 = r2 + zz*zz;
+	  p = -cylmass/sqrt(r3);	// -M/r
+	  fr = p/r3;		// -M/r^3
 
-	frc[id][0] += xx*fr * cfrac;
-	frc[id][1] += yy*fr * cfrac;
-	frc[id][2] += zz*fr * cfrac;
-	pa         += p     * cfrac;
+	  frc[id][0] += xx*fr * cfrac;
+	  frc[id][1] += yy*fr * cfrac;
+	  frc[id][2] += zz*fr * cfrac;
+	  pa         += p     * cfrac;
 
 #ifdef DEBUG
-	offgrid[id]++;
-	flg = 2;
+	  offgrid[id]++;
+	  flg = 2;
 #endif
-      }
+	}
     
-      cC->AddPot(indx, pa);
+	cC->AddPot(indx, pa);
 
-      if ( (component->EJ & Orient::AXIS) && !component->EJdryrun) 
-	frc[id] = component->orient->transformOrig() * frc[id];
+	if ( (component->EJ & Orient::AXIS) && !component->EJdryrun) 
+	  frc[id] = component->orient->transformOrig() * frc[id];
 
-      for (int j=0; j<3; j++) cC->AddAcc(indx, j, frc[id][j]);
+	for (int k=0; k<3; k++) cC->AddAcc(indx, k, frc[id][k]);
 
 #ifdef DEBUG
-      if (firstime && myid==0 && id==0 && q < 5) {
-	out << setw(9)  << q          << endl
-	    << setw(9)  << indx       << endl
-	    << setw(9)  << flg        << endl
-	    << setw(18) << xx         << endl
-	    << setw(18) << yy         << endl
-	    << setw(18) << zz         << endl
-	    << setw(18) << frc[0][0]  << endl
-	    << setw(18) << frc[0][1]  << endl
-	    << setw(18) << frc[0][2]  << endl;
-      }
+	int q = qbeg + j;
+	if (firstime && myid==0 && id==0 && q < 5) {
+	  out << setw(9)  << q          << endl
+	      << setw(9)  << indx       << endl
+	      << setw(9)  << flg        << endl
+	      << setw(18) << xx         << endl
+	      << setw(18) << yy         << endl
+	      << setw(18) << zz         << endl
+	      << setw(18) << frc[0][0]  << endl
+	      << setw(18) << frc[0][1]  << endl
+	      << setw(18) << frc[0][2]  << endl;
+	}
 #endif
+      }
+      // END: pass 2
     }
   }
 
@@ -1368,6 +1489,16 @@ void Cylinder::determine_acceleration_and_potential(void)
 
   }
 
+  // Rebuild the node-interleaved tables if the EOF has changed
+  //
+  if (packed) {
+    ortho->pack_tables();
+    if (packcheck>0) {
+      ortho->validate_packed(packcheck);
+      packcheck = 0;		// Only check once
+    }
+  }
+
 #ifdef DEBUG
   for (int i=0; i<nthrds; i++) offgrid[i] = 0;
   cout << "Process " << myid << ": about to fork" << endl;
@@ -18,7 +18,9 @@ Direct::valid_keys = {
   "pm_model",
   "diverge",
   "diverge_rfac",
-  "pmmodel_file"
+  "pmmodel_file",
+  "simd",
+  "mixed"
 };
 
 Direct::Direct(Component* c0, const YAML::Node& conf) : PotAccel(c0, conf)
@@ -43,6 +45,12 @@ Direct::Direct(Component* c0, const YAML::Node& conf) : PotAccel(c0, conf)
   diverge      = 0;	            // Use analytic divergence (true/false)
   diverge_rfac = 1.0;               // Exponent for profile divergence
 
+  // Pair kernel
+  //
+  plummer  = false;		// Spline by default
+  use_simd = true;		// Blocked SIMD kernel
+  mixed    = false;		// Double precision pairs
+
   initialize();
 
   if (pm_model) pmmodel = new SphericalModelTable(pmmodel_file, diverge, diverge_rfac);
@@ -51,15 +59,13 @@ Direct::Direct(Component* c0, const YAML::Node& conf) : PotAccel(c0, conf)
   to_proc = (myid+1) % numprocs;
   from_proc = (myid+numprocs-1) % numprocs;
 
-				// Buffer pointers
-  tmp_buffer = NULL;
+				// Buffer pointer
   bod_buffer = NULL;
 }
 
 Direct::~Direct()
 {
-  delete [] tmp_buffer;
-  delete [] bod_buffer;
+  // Nothing
 }
 
 void Direct::initialize(void)
@@ -86,7 +92,10 @@ void Direct::initialize(void)
     if (conf["type"]) {
       std::string type = conf["type"].as<std::string>();
       if (type.compare("Spline") == 0) kernel = std::make_shared<SplineSoft>();
-      else                             kernel = std::make_shared<PlummerSoft>();
+      else {
+	kernel  = std::make_shared<PlummerSoft>();
+	plummer = true;
+      }
     } else {
       kernel = std::make_shared<SplineSoft>();
       if (myid==0) std::cout << "Direct: using SplineSoft" << std::endl;
@@ -100,6 +109,9 @@ void Direct::initialize(void)
     if (conf["diverge"])          diverge      = conf["diverge"].as<int>();
     if (conf["diverge_rfac"])     diverge_rfac = conf["diverge_rfac"].as<double>();
     if (conf["pmmodel_file"])     pmmodel_file = conf["pmmodel_file"].as<std::string>();
+
+    if (conf["simd"])             use_simd     = conf["simd"].as<bool>();
+    if (conf["mixed"])            mixed        = conf["mixed"].as<bool>();
   }
   catch (YAML::Exception & error) {
     if (myid==0) std::cout << "Error parsing parameters in Direct: "
@@ -153,58 +165,57 @@ void Direct::determine_acceleration_and_potential(void)
 #endif
   
 				// Allocate buffers to handle largest list
-  delete [] tmp_buffer;
-  delete [] bod_buffer;
-
   int buffer_size = max_bodies*ndim;
-  tmp_buffer = new double [buffer_size];
-  bod_buffer = new double [buffer_size];
-  
-  // Load body buffer with local interactors
-  double *p = bod_buffer;
+  for (auto & v : ring) v.resize(buffer_size);
+
+  // Load body buffer with local interactors as a structure of
+  // arrays with stride ninteract
+  //
+  int cur = 0;
+  double *p = ring[cur].data();
   unsigned long i;
   PartMapItr it = component->Particles().begin();
 
   for (int q=0; q<ninteract; q++) {
     i = (it++)->first;
-    *(p++) = component->Mass(i);
-    *(p++) = component->Pos(i, 0);
-    *(p++) = component->Pos(i, 1);
-    *(p++) = component->Pos(i, 2);
-    if (!fixed_soft) *(p++) = component->Part(i)->dattrib[soft_indx];
+    p[0*ninteract + q] = component->Mass(i);
+    p[1*ninteract + q] = component->Pos(i, 0);
+    p[2*ninteract + q] = component->Pos(i, 1);
+    p[3*ninteract + q] = component->Pos(i, 2);
+    if (!fixed_soft) p[4*ninteract + q] = component->Part(i)->dattrib[soft_indx];
   }
 
-				// Do the local interactors
-  exp_thread_fork(false);
+  // Do the ring.  The block in ring[cur] is passed on and used for
+  // the local accelerations while the next block is received into
+  // the other buffer.
+  //
+  for (int n=1; n<=numprocs; n++) {
 
-				// Do the ring . . . 
-  for (int n=1; n<numprocs; n++) {
-      
-    MPI_Request req1, req2;
-    MPI_Status stat;
-    
-				// Copy current to temp buffer
-    memcpy(tmp_buffer, bod_buffer, buffer_size*sizeof(double));
+    MPI_Request req[2];
+    MPI_Status stat[2];
+    int nsend = ninteract;
 
+    if (n<numprocs) {
 				// Get NEW buffer from right
-    MPI_Irecv(bod_buffer, buffer_size, MPI_DOUBLE, from_proc, MSGTAG, 
-	      MPI_COMM_WORLD, &req1);
-
-				// Send OLD buffer to left
-    MPI_Isend(tmp_buffer, ninteract*ndim, MPI_DOUBLE, to_proc, MSGTAG, 
-	      MPI_COMM_WORLD, &req2);
-
-    MPI_Wait(&req2, &stat);
-    MPI_Wait(&req1, &stat);
-
-				// How many particles did we get?
-    MPI_Get_count(&stat, MPI_DOUBLE, &ninteract);
-    ninteract /= ndim;
-	
+      MPI_Irecv(ring[1-cur].data(), buffer_size, MPI_DOUBLE, from_proc, MSGTAG,
+		MPI_COMM_WORLD, &req[0]);
+				// Send current buffer to left
+      MPI_Isend(ring[cur].data(), nsend*ndim, MPI_DOUBLE, to_proc, MSGTAG,
+		MPI_COMM_WORLD, &req[1]);
+    }
 				// Accumulate the interactions
+    bod_buffer = ring[cur].data();
     exp_thread_fork(false);
 
+    if (n<numprocs) {
+      MPI_Waitall(2, req, stat);
+				// How many particles did we get?
+      MPI_Get_count(&stat[0], MPI_DOUBLE, &ninteract);
+      ninteract /= ndim;
+      cur = 1 - cur;
+    }
   }
+
 				// Clear external potential flag
   use_external = false;
 }
@@ -215,6 +226,19 @@ void * Direct::determine_acceleration_and_potential_thread(void * arg)
 
   int id = *((int*)arg);
 
+  if (use_simd and not mn_model and not pm_model) {
+    simd_thread(id);
+    return (NULL);
+  }
+
+  // Fields of the current ring block
+  //
+  const double *bm = bod_buffer;
+  const double *bx = bm + ninteract;
+  const double *by = bx + ninteract;
+  const double *bz = by + ninteract;
+  const double *be = bz + ninteract;
+
 #ifdef DEBUG
   double tclausius[nthrds];
   for (int i=0; i<nthrds; i++) tclausius[id] = 0.0;
@@ -240,14 +264,15 @@ void * Direct::determine_acceleration_and_potential_thread(void * arg)
       if (cC->freeze(j)) continue;
     
 				// Loop through the particle list
-      double * p = bod_buffer;
       for (int n=0; n<ninteract; n++) {
 
 				// Get current interaction particle
 				// mass from ring buffer
-	double mass = *(p++) * adb;
+	double mass = bm[n] * adb;
 				// Position
-	for (int k=0; k<3; k++) pos[k] = *(p++);
+	pos[0] = bx[n];
+	pos[1] = by[n];
+	pos[2] = bz[n];
 	
 	// Compute interparticle squared distance
 	//
@@ -303,7 +328,7 @@ void * Direct::determine_acceleration_and_potential_thread(void * arg)
 	  // BEG: Spherical point mass
 	  else {
 	  
-	    if (!fixed_soft) eps = *(p++);
+	    if (!fixed_soft) eps = be[n];
 
 				// Extended model for point masses
                                 // Given model provides normalized mass distrbution
@@ -358,6 +383,106 @@ void * Direct::determine_acceleration_and_potential_thread(void * arg)
   return (NULL);
 }
 
+template<typename T, class K>
+void Direct::pair_sum(const double* xi, double adb, int beg, int end,
+		      double* acc)
+{
+  const double *bm = bod_buffer;
+  const double *bx = bm + ninteract;
+  const double *by = bx + ninteract;
+  const double *bz = by + ninteract;
+  const double *be = fixed_soft ? nullptr : bz + ninteract;
+
+  const T eps0 = soft, tol = rtol;
+  const double x0 = xi[0], y0 = xi[1], z0 = xi[2];
+
+  double sx = 0.0, sy = 0.0, sz = 0.0, sp = 0.0;
+
+#pragma omp simd reduction(+:sx,sy,sz,sp)
+  for (int n=beg; n<end; n++) {
+				// Separation (differences in double)
+    T dx = x0 - bx[n];
+    T dy = y0 - by[n];
+    T dz = z0 - bz[n];
+    T rr = std::sqrt(dx*dx + dy*dy + dz*dz);
+    T eps = be ? T(be[n]) : eps0;
+				// Mask the particle at the current
+				// location
+    bool ok = rr > tol;
+    T r = ok ? rr : T(1);
+
+    T mfrac, pv;
+    K::template eval<T>(r, eps, mfrac, pv);
+
+    T mass = bm[n]*adb;
+    T fac  = ok ? -mass*mfrac/(r*r*r) : T(0);
+
+    sx += fac*dx;
+    sy += fac*dy;
+    sz += fac*dz;
+    sp += ok ? mass*pv : T(0);
+  }
+
+  acc[0] += sx;
+  acc[1] += sy;
+  acc[2] += sz;
+  acc[3] += sp;
+}
+
+void Direct::simd_thread(int id)
+{
+  double adb = component->Adiabatic();
+
+  // Active targets for this thread: if we are multistepping, compute
+  // accel only at or above <mlevel>
+  //
+  std::vector<unsigned long> targ;
+  for (int lev=mlevel; lev<=multistep; lev++) {
+
+    unsigned nbodies = cC->levlist[lev].size();
+    int nbeg = nbodies*id/nthrds;
+    int nend = nbodies*(id+1)/nthrds;
+
+    for (int i=nbeg; i<nend; i++) {
+				// Index of the current local particle
+      unsigned long j = cC->levlist[lev][i];
+
+				// Don't need acceleration for frozen particles
+      if (not cC->freeze(j)) targ.push_back(j);
+    }
+  }
+
+  int ntarg = targ.size();
+  std::vector<double> pos(3*ntarg), acc(4*ntarg, 0.0);
+  for (int t=0; t<ntarg; t++) {
+    for (int k=0; k<3; k++) pos[3*t+k] = cC->Pos(targ[t], k);
+  }
+
+  // Sweep the ring block in tiles that stay in cache for all targets
+  //
+  for (int beg=0; beg<ninteract; beg+=tileSize) {
+    int end = std::min<int>(beg + tileSize, ninteract);
+
+    for (int t=0; t<ntarg; t++) {
+      if (mixed) {
+	if (plummer) pair_sum<float, PlummerSoft>(&pos[3*t], adb, beg, end, &acc[4*t]);
+	else         pair_sum<float, SplineSoft> (&pos[3*t], adb, beg, end, &acc[4*t]);
+      } else {
+	if (plummer) pair_sum<double, PlummerSoft>(&pos[3*t], adb, beg, end, &acc[4*t]);
+	else         pair_sum<double, SplineSoft> (&pos[3*t], adb, beg, end, &acc[4*t]);
+      }
+    }
+  }
+
+  for (int t=0; t<ntarg; t++) {
+    unsigned long j = targ[t];
+    cC->AddAcc(j, 0, acc[4*t+0]);
+    cC->AddAcc(j, 1, acc[4*t+1]);
+    cC->AddAcc(j, 2, acc[4*t+2]);
+    cC->AddPot(j, acc[4*t+3]);
+  }
+}
+
 void Direct::determine_coefficients(void) {}
 void * Direct::determine_coefficients_thread(void *arg) { return (NULL); }
 
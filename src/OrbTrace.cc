@@ -3,6 +3,10 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <limits>
+#include <cmath>
+
+#include <highfive/highfive.hpp>
 
 #include <expand.H>
 
@@ -21,6 +25,7 @@ OrbTrace::valid_keys = {
   "use_pot",
   "use_lev",
   "local",
+  "format",
   "name"
 };
 
@@ -35,8 +40,9 @@ OrbTrace::OrbTrace(const YAML::Node& conf) : Output(conf)
   use_pot = false;
   use_lev = false;
   local   = false;
+  format  = "ascii";
 
-  filename = outdir + "ORBTRACE." + runtag;
+  filename = "";
   orbitlist = "";
   tcomp = NULL;
 
@@ -46,6 +52,18 @@ OrbTrace::OrbTrace(const YAML::Node& conf) : Output(conf)
   //
   if (nintsub <= 0) nintsub = 1;
 
+  if (format != "ascii" and format != "hdf5") {
+    throw GenericError("OrbTrace: format must be <ascii> or <hdf5>",
+		       __FILE__, __LINE__, 1035, false);
+  }
+
+  hdf5 = format == "hdf5";
+
+  if (filename.size()==0) {
+    filename = outdir + "ORBTRACE." + runtag;
+    if (hdf5) filename += ".h5";
+  }
+
   if (!tcomp) {
     throw GenericError("OrbTrace: no component to trace", __FILE__, __LINE__,
 		       1035, false);
@@ -91,15 +109,20 @@ OrbTrace::OrbTrace(const YAML::Node& conf) : Output(conf)
 	 << "[" << tcomp->id << "]\n";
   }
 
-  nbuf = 6;
-  if (use_acc) nbuf += 3;
-  if (use_pot) nbuf += 1;
-  if (use_lev) nbuf += 1;
-  
+  fields = {"x", "y", "z", "u", "v", "w"};
+  if (use_acc) fields.insert(fields.end(), {"ax", "ay", "az"});
+  if (use_pot) fields.push_back("pot");
+  if (use_lev) fields.push_back("lev");
+
+  nbuf = fields.size();
 
-  pbuf = vector<double>(nbuf);
+  // Orbit positions for each traced index
+  //
+  for (int i=0; i<norb; i++) orbpos[orblist[i]].push_back(i);
+
+  if (myid==0 && norb && hdf5) initH5();
 
-  if (myid==0 && norb) {
+  if (myid==0 && norb && not hdf5) {
 
     if (restart) {
       
@@ -228,6 +251,7 @@ void OrbTrace::initialize()
     if (conf["use_pot"])     use_pot   = conf["use_pot"].as<bool>();
     if (conf["use_lev"])     use_lev   = conf["use_lev"].as<bool>();
     if (conf["local"])       local     = conf["local"].as<bool>();
+    if (conf["format"])      format    = conf["format"].as<std::string>();
     
 				// Sanity check
     if (nintsub <= 0) nintsub = 1;
@@ -252,6 +276,75 @@ void OrbTrace::initialize()
   }
 }
 
+void OrbTrace::initH5()
+{
+  try {
+    HighFive::SilenceHDF5 quiet;
+
+    if (restart and std::ifstream(filename).good()) {
+
+      // Drop the rows after the restart time
+      //
+      HighFive::File file(filename, HighFive::File::ReadWrite);
+
+      auto tds = file.getDataSet("time");
+      auto ods = file.getDataSet("orbits");
+
+      std::vector<double> T;
+      tds.read(T);
+
+      size_t keep = 0;
+      while (keep < T.size() and T[keep] <= tnow) keep++;
+
+      auto dims = ods.getDimensions();
+      if (dims[1] != size_t(norb) or dims[2] != size_t(nbuf)) {
+	std::ostringstream message;
+	message << "OrbTrace: trace file <" << filename << "> has "
+		<< dims[1] << " orbits with " << dims[2]
+		<< " fields but this run traces " << norb << " with "
+		<< nbuf;
+	throw GenericError(message.str(), __FILE__, __LINE__, 1035, true);
+      }
+
+      tds.resize({keep});
+      ods.resize({keep, dims[1], dims[2]});
+
+      return;
+    }
+
+    // New file: time x orbit x field, unlimited in time
+    //
+    HighFive::File file(filename, HighFive::File::Overwrite);
+
+    std::string cname = tcomp->name;
+    file.createAttribute<std::string>("component", HighFive::DataSpace::From(cname)).write(cname);
+    file.createAttribute<std::string>("fields", HighFive::DataSpace::From(fields)).write(fields);
+
+    std::vector<unsigned long> index(orblist.begin(), orblist.end());
+    file.createDataSet("index", index);
+
+    const size_t U = HighFive::DataSpace::UNLIMITED;
+
+    HighFive::DataSetCreateProps tprops;
+    tprops.add(HighFive::Chunking(std::vector<hsize_t>{1024}));
+    file.createDataSet<double>("time", HighFive::DataSpace({0}, {U}), tprops);
+
+    HighFive::DataSetCreateProps oprops;
+    oprops.add(HighFive::Chunking(std::vector<hsize_t>
+				  {1, std::min<hsize_t>(norb, 8192), hsize_t(nbuf)}));
+    file.createDataSet<double>
+      ("orbits",
+       HighFive::DataSpace({0, size_t(norb), size_t(nbuf)}, {U, size_t(norb), size_t(nbuf)}),
+       oprops);
+  }
+  catch (HighFive::Exception& err) {
+    std::ostringstream message;
+    message << "OrbTrace: error initializing <" << filename << ">: "
+	    << err.what();
+    throw GenericError(message.str(), __FILE__, __LINE__, 1035, true);
+  }
+}
+
 void OrbTrace::Run(int n, int mstep, bool last)
 {
   if (n % nint && !last && !tcomp && norb) return;
@@ -260,8 +353,6 @@ void OrbTrace::Run(int n, int mstep, bool last)
 
   prev = tnow;			// Record current time
 
-  MPI_Status status;
-
 #ifdef HAVE_LIBCUDA
   if (use_cuda) {
     if (tcomp->force->cudaAware() and not comp->fetched[tcomp]) {
@@ -271,71 +362,98 @@ void OrbTrace::Run(int n, int mstep, bool last)
   }
 #endif
 
-				// Open output file
-  std::ofstream out;
-  if (myid==0) {
-    out.open(filename.c_str(), ios::out | ios::app);
-    if (!out) {
-      std::cout << "OrbTrace: can't open file <" << filename
-		<< ">" << std::endl;
+  // Pack the local traced particles: the orbit position followed by
+  // the fields.  Look up the traced indices or scan the local
+  // particles, whichever is fewer.
+  //
+  std::vector<double> sendbuf;
+
+  auto pack = [&](PartMap::iterator it)
+  {
+    auto ip = orbpos.find(it->first);
+    if (ip == orbpos.end()) return;
+
+    unsigned long indx = it->first;
+    for (int i : ip->second) {
+      sendbuf.push_back(i);
+      for (int k=0; k<3; k++) sendbuf.push_back(tcomp->Pos(indx, k, flags));
+      for (int k=0; k<3; k++) sendbuf.push_back(tcomp->Vel(indx, k, flags));
+      if (use_acc) {
+	for (int k=0; k<3; k++) sendbuf.push_back(tcomp->Acc(indx, k, flags));
+      }
+      if (use_pot) sendbuf.push_back(it->second->pot + it->second->potext);
+      if (use_lev) sendbuf.push_back(it->second->level);
+    }
+  };
+
+  if (orbpos.size() < tcomp->Particles().size()) {
+    for (auto & v : orbpos) {
+      auto it = tcomp->Particles().find(v.first);
+      if (it != tcomp->Particles().end()) pack(it);
     }
-    if (out) out << std::setw(15) << tnow;
+  } else {
+    for (auto it=tcomp->Particles().begin(); it!=tcomp->Particles().end(); it++)
+      pack(it);
   }
 
-  int curproc, nflag;
-  PartMapItr it; 
+  // One gather of all traced states to the root
+  //
+  int nloc = sendbuf.size();
+  std::vector<int> counts(numprocs), displ(numprocs, 0);
+  MPI_Gather(&nloc, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
 
-  for (int i=0; i<norb; i++) {
+  std::vector<double> recv;
+  if (myid==0) {
+    for (int i=1; i<numprocs; i++) displ[i] = displ[i-1] + counts[i-1];
+    recv.resize(displ[numprocs-1] + counts[numprocs-1]);
+  }
 
-    nflag = -1;
-    if ( (it=tcomp->particles.find(orblist[i])) != tcomp->particles.end())
-      nflag = myid;
+  MPI_Gatherv(sendbuf.data(), nloc, MPI_DOUBLE,
+	      recv.data(), counts.data(), displ.data(), MPI_DOUBLE,
+	      0, MPI_COMM_WORLD);
 
-    MPI_Allreduce(&nflag, &curproc, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  if (myid) return;
 
-    if (curproc == myid) {
-      
-      // Copy particle to buffer
-      int icnt=0;
-      for (int k=0; k<3; k++) pbuf[icnt++] = tcomp->Pos(orblist[i], k, flags);
-      for (int k=0; k<3; k++) pbuf[icnt++] = tcomp->Vel(orblist[i], k, flags);
-      if (use_acc) {
-	for (int k=0; k<3; k++) pbuf[icnt++] = tcomp->Acc(orblist[i], k, flags);
-      }
-      if (use_pot) {
-	pbuf[icnt++] = it->second->pot + it->second->potext;
-      }
-      if (use_lev) {
-	pbuf[icnt++] = it->second->level;
-      }
+  // Orbit x field table; orbits that were not found are NaN
+  //
+  table.assign(norb*nbuf, std::numeric_limits<double>::quiet_NaN());
+  for (size_t j=0; j<recv.size(); j+=nbuf+1) {
+    int i = recv[j];
+    std::copy(&recv[j+1], &recv[j+1] + nbuf, &table[i*nbuf]);
+  }
 
-#ifdef DEBUG
-      std::cout << "Process " << myid << ": packing particle #" << orblist[i]
-	   << "  index=" << it->second->indx;
-      for (int k=0; k<3; k++) 
-	std::cout << " " << 
-	  it->second->pos[k];
-      std::cout << std::endl;
-#endif 
-    } 
-
-    if (curproc) {		// Get particle from nodes
-      
-      if (myid==curproc) {	// Send
-	MPI_Send(&pbuf[0], nbuf, MPI_DOUBLE, 0, 71, MPI_COMM_WORLD);
-      }
+  if (hdf5) {
+    try {
+      HighFive::SilenceHDF5 quiet;
+      HighFive::File file(filename, HighFive::File::ReadWrite);
 
-      if (myid==0) { 		// Receive
-	MPI_Recv(&pbuf[0], nbuf, MPI_DOUBLE, curproc, 71, MPI_COMM_WORLD,
-		 &status);
-      }
+      auto tds = file.getDataSet("time");
+      auto ods = file.getDataSet("orbits");
+
+      size_t T = tds.getDimensions()[0];
+
+      tds.resize({T+1});
+      ods.resize({T+1, size_t(norb), size_t(nbuf)});
+
+      tds.select({T}, {1}).write_raw(&tnow);
+      ods.select({T, 0, 0}, {1, size_t(norb), size_t(nbuf)}).write_raw(table.data());
     }
-				// Print the particle buffer
-    if (myid==0 && out) {
-      for (int k=0; k<nbuf; k++) out << setw(15) << pbuf[k];
+    catch (HighFive::Exception& err) {
+      std::cout << "OrbTrace: error writing <" << filename << ">: "
+		<< err.what() << std::endl;
     }
-    
+    return;
   }
-  
-  if (myid==0 && out) out << std::endl;
+
+				// Open output file
+  std::ofstream out(filename.c_str(), ios::out | ios::app);
+  if (!out) {
+    std::cout << "OrbTrace: can't open file <" << filename
+	      << ">" << std::endl;
+    return;
+  }
+
+  out << std::setw(15) << tnow;
+  for (auto v : table) out << setw(15) << v;
+  out << std::endl;
 }
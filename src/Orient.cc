@@ -13,6 +13,7 @@
 #endif
 
 #include <Orient.H>
+#include <ParallelQuantile.H>
 
 
 void EL3::debug() const 
@@ -314,79 +315,104 @@ Orient::Orient(int n, int nwant, unsigned Oflg, unsigned Cflg,
 void Orient::accumulate_cpu(double time, Component *c)
 {
   double energy, mass, v2;
-  unsigned nbodies = c->Number();
-  PartMapItr it = c->Particles().begin();
-  unsigned tkeep = many/numprocs;
-  set<EL3, ltEL3>::reverse_iterator el3last = angm.rbegin();
+
+  // Walk the slots of a component held in the slot arrays: asking
+  // for the particle map would copy the fields back every step
+  //
+  ParticleSoA* soa = c->useSoA() ? &c->SoA() : nullptr;
+  unsigned nbodies = soa ? soa->size() : c->Number();
+  PartMapItr it;
+  if (not soa) it = c->Particles().begin();
+
+  // As in the GPU version: compute the energy of every particle and
+  // keep the lowest.  No process can hold more than _many_ of the
+  // global lowest _many_, so keeping that number locally makes the
+  // distributed cut in accumulate() exact.
+  //
+  unsigned tkeep = many + 1;
+
+  std::vector<std::pair<double, unsigned long>> elist(nbodies);
 
   for (unsigned q=0; q<nbodies; q++) {
 
-    unsigned long i = (it++)->first;
-    Particle     *p = c->Part(i);
+    unsigned long i;
+    double pot, potext;
+
+    if (soa) {
+      i      = soa->indx[q];
+      pot    = soa->pot[q];
+      potext = soa->potext[q];
+    } else {
+      Particle *p = (it++)->second.get();
+      i      = p->indx;
+      pot    = p->pot;
+      potext = p->potext;
+    }
 
     v2 = 0.0;
     for (int k=0; k<3; k++) {
-      pos[k] = c->Pos(i, k, Component::Local);
-      if (std::isnan(pos[k])) {
+      double x = c->Pos(i, k, Component::Local);
+      if (std::isnan(x)) {
 	cerr << "Orient: process " << myid << " index=" << i
 	     << " has NaN on component ";
 	for (int s=0; s<3; s++)
-	  cerr << setw(16) << p->pos[s];
+	  cerr << setw(16) << c->Pos(i, s);
 	for (int s=0; s<3; s++)
-	  cerr << setw(16) << p->vel[s];
+	  cerr << setw(16) << c->Vel(i, s);
 	for (int s=0; s<3; s++)
-	  cerr << setw(16) << p->acc[s];
+	  cerr << setw(16) << c->Acc(i, s);
 	cerr << endl;
       }
-      vel[k] = c->Vel(i, k, Component::Local);
-      psa[k] = pos[k] - center[k];
-      v2 += vel[k]*vel[k];
+      double u = c->Vel(i, k, Component::Local);
+      v2 += u*u;
     }
 
-    energy = p->pot;
+    energy = pot;
     
     if (cflags & KE) energy += 0.5*v2;
 
-    if (cflags & EXTERNAL) energy += p->potext;
+    if (cflags & EXTERNAL) energy += potext;
 
-    unsigned size0 = angm.size();
-    bool test1 = (size0 <= tkeep);
-    bool test2 = true;
+    elist[q] = {energy, i};
+  }
 
-    if (size0) test2 = (energy < el3last->E);
-    
-    if (test1 || test2) {
+  // Partition out the lowest tkeep energies
+  //
+  if (elist.size() > tkeep) {
+    std::nth_element(elist.begin(), elist.begin() + tkeep, elist.end());
+    elist.resize(tkeep);
+  }
 
-      mass = p->mass;
+  // Angular momentum and position moments for the retained particles
+  //
+  for (auto & v : elist) {
+    unsigned long i = v.second;
 
-      t.E = energy;
-      t.T = time;
-      t.M = mass;
+    for (int k=0; k<3; k++) {
+      pos[k] = c->Pos(i, k, Component::Local);
+      vel[k] = c->Vel(i, k, Component::Local);
+      psa[k] = pos[k] - center[k];
+    }
 
-      t.L[0] = mass*(psa[1]*vel[2] - psa[2]*vel[1]);
-      t.L[1] = mass*(psa[2]*vel[0] - psa[0]*vel[2]);
-      t.L[2] = mass*(psa[0]*vel[1] - psa[1]*vel[0]);
+    mass = c->Mass(i);
 
-      t.R[0] = mass*pos[0];
-      t.R[1] = mass*pos[1];
-      t.R[2] = mass*pos[2];
+    t.E = v.first;
+    t.T = time;
+    t.M = mass;
 
-      // Trim the list by removing the element with the largest energy
-      //
-      if (test2 && !test1) angm.erase(*el3last);
+    t.L[0] = mass*(psa[1]*vel[2] - psa[2]*vel[1]);
+    t.L[1] = mass*(psa[2]*vel[0] - psa[0]*vel[2]);
+    t.L[2] = mass*(psa[0]*vel[1] - psa[1]*vel[0]);
 
-      // Insert the new element
-      //
-      angm.insert(t);
+    t.R[0] = mass*pos[0];
+    t.R[1] = mass*pos[1];
+    t.R[2] = mass*pos[2];
 
-      // Reset the iterator at the top of the heap
-      //
-      el3last = angm.rbegin();
+    angm.insert(t);
 
 #ifdef DEBUG      
-      t.debug();
+    t.debug();
 #endif
-    }
   }
 }
 
@@ -419,39 +445,20 @@ void Orient::accumulate(double time, Component *c)
 
   comp->timer_orient.stop();
 
-  unsigned tkeep = many/numprocs;
-
+  // The energy cut is the energy of the particle of rank _many_ over
+  // all of the local lowest-energy lists (or the largest energy if
+  // there are fewer).  Every node receives the same value.  The cut
+  // is exact because each local list keeps its lowest many+1
+  // energies (see accumulate_cpu/accumulate_gpu); the selection over
+  // those lists adds no approximation of its own.
+  //
   std::vector<double> ee;
   for (auto it = angm.begin(); it != angm.end(); it++) ee.push_back(it->E);
   
-  for (int n=1; n<numprocs; n++) {
-    if (n==myid) {
-      unsigned nsiz = ee.size();
-      // Size trim approximation; 3x the target size
-      nsiz = std::min<unsigned>(nsiz, 3.0*tkeep);
-      // Send to root node for sorting
-      MPI_Send(&nsiz,     1, MPI_UNSIGNED, 0, 331, MPI_COMM_WORLD);
-      MPI_Send(&ee[0], nsiz, MPI_DOUBLE,   0, 332, MPI_COMM_WORLD);
-    }
-    if (0==myid) {
-      unsigned nsiz;
-      MPI_Recv(&nsiz, 1, MPI_UNSIGNED, n, 331, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-      std::vector<double> tt(nsiz);
-      MPI_Recv(&tt[0], nsiz, MPI_DOUBLE, n, 332, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-      ee.insert(ee.end(), tt.begin(), tt.end());
-    }
-  }
-
-  if (myid==0) {
-    std::sort(ee.begin(), ee.end());
-    if (ee.size()<=many) Ecurr = ee.back();
-    else                 Ecurr = *(ee.begin()+many);
-  }
-
-  // Propagate minimum energy and current cached low energy particles
-  // within nodes
+  ParallelQuantile pq;
+  unsigned long ntot = pq.total(ee);
 
-  MPI_Bcast(&Ecurr, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  if (ntot) Ecurr = pq.select(ee, std::min<unsigned long>(many, ntot-1));
 
 				// Compute values for this step
   axis1  .setZero();
@@ -6,6 +6,10 @@
 #include <chrono>
 
 #include <unistd.h>		// For unlink
+#include <fcntl.h>		// For open
+#include <sys/stat.h>		// For lstat
+#include <cerrno>
+#include <cstring>
 
 #include "expand.H"
 #include <global.H>
@@ -20,7 +24,8 @@ OutCHKPT::valid_keys = {
   "nint",
   "nintsub",
   "timer",
-  "nagg"
+  "nagg",
+  "async"
 };
 
 OutCHKPT::OutCHKPT(const YAML::Node& conf) : Output(conf)
@@ -28,6 +33,14 @@ OutCHKPT::OutCHKPT(const YAML::Node& conf) : Output(conf)
   initialize();
 }
 
+OutCHKPT::~OutCHKPT()
+{
+  // The temporary file is left in place if the run ends with a
+  // pending write
+  //
+  if (writer.joinable()) writer.join();
+}
+
 void OutCHKPT::initialize()
 {
   // Remove matched keys
@@ -76,6 +89,11 @@ void OutCHKPT::initialize()
       nagg = Output::conf["nagg"].as<std::string>();
     else
       nagg = "1";
+
+    if (Output::conf["async"])
+      async = Output::conf["async"].as<bool>();
+    else
+      async = false;
   }
   catch (YAML::Exception & error) {
     if (myid==0) std::cout << "Error parsing parameters in OutCHKPT: "
@@ -92,14 +110,52 @@ void OutCHKPT::initialize()
 
 void OutCHKPT::Run(int n, int mstep, bool last)
 {
+				// Complete a background write as
+				// soon as all processes are done
+  if (pending) {
+    int ok = done ? 1 : 0, allOK;
+    MPI_Allreduce(&ok, &allOK, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (allOK) finish_async();
+  }
+
   if (!dump_signal and !last) {
     if (n % nint) return;
     if (multistep>1 and mstep % nintsub !=0) return;
   }
+				// Completion barrier for the previous
+				// checkpoint
+  if (pending) finish_async();
 
   int returnStatus = 1;
 
-  if (myid==0) {
+  if (myid==0 and async) {
+				// No rename to the backup here: the
+				// backup is made when the new file
+				// is complete and the .tmp to final
+				// rename makes the switch atomic
+    returnStatus = 0;
+
+    if (lastPS.size()) {
+				// Link the last PSP in the same way
+      std::string linkfile = filename + ".tmp";
+      unlink(linkfile.c_str());
+      if (symlink(lastPS.c_str(), linkfile.c_str()) or
+	  rename(linkfile.c_str(), filename.c_str())) {
+	if (VERBOSE>5) perror("OutCHKPT::Run()");
+	unlink(linkfile.c_str());
+	cout << "OutCHKPT::Run(): no file <" << lastPS
+	     << "> to link, we will create a new checkpoint" << endl;
+      } else {
+	returnStatus = 1;
+	if (VERBOSE>5) {
+	  cout << "OutCHKPT::Run(): successfully linked <"
+	       << lastPS << "> to new backup file <" 
+	       << filename << ">" << endl;
+	}
+      }
+    }
+
+  } else if (myid==0) {
     string backfile = filename + ".bak";
     if (unlink(backfile.c_str())) {
       if (VERBOSE>5) perror("OutCHKPT::Run()");
@@ -146,7 +202,14 @@ void OutCHKPT::Run(int n, int mstep, bool last)
   std::chrono::high_resolution_clock::time_point beg, end;
   if (timer) beg = std::chrono::high_resolution_clock::now();
   
-  if (mpio) {
+  if (async) {
+
+    write_async();
+				// Do not leave the final or an
+				// emergency checkpoint pending
+    if (last or dump_signal) finish_async();
+
+  } else if (mpio) {
     static bool firsttime = true;
 
     // MPI variables
@@ -327,3 +390,160 @@ void OutCHKPT::Run(int n, int mstep, bool last)
   }
 }
 
+
+
+void OutCHKPT::write_async()
+{
+  tstart = std::chrono::high_resolution_clock::now();
+
+  // Copy the phase space into the staging buffer
+  //
+  stage.clear();
+
+  MPI_Offset offset = 0;
+
+  if (myid==0) {
+    struct MasterHeader header;
+    header.time  = tnow;
+    header.ntot  = comp->ntot;
+    header.ncomp = comp->ncomp;
+
+    const char *p = (const char *)&header;
+    stage.push_back({offset, std::vector<char>(p, p + sizeof(MasterHeader))});
+  }
+
+  offset += sizeof(MasterHeader);
+
+  for (auto c : comp->components) {
+#ifdef HAVE_LIBCUDA
+    if (use_cuda) {
+      if (c->force->cudaAware() and not comp->fetched[c]) {
+	comp->fetched[c] = true;
+	c->CudaToParticles();
+      }
+    }
+#endif
+    c->write_binary_stage(stage, offset);
+  }
+
+  // Root creates the temporary file before anyone writes to it
+  //
+  tmpfile = filename + ".tmp";
+
+  int nOK = 0;
+  if (myid==0) {
+    int fd = open(tmpfile.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0) {
+      std::cerr << "OutCHKPT: can't create file <" << tmpfile << ">: "
+		<< strerror(errno) << std::endl;
+      nOK = 1;
+    } else {
+      close(fd);
+    }
+  }
+
+  MPI_Bcast(&nOK, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if (nOK) {
+    throw std::runtime_error("OutCHKPT::Run: error in I/O");
+  }
+
+  done    = false;
+  werror  = 0;
+  pending = true;
+
+  writer  = std::thread(&OutCHKPT::write_stage, this);
+
+  if (timer and myid==0) {
+    std::chrono::duration<double> intvl =
+      std::chrono::high_resolution_clock::now() - tstart;
+    std::cout << "OutCHKPT [T=" << tnow << "] staging=" << intvl.count()
+	      << std::endl;
+  }
+}
+
+
+void OutCHKPT::write_stage()
+{
+  int fd = open(tmpfile.c_str(), O_WRONLY);
+
+  if (fd < 0) {
+    werror = errno;
+    done   = true;
+    return;
+  }
+
+  for (auto & b : stage) {
+    const char *p = b.second.data();
+    size_t  left  = b.second.size();
+    off_t   off   = b.first;
+
+    while (left) {
+      ssize_t w = pwrite(fd, p, left, off);
+      if (w < 0) {
+	if (errno == EINTR) continue;
+	werror = errno;
+	break;
+      }
+      p    += w;
+      off  += w;
+      left -= w;
+    }
+
+    if (werror) break;
+  }
+
+  if (fsync(fd) and werror==0) werror = errno;
+  close(fd);
+
+				// Release the staging memory
+  std::vector<Component::StagedBlock>().swap(stage);
+
+  done = true;
+}
+
+
+void OutCHKPT::finish_async()
+{
+  writer.join();
+  pending = false;
+
+  if (werror)
+    std::cerr << "OutCHKPT: rank [" << myid << "] error writing <"
+	      << tmpfile << ">: " << strerror(werror) << std::endl;
+
+  int bad = werror ? 1 : 0, badCount;
+  MPI_Allreduce(&bad, &badCount, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  if (badCount) {
+    throw std::runtime_error("OutCHKPT::Run: error in I/O");
+  }
+
+  // Every process has synced its part: keep the previous checkpoint
+  // as the backup and atomically replace it with the new one
+  //
+  if (myid==0) {
+    std::string backfile = filename + ".bak";
+    struct stat sb;
+
+    if (lstat(filename.c_str(), &sb) == 0) {
+      unlink(backfile.c_str());
+      if (link(filename.c_str(), backfile.c_str())) {
+	if (VERBOSE>5) perror("OutCHKPT::finish_async()");
+	rename(filename.c_str(), backfile.c_str());
+      }
+    }
+
+    if (rename(tmpfile.c_str(), filename.c_str())) {
+      perror("OutCHKPT::finish_async()");
+      std::cout << "OutCHKPT: error renaming <" << tmpfile << "> to <"
+		<< filename << ">" << std::endl;
+    }
+
+    if (timer) {
+      std::chrono::duration<double> intvl =
+	std::chrono::high_resolution_clock::now() - tstart;
+      std::cout << "OutCHKPT: checkpoint <" << filename << "> complete after "
+		<< intvl.count() << " seconds" << std::endl;
+    }
+  }
+}
@@ -0,0 +1,356 @@
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+
+#include <highfive/highfive.hpp>
+
+#include "expand.H"
+#include <global.H>
+
+#include <OutH5.H>
+
+#ifdef H5_HAVE_PARALLEL
+static constexpr bool parallel_hdf5 = true;
+#else
+static constexpr bool parallel_hdf5 = false;
+#endif
+
+const std::set<std::string>
+OutH5::valid_keys = {
+  "filename",
+  "nint",
+  "nintsub",
+  "nbeg",
+  "real4",
+  "chunk",
+  "compress",
+  "timer",
+};
+
+OutH5::OutH5(const YAML::Node& conf) : Output(conf)
+{
+  initialize();
+}
+
+void OutH5::initialize()
+{
+  // Remove matched keys
+  //
+  for (auto v : valid_keys) current_keys.erase(v);
+
+  // Assign values from YAML
+  //
+  try {
+				// Get file name
+    if (Output::conf["filename"])
+      filename = Output::conf["filename"].as<std::string>();
+    else{
+      filename.erase();
+      filename = outdir + "H5." + runtag;
+    }
+
+    if (Output::conf["nint"])
+      nint = Output::conf["nint"].as<int>();
+    else
+      nint = 100;
+
+    if (Output::conf["nintsub"]) {
+#ifdef ALLOW_NINTSUB
+      nintsub = Output::conf["nintsub"].as<int>();
+      if (nintsub <= 0) nintsub = 1;
+#else
+      nintsub_warning("OutH5");
+      nintsub = std::numeric_limits<int>::max();
+#endif
+    } else
+      nintsub = std::numeric_limits<int>::max();
+
+    if (Output::conf["nbeg"])
+      nbeg = Output::conf["nbeg"].as<int>();
+    else
+      nbeg = 0;
+
+    if (Output::conf["real4"])
+      real4 = Output::conf["real4"].as<bool>();
+    else
+      real4 = true;
+
+    if (Output::conf["chunk"])
+      chunk = std::max<int>(1, Output::conf["chunk"].as<int>());
+    else
+      chunk = 65536;
+
+    if (Output::conf["compress"])
+      compress = std::clamp<int>(Output::conf["compress"].as<int>(), 0, 9);
+    else
+      compress = 0;
+
+    if (Output::conf["timer"])
+      timer = Output::conf["timer"].as<bool>();
+    else
+      timer = false;
+  }
+  catch (YAML::Exception & error) {
+    if (myid==0) std::cout << "Error parsing parameters in OutH5: "
+			   << error.what() << std::endl
+			   << std::string(60, '-') << std::endl
+			   << "Config node"        << std::endl
+			   << std::string(60, '-') << std::endl
+			   << conf                 << std::endl
+			   << std::string(60, '-') << std::endl;
+    throw std::runtime_error("OutH5::initialize: error parsing YAML");
+  }
+
+				// Determine last file
+
+  if (restart && nbeg==0 && myid==0) {
+
+    for (nbeg=0; nbeg<100000; nbeg++) {
+
+				// Output name
+      ostringstream fname;
+      fname << filename << "." << setw(5) << setfill('0') << nbeg;
+
+				// See if we can open file
+      ifstream in(fname.str().c_str());
+
+      if (!in) {
+	cout << "OutH5: will begin with nbeg=" << nbeg << endl;
+	break;
+      }
+    }
+  }
+
+  MPI_Bcast(&nbeg, 1, MPI_INT, 0, MPI_COMM_WORLD);
+}
+
+
+template<typename T>
+void OutH5::write(const std::string& fname)
+{
+  // Global offset of this process' particles and the total for each
+  // component.  Computed up front since the serial fallback below
+  // visits the file one process at a time.
+  //
+  std::vector<Component*> comps(comp->components.begin(),
+				comp->components.end());
+
+  size_t ncomp = comps.size();
+  std::vector<unsigned long> number(ncomp), offset(ncomp, 0), total(ncomp);
+
+  for (size_t i=0; i<ncomp; i++) number[i] = comps[i]->Number();
+
+  MPI_Exscan(number.data(), offset.data(), ncomp, MPI_UNSIGNED_LONG, MPI_SUM,
+	     MPI_COMM_WORLD);
+  MPI_Allreduce(number.data(), total.data(), ncomp, MPI_UNSIGNED_LONG,
+		MPI_SUM, MPI_COMM_WORLD);
+  if (myid==0) std::fill(offset.begin(), offset.end(), 0);
+
+  // Create or open the datasets and write this process' hyperslab
+  //
+  auto writeFile = [&](HighFive::File& file, bool create,
+		       const HighFive::DataTransferProps& xfer)
+  {
+    if (create) {
+      double time = tnow;
+      int    nc   = ncomp;
+      std::string format("EXPH5"), version("1.0");
+
+      file.createAttribute<double>     ("time",    HighFive::DataSpace::From(time)).   write(time);
+      file.createAttribute<int>        ("ncomp",   HighFive::DataSpace::From(nc)).     write(nc);
+      file.createAttribute<std::string>("format",  HighFive::DataSpace::From(format)). write(format);
+      file.createAttribute<std::string>("version", HighFive::DataSpace::From(version)).write(version);
+    }
+
+    for (size_t i=0; i<ncomp; i++) {
+      Component *c = comps[i];
+      size_t N = total[i], n = number[i], off = offset[i];
+
+      HighFive::Group grp = create ? file.createGroup(c->name) :
+	file.getGroup(c->name);
+
+      if (create) {
+	std::ostringstream sout;
+	if (c->conf.Type() != YAML::NodeType::Null) sout << c->conf;
+	std::string config = sout.str();
+	int niattr = c->niattrib, ndattr = c->ndattrib;
+	unsigned long nbod = N;
+
+	grp.createAttribute<std::string>  ("config",   HighFive::DataSpace::From(config)).write(config);
+	grp.createAttribute<unsigned long>("nbodies",  HighFive::DataSpace::From(nbod)).  write(nbod);
+	grp.createAttribute<int>          ("niattrib", HighFive::DataSpace::From(niattr)).write(niattr);
+	grp.createAttribute<int>          ("ndattrib", HighFive::DataSpace::From(ndattr)).write(ndattr);
+      }
+
+      // Chunked along the particle dimension, compressed if desired
+      //
+      auto column = [&](const std::string& name, size_t ncol, auto type)
+      {
+	using U = decltype(type);
+	if (not create) return grp.getDataSet(name);
+
+	std::vector<size_t> dims {N};
+	if (ncol) dims.push_back(ncol);
+
+	HighFive::DataSetCreateProps props;
+	if (N) {
+	  std::vector<hsize_t> cdims {std::min<hsize_t>(chunk, N)};
+	  if (ncol) cdims.push_back(ncol);
+	  props.add(HighFive::Chunking(cdims));
+	  if (compress) {
+	    props.add(HighFive::Shuffle());
+	    props.add(HighFive::Deflate(compress));
+	  }
+	}
+
+	return grp.createDataSet<U>(name, HighFive::DataSpace(dims), props);
+      };
+
+      // Write n rows at off.  With collective IO every process takes
+      // part, even with no rows of its own.
+      //
+      auto slab = [&](HighFive::DataSet ds, size_t ncol, const auto& data)
+      {
+	if (n==0 and not parallel_hdf5) return;
+	std::vector<size_t> beg {off}, cnt {n};
+	if (ncol) { beg.push_back(0); cnt.push_back(ncol); }
+	ds.select(beg, cnt).write_raw(data.data(), xfer);
+      };
+
+      // Pack the local columns
+      //
+      std::vector<unsigned long> indx(n);
+      std::vector<T> mass(n), pot(n), pos(3*n), vel(3*n);
+      std::vector<int> iattr(n*c->niattrib);
+      std::vector<T>   dattr(n*c->ndattrib);
+
+      size_t j = 0;
+      for (auto & v : c->Particles()) {
+	auto & p = v.second;
+	indx[j] = p->indx;
+	mass[j] = p->mass;
+	pot [j] = p->pot + p->potext;
+	for (int k=0; k<3; k++) {
+	  pos[3*j+k] = p->pos[k];
+	  vel[3*j+k] = p->vel[k];
+	}
+	for (int k=0; k<c->niattrib; k++) iattr[c->niattrib*j+k] = p->iattrib[k];
+	for (int k=0; k<c->ndattrib; k++) dattr[c->ndattrib*j+k] = p->dattrib[k];
+	j++;
+      }
+
+      slab(column("index", 0, (unsigned long)0), 0, indx);
+      slab(column("mass",  0, T(0)), 0, mass);
+      slab(column("pos",   3, T(0)), 3, pos );
+      slab(column("vel",   3, T(0)), 3, vel );
+      slab(column("pot",   0, T(0)), 0, pot );
+
+      if (c->niattrib)
+	slab(column("iattrib", c->niattrib, int(0)), c->niattrib, iattr);
+
+      if (c->ndattrib)
+	slab(column("dattrib", c->ndattrib, T(0)), c->ndattrib, dattr);
+    }
+  };
+
+  if (parallel_hdf5) {
+#ifdef H5_HAVE_PARALLEL
+    HighFive::FileAccessProps fapl;
+    fapl.add(HighFive::MPIOFileAccess{MPI_COMM_WORLD, MPI_INFO_NULL});
+    fapl.add(HighFive::MPIOCollectiveMetadata{});
+
+    HighFive::File file(fname, HighFive::File::Overwrite, fapl);
+
+    HighFive::DataTransferProps xfer;
+    xfer.add(HighFive::UseCollectiveIO{});
+
+    writeFile(file, true, xfer);
+#endif
+  } else {
+    // No parallel HDF5: the root creates the file and the datasets and
+    // the other processes append their hyperslabs in turn.  A failure
+    // is reduced after each turn in place of a barrier, so every
+    // process stops and throws rather than waiting on the one that
+    // failed.
+    //
+    std::string error;
+    int bad = 0;
+    for (int n=0; n<numprocs and not bad; n++) {
+      int mine = 0;
+      if (myid==n) {
+	try {
+	  HighFive::File file(fname, n==0 ? HighFive::File::Overwrite :
+			      HighFive::File::ReadWrite);
+	  writeFile(file, n==0, HighFive::DataTransferProps());
+	}
+	catch (std::exception& e) {
+	  error = e.what();
+	  mine  = 1;
+	}
+      }
+      MPI_Allreduce(&mine, &bad, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    }
+
+    if (bad) {
+      std::ostringstream sout;
+      sout << "OutH5: error writing <" << fname << ">";
+      if (error.size()) sout << " on process " << myid << ": " << error;
+      throw GenericError(sout.str(), __FILE__, __LINE__, 1044, true);
+    }
+  }
+}
+
+
+void OutH5::Run(int n, int mstep, bool last)
+{
+  if (!dump_signal and !last) {
+    if (n % nint) return;
+    if (restart && n==0) return;
+    if (multistep>1 && mstep % nintsub !=0) return;
+  }
+
+  std::chrono::high_resolution_clock::time_point beg, end;
+  if (timer) beg = std::chrono::high_resolution_clock::now();
+
+				// Output name
+  std::ostringstream fname;
+  fname << filename << "." << setw(5) << setfill('0') << nbeg++;
+
+#ifdef HAVE_LIBCUDA
+  for (auto c : comp->components) {
+    if (use_cuda) {
+      if (c->force->cudaAware() and not comp->fetched[c]) {
+	comp->fetched[c] = true;
+	c->CudaToParticles();
+      }
+    }
+  }
+#endif
+
+  try {
+    HighFive::SilenceHDF5 quiet;
+
+    if (real4) write<float> (fname.str());
+    else       write<double>(fname.str());
+  }
+  catch (HighFive::Exception& err) {
+    std::ostringstream sout;
+    sout << "OutH5: error writing <" << fname.str() << ">: " << err.what();
+    throw GenericError(sout.str(), __FILE__, __LINE__, 1044, true);
+  }
+
+  chktimer.mark();
+
+  dump_signal = 0;
+
+  if (timer) {
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> intvl = end - beg;
+    if (myid==0)
+      std::cout << "OutH5 [T=" << tnow << "] timing=" << intvl.count()
+		<< std::endl;
+  }
+}
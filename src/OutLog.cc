@@ -448,20 +448,38 @@ void OutLog::Run(int n, int mstep, bool last)
     }
 #endif
 
-    nbodies1[indx] = c->Number();
+    // Walk the slots of a component held in the slot arrays: asking
+    // for the particle map would copy the fields back
+    //
+    ParticleSoA *soa = c->useSoA() ? &c->SoA() : 0;
 
-    PartMapItr it = c->Particles().begin();
+    nbodies1[indx] = soa ? soa->size() : c->Number();
+
+    PartMapItr it;
+    if (not soa) it = c->Particles().begin();
     unsigned long i;
+    double mass, pot, potext, acc[3];
 
     for (int q=0; q<nbodies1[indx]; q++) {
 
-      i = (it++)->first;
+      if (soa) {
+	i      = soa->indx[q];
+	mass   = soa->mass[q];
+	pot    = soa->pot[q];
+	potext = soa->potext[q];
+	for (int k=0; k<3; k++) acc[k] = soa->acc[k][q];
+      } else {
+	Particle *p = (it++)->second.get();
+	i      = p->indx;
+	mass   = p->mass;
+	pot    = p->pot;
+	potext = p->potext;
+	for (int k=0; k<3; k++) acc[k] = p->acc[k];
+      }
 
       if (c->freeze(i)) continue;
 
-      Particle *p = c->Part(i);
-
-      mtot1[indx] +=  p->mass;
+      mtot1[indx] +=  mass;
 
       for (int k=0; k<3; k++) {
 	pos0[k] = c->Pos(i, k, Component::Inertial);
@@ -471,27 +489,27 @@ void OutLog::Run(int n, int mstep, bool last)
       }
 
       for (int k=0; k<3; k++) {
-	com1[indx][k] += p->mass*posL[k];
-	cov1[indx][k] += p->mass*velL[k];
-	comG[k] += p->mass*pos0[k];
-	covG[k] += p->mass*vel0[k];
+	com1[indx][k] += mass*posL[k];
+	cov1[indx][k] += mass*velL[k];
+	comG[k] += mass*pos0[k];
+	covG[k] += mass*vel0[k];
       }
 
-      angm1[indx][0] += p->mass*(posL[1]*velL[2] - posL[2]*velL[1]);
-      angm1[indx][1] += p->mass*(posL[2]*velL[0] - posL[0]*velL[2]);
-      angm1[indx][2] += p->mass*(posL[0]*velL[1] - posL[1]*velL[0]);
+      angm1[indx][0] += mass*(posL[1]*velL[2] - posL[2]*velL[1]);
+      angm1[indx][1] += mass*(posL[2]*velL[0] - posL[0]*velL[2]);
+      angm1[indx][2] += mass*(posL[0]*velL[1] - posL[1]*velL[0]);
 
-      angmG[0] += p->mass*(pos0[1]*vel0[2] - pos0[2]*vel0[1]);
-      angmG[1] += p->mass*(pos0[2]*vel0[0] - pos0[0]*vel0[2]);
-      angmG[2] += p->mass*(pos0[0]*vel0[1] - pos0[1]*vel0[0]);
+      angmG[0] += mass*(pos0[1]*vel0[2] - pos0[2]*vel0[1]);
+      angmG[1] += mass*(pos0[2]*vel0[0] - pos0[0]*vel0[2]);
+      angmG[2] += mass*(pos0[0]*vel0[1] - pos0[1]*vel0[0]);
 
       for (int k=0; k<3; k++) pos0[k] = c->Pos(i, k, Component::Centered);
 
-      eptot1[indx]  += 0.5*p->mass*p->pot;
-      eptotx1[indx] += p->mass*p->potext;
+      eptot1[indx]  += 0.5*mass*pot;
+      eptotx1[indx] += mass*potext;
       for (int k=0; k<3; k++) {
-	ektot1[indx]    += 0.5*p->mass*velL[k]*velL[k];
-	clausius1[indx] += p->mass*posL[k]*p->acc[k];
+	ektot1[indx]    += 0.5*mass*velL[k]*velL[k];
+	clausius1[indx] += mass*posL[k]*acc[k];
       }
     }
 
@@ -11,6 +11,7 @@
 #include <OutPSP.H>
 #include <OutPSQ.H>
 #include <OutPSR.H>
+#include <OutH5.H>
 #include <OutVel.H>
 #include <OutAscii.H>
 #include <OutCHKPT.H>
@@ -75,6 +76,10 @@ void OutputContainer::initialize(void)
 	out.push_back(new OutPSR (node));
       }
     
+      else if ( !name.compare("outh5") ) {
+	out.push_back(new OutH5 (node));
+      }
+    
       else if ( !name.compare("outvel") ) {
 	out.push_back(new OutVel (node));
       }
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#include <ParallelQuantile.H>
+
+unsigned long ParallelQuantile::total(const std::vector<double>& data)
+{
+  unsigned long n = data.size(), N = 0;
+  MPI_Allreduce(&n, &N, 1, MPI_UNSIGNED_LONG, MPI_SUM, comm);
+  return N;
+}
+
+std::vector<double>
+ParallelQuantile::select(std::vector<double>& data,
+			 const std::vector<unsigned long>& ranks)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+
+  size_t nq = ranks.size();
+  std::vector<double> ret(nq, nan);
+
+  unsigned long N = total(data);
+  if (N==0 or nq==0) return ret;
+
+  std::sort(data.begin(), data.end());
+
+  // Number of local values less than x and less than or equal to x
+  //
+  auto below = [&](double x) -> unsigned long
+  { return std::lower_bound(data.begin(), data.end(), x) - data.begin(); };
+
+  auto upto  = [&](double x) -> unsigned long
+  { return std::upper_bound(data.begin(), data.end(), x) - data.begin(); };
+
+  // Global range of the sample
+  //
+  double range[2] = {inf, inf};
+  if (data.size()) {
+    range[0] =  data.front();
+    range[1] = -data.back();
+  }
+  MPI_Allreduce(MPI_IN_PLACE, range, 2, MPI_DOUBLE, MPI_MIN, comm);
+
+  // Refinement state for each rank: the candidates are the values in
+  // the closed interval [lo, hi] and <code>skip</code> values lie
+  // below lo.  Every process holds identical state.
+  //
+  struct Target
+  {
+    unsigned long k, skip = 0;
+    double lo, hi;
+    bool done = false, stuck = false;
+  };
+
+  std::vector<Target> T(nq);
+  for (size_t q=0; q<nq; q++) {
+    T[q].k  = std::min<unsigned long>(ranks[q], N-1);
+    T[q].lo =  range[0];
+    T[q].hi = -range[1];
+  }
+
+  int numprocs;
+  MPI_Comm_size(comm, &numprocs);
+
+  while (true) {
+
+    std::vector<size_t> active;
+    for (size_t q=0; q<nq; q++) if (not T[q].done) active.push_back(q);
+    if (active.empty()) break;
+
+    // Number of candidates and number equal to lo
+    //
+    size_t na = active.size();
+    std::vector<unsigned long> cnt(2*na);
+    for (size_t i=0; i<na; i++) {
+      auto & t = T[active[i]];
+      unsigned long b = below(t.lo);
+      cnt[2*i+0] = upto(t.hi) - b;
+      cnt[2*i+1] = upto(t.lo) - b;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, cnt.data(), 2*na, MPI_UNSIGNED_LONG,
+		  MPI_SUM, comm);
+
+    std::vector<size_t> gather, refine;
+
+    for (size_t i=0; i<na; i++) {
+      auto & t = T[active[i]];
+      unsigned long r = t.k - t.skip;
+
+      if (t.lo == t.hi) {	// One value left
+	ret[active[i]] = t.lo;
+	t.done = true;
+      }
+      else if (std::nextafter(t.lo, inf) >= t.hi) {
+				// No value strictly between lo and hi
+	ret[active[i]] = r < cnt[2*i+1] ? t.lo : t.hi;
+	t.done = true;
+      }
+      else if (cnt[2*i] <= ngather or t.stuck)
+	gather.push_back(i);
+      else
+	refine.push_back(i);
+    }
+
+    // Collect the remaining candidates for the small ranges
+    //
+    if (gather.size()) {
+      size_t ng = gather.size();
+      std::vector<int> lcnt(ng), acnt(ng*numprocs);
+      std::vector<double> lval;
+
+      for (size_t j=0; j<ng; j++) {
+	auto & t = T[active[gather[j]]];
+	auto beg = data.begin() + below(t.lo);
+	auto end = data.begin() + upto (t.hi);
+	lcnt[j] = end - beg;
+	lval.insert(lval.end(), beg, end);
+      }
+
+      MPI_Allgather(lcnt.data(), ng, MPI_INT, acnt.data(), ng, MPI_INT, comm);
+
+      std::vector<int> rcnt(numprocs, 0), rdsp(numprocs, 0);
+      for (int n=0; n<numprocs; n++) {
+	for (size_t j=0; j<ng; j++) rcnt[n] += acnt[n*ng+j];
+	if (n) rdsp[n] = rdsp[n-1] + rcnt[n-1];
+      }
+
+      std::vector<double> aval(rdsp.back() + rcnt.back());
+      MPI_Allgatherv(lval.data(), lval.size(), MPI_DOUBLE,
+		     aval.data(), rcnt.data(), rdsp.data(), MPI_DOUBLE, comm);
+
+      for (size_t j=0; j<ng; j++) {
+	auto & t = T[active[gather[j]]];
+	std::vector<double> v;
+	for (int n=0; n<numprocs; n++) {
+	  size_t off = rdsp[n];
+	  for (size_t l=0; l<j; l++) off += acnt[n*ng+l];
+	  v.insert(v.end(), aval.begin()+off, aval.begin()+off+acnt[n*ng+j]);
+	}
+	auto nth = v.begin() + (t.k - t.skip);
+	std::nth_element(v.begin(), nth, v.end());
+	ret[active[gather[j]]] = *nth;
+	t.done = true;
+      }
+    }
+
+    // Histogram the large ranges and narrow each to the bin holding
+    // its rank
+    //
+    if (refine.size()) {
+      size_t nr = refine.size();
+      std::vector<std::vector<double>> edge(nr, std::vector<double>(nbins+1));
+      std::vector<unsigned long> hist(nr*nbins);
+
+      for (size_t j=0; j<nr; j++) {
+	auto & t = T[active[refine[j]]];
+	auto & e = edge[j];
+				// Interpolate without overflow and
+				// keep the edges monotonic
+	e[0] = t.lo;
+	for (int i=1; i<nbins; i++) {
+	  double f = static_cast<double>(i)/nbins;
+	  e[i] = std::clamp(t.lo*(1.0 - f) + t.hi*f, e[i-1], t.hi);
+	}
+	e[nbins] = t.hi;
+
+	for (int i=0; i<nbins; i++) {
+	  unsigned long top = i==nbins-1 ? upto(t.hi) : below(e[i+1]);
+	  hist[j*nbins+i] = top - below(e[i]);
+	}
+      }
+
+      MPI_Allreduce(MPI_IN_PLACE, hist.data(), nr*nbins, MPI_UNSIGNED_LONG,
+		    MPI_SUM, comm);
+
+      for (size_t j=0; j<nr; j++) {
+	auto & t = T[active[refine[j]]];
+	auto & e = edge[j];
+	unsigned long r = t.k - t.skip, cum = 0;
+	int b = 0;
+	for (; b<nbins-1; b++) {
+	  if (cum + hist[j*nbins+b] > r) break;
+	  cum += hist[j*nbins+b];
+	}
+				// Bin b is [e_b, e_{b+1}) except for the
+				// last, which is closed
+	double lo = t.lo, hi = t.hi;
+	t.skip += cum;
+	t.lo = e[b];
+	if (b < nbins-1) t.hi = std::nextafter(e[b+1], -inf);
+				// Gather on the next pass if rounding
+				// prevents any progress
+	t.stuck = t.lo==lo and t.hi==hi;
+      }
+    }
+  }
+
+  return ret;
+}
+
+std::vector<double>
+ParallelQuantile::quantiles(std::vector<double>& data,
+			    const std::vector<double>& probs)
+{
+  unsigned long N = total(data);
+
+  std::vector<unsigned long> ranks;
+  for (auto q : probs) {
+    double x = std::max<double>(q, 0.0)*N + 0.5;
+    ranks.push_back(N ? std::min<unsigned long>(x, N-1) : 0);
+  }
+
+  return select(data, ranks);
+}
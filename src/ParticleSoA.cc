@@ -0,0 +1,184 @@
+#include <algorithm>
+
+#include <EXPException.H>
+#include <ParticleSoA.H>
+
+void ParticleSoA::build(PartMap& particles, unsigned maxlev)
+{
+  unsigned N = particles.size();
+
+  // Count the population of each level
+  //
+  levbeg.assign(maxlev+2, 0);
+  for (auto & v : particles) {
+    unsigned lev = std::min<unsigned>(v.second->level, maxlev);
+    levbeg[lev+1]++;
+  }
+
+  // Cumulate to get the first slot in each level
+  //
+  for (unsigned l=1; l<=maxlev+1; l++) levbeg[l] += levbeg[l-1];
+
+  // Bucket sort the particles by level, in index order within each
+  // level
+  //
+  std::vector<unsigned> next(levbeg.begin(), levbeg.end()-1);
+
+  owner.resize(N);
+  for (auto & v : particles) {
+    unsigned lev = std::min<unsigned>(v.second->level, maxlev);
+    owner[next[lev]++] = v.second.get();
+  }
+
+  for (unsigned l=0; l<=maxlev; l++)
+    std::sort(owner.begin()+levbeg[l], owner.begin()+levbeg[l+1],
+	      [](const Particle* a, const Particle* b)
+	      { return a->indx < b->indx; });
+
+  // Index to slot table
+  //
+  slot.clear();
+  slot.reserve(N);
+  for (unsigned s=0; s<N; s++) slot[owner[s]->indx] = s;
+
+  // Size the field arrays
+  //
+  mass  .resize(N);
+  pot   .resize(N);
+  potext.resize(N);
+  level .resize(N);
+  indx  .resize(N);
+  for (int k=0; k<3; k++) {
+    pos[k].resize(N);
+    vel[k].resize(N);
+    acc[k].resize(N);
+  }
+
+  // The level and index fields are fixed by the slot ordering
+  //
+  for (unsigned s=0; s<N; s++) {
+    level[s] = std::min<unsigned>(owner[s]->level, maxlev);
+    indx [s] = owner[s]->indx;
+  }
+
+  load();
+
+  stale    = false;
+  resident = true;
+}
+
+bool ParticleSoA::relevel(unsigned maxlev)
+{
+  unsigned N = owner.size();
+
+  bool changed = false;
+  for (unsigned s=0; s<N and not changed; s++)
+    changed = std::min<unsigned>(owner[s]->level, maxlev) != level[s];
+
+  if (not changed) return false;
+
+  // New level ranges
+  //
+  levbeg.assign(maxlev+2, 0);
+  for (unsigned s=0; s<N; s++) {
+    unsigned lev = std::min<unsigned>(owner[s]->level, maxlev);
+    levbeg[lev+1]++;
+  }
+  for (unsigned l=1; l<=maxlev+1; l++) levbeg[l] += levbeg[l-1];
+
+  // Stable bucket permutation: new slot t holds old slot perm[t]
+  //
+  std::vector<unsigned> next(levbeg.begin(), levbeg.end()-1), perm(N);
+  for (unsigned s=0; s<N; s++) {
+    unsigned lev = std::min<unsigned>(owner[s]->level, maxlev);
+    perm[next[lev]++] = s;
+  }
+
+  auto permute = [&](auto & v)
+  {
+    auto w = v;
+    for (unsigned t=0; t<N; t++) v[t] = w[perm[t]];
+  };
+
+  permute(owner);
+  permute(indx);
+  permute(mass);
+  permute(pot);
+  permute(potext);
+  for (int k=0; k<3; k++) {
+    permute(pos[k]);
+    permute(vel[k]);
+    permute(acc[k]);
+  }
+
+  for (unsigned s=0; s<N; s++) {
+    level[s] = std::min<unsigned>(owner[s]->level, maxlev);
+    slot[indx[s]] = s;
+  }
+
+  return true;
+}
+
+unsigned ParticleSoA::slotOf(unsigned long i) const
+{
+  auto it = slot.find(i);
+  if (it == slot.end())
+    throw BadIndexException(i, slot.size(), __FILE__, __LINE__);
+  return it->second;
+}
+
+void ParticleSoA::release()
+{
+  if (not resident) return;
+
+  std::lock_guard<std::mutex> guard(lock);
+
+  if (resident) {
+    store();
+    resident = false;
+  }
+}
+
+void ParticleSoA::load()
+{
+  unsigned N = owner.size();
+
+  for (unsigned s=0; s<N; s++) {
+    Particle *p = owner[s];
+    mass  [s] = p->mass;
+    pot   [s] = p->pot;
+    potext[s] = p->potext;
+    for (int k=0; k<3; k++) {
+      pos[k][s] = p->pos[k];
+      vel[k][s] = p->vel[k];
+      acc[k][s] = p->acc[k];
+    }
+  }
+}
+
+void ParticleSoA::store()
+{
+  unsigned N = owner.size();
+
+  // Level changes go through the level lists and are not stored
+  // here; the slot ordering would be invalid otherwise
+  //
+  for (unsigned s=0; s<N; s++) {
+    Particle *p = owner[s];
+    p->mass   = mass  [s];
+    p->pot    = pot   [s];
+    p->potext = potext[s];
+    for (int k=0; k<3; k++) {
+      p->pos[k] = pos[k][s];
+      p->vel[k] = vel[k][s];
+      p->acc[k] = acc[k][s];
+    }
+  }
+}
+
+size_t ParticleSoA::bytes() const
+{
+  size_t N = owner.size();
+  return N*( 12*sizeof(double) + sizeof(unsigned) + sizeof(unsigned long) +
+	     sizeof(Particle*) );
+}
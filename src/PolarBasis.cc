@@ -46,7 +46,8 @@ PolarBasis::valid_keys = {
   "mlim",
   "ssfrac",
   "playback",
-  "coefMaster"
+  "coefMaster",
+  "node_shared"
 };
 
 PolarBasis::PolarBasis(Component* c0, const YAML::Node& conf, MixtureBasis *m) : 
@@ -77,6 +78,7 @@ PolarBasis::PolarBasis(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
   ssfrac           = 0.0;
   subset           = false;
   coefMaster       = true;
+  node_shared      = false;
   lastPlayTime     = -std::numeric_limits<double>::max();
 #if HAVE_LIBCUDA==1
   cuda_aware       = true;
@@ -128,6 +130,8 @@ PolarBasis::PolarBasis(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
     if (conf["mlim"])    mlim = conf["mlim"].as<int>();
     else                 mlim = Mmax;
     
+    if (conf["node_shared"]) node_shared = conf["node_shared"].as<bool>();
+
     if (conf["playback"]) {
       std::string file = conf["playback"].as<std::string>();
 				// Check the file exists
@@ -141,7 +145,7 @@ PolarBasis::PolarBasis(Component* c0, const YAML::Node& conf, MixtureBasis *m) :
       }
 
       // This creates the Coefs instance
-      playback = std::dynamic_pointer_cast<CoefClasses::CylCoefs>(CoefClasses::Coefs::factory(file));
+      playback = std::dynamic_pointer_cast<CoefClasses::CylCoefs>(CoefClasses::Coefs::factoryShared(file, node_shared));
 
       // Check to make sure that has been created
       if (not playback) {
@@ -433,6 +437,13 @@ void * PolarBasis::determine_coefficients_thread(void * arg)
 
   unsigned whch = 0;		// For PCA jacknife
 
+				// PCA accumulators for this thread
+				// (shared and locked if pcalock)
+  auto & massT1_  = pcaMass(id);
+  auto & coefT1_  = pcaT1(id);
+  auto & coefM1_  = pcaM1(id);
+  auto & tvar_    = pcaVar(id);
+
   for (int i=nbeg; i<nend; i++) {
 
     int indx = component->levlist[mlevel][i];
@@ -478,9 +489,9 @@ void * PolarBasis::determine_coefficients_thread(void * arg)
 	muse1[id] += mass;
 	if (pcavar) {
 	  whch = indx % sampT;
-	  pthread_mutex_lock(&cc_lock);
-	  massT1[whch][0] += mass;
-	  pthread_mutex_unlock(&cc_lock);
+	  if (pcalock) pthread_mutex_lock(&cc_lock);
+	  massT1_[whch] += mass;
+	  if (pcalock) pthread_mutex_unlock(&cc_lock);
 	}
       }
 
@@ -497,16 +508,16 @@ void * PolarBasis::determine_coefficients_thread(void * arg)
 	  *expcoef0[id][moffset] += u[id];
 
 	  if (compute and pcavar) {
-	    pthread_mutex_lock(&cc_lock);
-	    *expcoefT1[whch][m] += u[id];
-	    *expcoefM1[whch][m] += u[id]*u[id].transpose()/mass;
-	    pthread_mutex_unlock(&cc_lock);
+	    if (pcalock) pthread_mutex_lock(&cc_lock);
+	    *coefT1_[whch][m] += u[id];
+	    *coefM1_[whch][m] += u[id]*u[id].transpose()/mass;
+	    if (pcalock) pthread_mutex_unlock(&cc_lock);
 	  }
 
-	  if (compute) {
-	    pthread_mutex_lock(&cc_lock);
-	    tvar[0][m] += u[id]*u[id].transpose()/mass;
-	    pthread_mutex_unlock(&cc_lock);
+	  if (compute and pcaeof) {
+	    if (pcalock) pthread_mutex_lock(&cc_lock);
+	    *tvar_[m] += u[id]*u[id].transpose()/mass;
+	    if (pcalock) pthread_mutex_unlock(&cc_lock);
 	  }
 
 	  moffset++;
@@ -524,16 +535,16 @@ void * PolarBasis::determine_coefficients_thread(void * arg)
 
 
 	    if (compute and pcavar) {
-	      pthread_mutex_lock(&cc_lock);
-	      *expcoefT1[whch][m] += u[id]*facL;
-	      *expcoefM1[whch][m] += u[id]*u[id].transpose()*facL*facL/mass;
-	      pthread_mutex_unlock(&cc_lock);
+	      if (pcalock) pthread_mutex_lock(&cc_lock);
+	      *coefT1_[whch][m] += u[id]*facL;
+	      *coefM1_[whch][m] += u[id]*u[id].transpose()*facL*facL/mass;
+	      if (pcalock) pthread_mutex_unlock(&cc_lock);
 	    }
 	    
-	    if (compute) {
-	      pthread_mutex_lock(&cc_lock);
-	      tvar[m][0] += u[id]*u[id].transpose()/mass;
-	      pthread_mutex_unlock(&cc_lock);
+	    if (compute and pcaeof) {
+	      if (pcalock) pthread_mutex_lock(&cc_lock);
+	      *tvar_[m] += u[id]*u[id].transpose()/mass;
+	      if (pcalock) pthread_mutex_unlock(&cc_lock);
 	    }
 	  }
 
@@ -656,8 +667,7 @@ void PolarBasis::determine_coefficients_particles(void)
       if (defSampT) sampT = defSampT;
       else          sampT = floor(sqrt(component->CurTotal()));
       massT    .resize(sampT, 0);
-      massT1   .resize(nthrds);
-      for (auto & v : massT1) v.resize(sampT, 0);
+      massT1   .resize(sampT, 0);
       
       expcoefT .resize(sampT);
       for (auto & t : expcoefT ) {
@@ -694,8 +704,14 @@ void PolarBasis::determine_coefficients_particles(void)
       if (pcavar) {
 	for (auto & t : expcoefT1) { for (auto & v : t) v->setZero(); }
 	for (auto & t : expcoefM1) { for (auto & v : t) v->setZero(); }
-	for (auto & v : massT1)    { for (auto & u : v) u = 0;        }
+	for (auto & v : massT1)    v = 0;
+      }
+
+      if (pcaeof) {
+	for (auto & v : tvar) v->setZero();
       }
+
+      pca_thread_zero((Mmax+1)*(Mmax+2)/2);
     }
   }
 
@@ -710,6 +726,11 @@ void PolarBasis::determine_coefficients_particles(void)
   cout << "Process " << myid << ": in <determine_coefficients>" << endl;
 #endif
 
+  // Complete the reduction from the previous pass at this level
+  // before the interpolation arrays are swapped
+  //
+  coefReduce[mlevel].wait();
+
   // Swap interpolation arrays
   //
   auto p = expcoefL[mlevel];
@@ -758,6 +779,8 @@ void PolarBasis::determine_coefficients_particles(void)
     
   // std::fill(use.begin(), use.end(), 0);
 
+  auto startP = std::chrono::high_resolution_clock::now();
+
 #if HAVE_LIBCUDA==1
   (*barrier)("PolarBasis::entering cuda coefficients", __FILE__, __LINE__);
   if (component->cudaDevice>=0 and use_cuda) {
@@ -777,6 +800,11 @@ void PolarBasis::determine_coefficients_particles(void)
 #else
   exp_thread_fork(true);
 #endif
+
+  if (compute and (pcavar or pcaeof)) {
+    auto finishP = std::chrono::high_resolution_clock::now();
+    pca_time_accum += std::chrono::duration<double>(finishP - startP).count();
+  }
   
  #ifdef DEBUG
   cout << "Process " << myid << ": in <determine_coefficients>, thread returned, lev=" << mlevel << endl;
@@ -788,45 +816,10 @@ void PolarBasis::determine_coefficients_particles(void)
     for (int m=0; m<=2*Mmax; m++) *expcoef0[0][m] += *expcoef0[i][m];
   }
 
-  // MPI reduce
+  // MPI reduce: one fused, non-blocking reduction.  The result is
+  // needed by the last level at the latest.
   //
-  for (int m=0, moffset=0; m<=Mmax; m++) {
-
-    if (m==0) {
-	  
-      if (multistep)
-	MPI_Allreduce ( (*expcoef0[0][moffset]).data(),
-			(*expcoefN[mlevel][moffset]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      else
-	MPI_Allreduce ( (*expcoef0[0][moffset]).data(),
-			(*expcoef[moffset]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      
-      moffset++;
-      
-    } else {
-	
-      if (multistep) {
-	MPI_Allreduce ( (*expcoef0[0][moffset]).data(),
-			(*expcoefN[mlevel][moffset]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	  
-	MPI_Allreduce ( (*expcoef0[0][moffset+1]).data(),
-			(*expcoefN[mlevel][moffset+1]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      } else {
-	MPI_Allreduce ( (*expcoef0[0][moffset]).data(),
-			(*expcoef[moffset]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	
-	MPI_Allreduce ( (*expcoef0[0][moffset+1]).data(),
-			(*expcoef[moffset+1]).data(),
-			nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-      }
-      moffset+=2;
-    }
-  }
+  coefReduce[mlevel].post(expcoef0[0], multistep ? expcoefN[mlevel] : expcoef);
   
   if (multistep==0 or (mstep==0 and mlevel==multistep)) {
     // Sum up the particle count and mass from each thread
@@ -846,6 +839,8 @@ void PolarBasis::determine_coefficients_particles(void)
   
   if (mlevel==multistep) {
 
+    finish_coefficients();
+
     //======================================
     // Multistep update
     //======================================
@@ -859,7 +854,11 @@ void PolarBasis::determine_coefficients_particles(void)
     if (compute) {
       for (int i=0; i<nthrds; i++) muse0 += muse1[i];
       MPI_Allreduce ( &muse0, &muse,  1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      pca_thread_reduce();
       parallel_gather_coef2();
+      pca_time_count++;
+      if (component->timers)
+	pca_timing_report("PolarBasis: PCA accumulation timing");
     }
 
     pca_hall(compute);
@@ -945,6 +944,9 @@ void PolarBasis::multistep_reset()
 void PolarBasis::multistep_update_begin()
 {
   if (play_back and not play_cnew) return;
+
+  finish_coefficients();
+
 				// Clear the update matricies
   for (int n=0; n<nthrds; n++) {
     for (int M=mfirst[mstep]; M<=multistep; M++) {
@@ -1113,6 +1115,8 @@ void PolarBasis::compute_multistep_coefficients()
 {
   if (play_back and not play_cnew) return;
 
+  finish_coefficients();
+
 #ifdef TMP_DEBUG
   Eigen::MatrixXd tmpcoef(2*Mmax+1, nmax);
   for (int m=0; m<=2*Mmax; l++) {
@@ -1530,6 +1534,8 @@ void PolarBasis::determine_acceleration_and_potential(void)
   cout << "Process " << myid << ": in determine_acceleration_and_potential\n";
 #endif
 
+  finish_coefficients();
+
   if (play_back) {
     swap_coefs(expcoefP, expcoef);
   }
@@ -4,6 +4,7 @@
 
 #include "expand.H"
 #include <PotAccel.H>
+#include <ThreadPool.H>
 
 extern "C"
 void *
@@ -48,25 +49,6 @@ void PotAccel::exp_thread_fork(bool coef)
     return;
   }
 
-  int errcode;
-  void *retval;
-  
-  td = new thrd_pass_PotAccel [nthrds];
-  t = new pthread_t [nthrds];
-
-  if (!td) {
-    std::ostringstream sout;
-    sout << "Process " << myid 
-	 << ": exp_thread_fork: error allocating memory for thread counters";
-    throw GenericError(sout.str(), __FILE__, __LINE__, 1027, true);
-  }
-  if (!t) {
-    std::ostringstream sout;
-    sout << "Process " << myid
-	 << ": exp_thread_fork: error allocating memory for thread\n";
-    throw GenericError(sout.str(), __FILE__, __LINE__, 1027, true);
-  }
-
   //
   // For determining time in threaded routines
   //
@@ -88,41 +70,18 @@ void PotAccel::exp_thread_fork(bool coef)
 
   }
 
-				// Make the <nthrds> threads
-  for (int i=0; i<nthrds; i++) {
-    td[i].t = this;
-    td[i].coef = coef;
-    td[i].id = i;
-
-    errcode =  pthread_create(&t[i], 0, call_any_threads_thread_call, &td[i]);
-    if (errcode) {
-      std::ostringstream sout;
-      sout << "Process " << myid;
-      if (coef)	sout << ", make_coefficients";
-      else sout << ", determine_acceleration";
-      sout << " thread: cannot make thread " << i
-	   << ", errcode=" << errcode;
-      throw GenericError(sout.str(), __FILE__, __LINE__, 1027, true);
-    }
-#ifdef DEBUG
-    else {
-      cout << "Process " << myid << ": thread <" << i << "> created\n";
-    }
-#endif
-  }
-    
-				// Collapse the threads
-  for (int i=0; i<nthrds; i++) {
-    if ((errcode=pthread_join(t[i], &retval))) {
-      std::ostringstream sout;
-      sout << "Process " << myid;
-      if (coef)	sout << ", make_coefficients";
-      else sout << ", determine_acceleration";
-      sout << " thread: thread join " << i
-	   << " failed, errcode=" << errcode;
-      throw GenericError(sout.str(), __FILE__, __LINE__, 1027, true);
-    }
-  }
+  //
+  // Run the per-thread members on the persistent pool rather than
+  // creating and joining <nthrds> threads on every call
+  //
+  std::vector<thrd_pass_PotAccel> tdata(nthrds);
+
+  ThreadPool::instance().run([&](int i) {
+    tdata[i].t    = this;
+    tdata[i].coef = coef;
+    tdata[i].id   = i;
+    call_any_threads_thread_call(&tdata[i]);
+  });
   
   //
   // For determining time in threaded routines
@@ -145,9 +104,6 @@ void PotAccel::exp_thread_fork(bool coef)
 
   }
 
-  delete [] td;
-  delete [] t;
-
 }
 
 
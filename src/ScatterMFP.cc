@@ -57,7 +57,7 @@ ScatterMFP::ScatterMFP(const YAML::Node& conf) : ExternalForce(conf)
   if (c->ndattrib < mfp_index+1) {
     c->ndattrib = mfp_index+1;
     PartMapItr it;
-    for (it=c->particles.begin(); it!=c->particles.end(); it++)
+    for (it=c->Particles().begin(); it!=c->Particles().end(); it++)
       it->second->dattrib.resize(c->ndattrib);
     
   }
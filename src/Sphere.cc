@@ -53,7 +53,6 @@ Sphere::Sphere(Component* c0, const YAML::Node& conf, MixtureBasis* m) :
   }
 				// Enable MPI code for more than one node
   if (numprocs>1) SLGridSph::mpi = 1;
-
   std::string modelname = model_file;
   std::string cachename = outdir  + cache_file;
 
@@ -62,7 +61,8 @@ Sphere::Sphere(Component* c0, const YAML::Node& conf, MixtureBasis* m) :
 				// Generate Sturm-Liouville grid
   ortho = std::make_shared<SLGridSph>(modelname,
 				      Lmax, nmax, numr, rmin, rmax, true,
-				      cmap, rmap, diverge, dfac, cachename);
+				      cmap, rmap, diverge, dfac, cachename,
+				      false, node_shared);
 
 				// Get the min and max expansion radii
   rmin  = ortho->getRmin();
@@ -151,6 +151,20 @@ void Sphere::get_potl(int lmax, int nmax, double r, Eigen::MatrixXd& p, int tid)
   ortho->get_pot(p, r);
 }
 
+void Sphere::get_potl_batch(int lmax, int nmax, int N, const double* r,
+			    std::vector<Eigen::MatrixXd>& p, int tid)
+{
+  ortho->get_pot(p, r, N);
+}
+
+void Sphere::get_dpotl_batch(int lmax, int nmax, int N, const double* r,
+			     std::vector<Eigen::MatrixXd>& p,
+			     std::vector<Eigen::MatrixXd>& dp, int tid)
+{
+  ortho->get_pot  (p,  r, N);
+  ortho->get_force(dp, r, N);
+}
+
 void Sphere::get_dens(int lmax, int nmax, double r, Eigen::MatrixXd& p, int tid)
 {
   ortho->get_dens(p, r);
@@ -343,7 +357,7 @@ void Sphere::make_model_bin()
     Rmin = exp(Rmin);
     Rmax = exp(Rmax);
   }
-  ortho = std::make_shared<SLGridSph>(mod, Lmax, nmax, numR, Rmin, Rmax, false, 1, 1.0, cachename);
+  ortho = std::make_shared<SLGridSph>(mod, Lmax, nmax, numR, Rmin, Rmax, false, 1, 1.0, cachename, false, node_shared);
 
   // Test for basis consistency (will generate an exception if maximum
   // error is out of tolerance)
@@ -489,7 +503,7 @@ void Sphere::make_model_plummer()
   // Regenerate Sturm-Liouville grid
   //
   std::string cachename = outdir  + cache_file;
-  ortho = std::make_shared<SLGridSph>(mod, Lmax, nmax, numr, Rmin, Rmax, false, 1, 1.0, cachename);
+  ortho = std::make_shared<SLGridSph>(mod, Lmax, nmax, numr, Rmin, Rmax, false, 1, 1.0, cachename, false, node_shared);
 
   // Test for basis consistency (will generate an exception if maximum
   // error is out of tolerance)
@@ -44,6 +44,7 @@ SphericalBasis::valid_keys = {
   "playback",
   "coefCompute",
   "coefMaster",
+  "node_shared",
   "orthocheck"
 };
 
@@ -78,6 +79,7 @@ SphericalBasis::SphericalBasis(Component* c0, const YAML::Node& conf, MixtureBas
   subset           = false;
   setup_noise      = true;
   coefMaster       = true;
+  node_shared      = false;
   lastPlayTime     = -std::numeric_limits<double>::max();
 #if HAVE_LIBCUDA==1
   cuda_aware       = true;
@@ -137,6 +139,8 @@ SphericalBasis::SphericalBasis(Component* c0, const YAML::Node& conf, MixtureBas
       if (ssfrac>0.0 && ssfrac<1.0) subset = true;
     }
 
+    if (conf["node_shared"]) node_shared = conf["node_shared"].as<bool>();
+
     if (conf["playback"]) {
       std::string file = conf["playback"].as<std::string>();
 				// Check the file exists
@@ -150,7 +154,7 @@ SphericalBasis::SphericalBasis(Component* c0, const YAML::Node& conf, MixtureBas
       }
 
       // This creates the Coefs instance
-      playback = std::dynamic_pointer_cast<CoefClasses::SphCoefs>(CoefClasses::Coefs::factory(file));
+      playback = std::dynamic_pointer_cast<CoefClasses::SphCoefs>(CoefClasses::Coefs::factoryShared(file, node_shared));
 
       // Check to make sure that has been created
       if (not playback) {
@@ -288,6 +292,21 @@ SphericalBasis::SphericalBasis(Component* c0, const YAML::Node& conf, MixtureBas
   for (auto & v : potd) v.resize(Lmax+1, nmax);
   for (auto & v : dpot) v.resize(Lmax+1, nmax);
 
+  // Batch radial evaluation
+  //
+  potB    .resize(nthrds);
+  dpotB   .resize(nthrds);
+  coefBlk .resize(nthrds);
+  forceBlk.resize(nthrds);
+
+  for (auto & v : potB)  v.resize(batchSize, Eigen::MatrixXd(Lmax+1, nmax));
+  for (auto & v : dpotB) v.resize(batchSize, Eigen::MatrixXd(Lmax+1, nmax));
+  for (auto & v : coefBlk)  v.resize(batchSize);
+  for (auto & v : forceBlk) v.resize(batchSize);
+
+  legB.resize(nthrds);
+  for (auto & v : legB) v.resize(Lmax);
+
   // Sin, cos, legendre
   //
   cosm .resize(nthrds);
@@ -417,9 +436,14 @@ void * SphericalBasis::determine_coefficients_thread(void * arg)
   //
   double fac0=-4.0*M_PI;
 
+  // Level-ordered slot table, if in use
+  //
+  ParticleSoA *soa = component->useSoA() ? &component->SoA() : 0;
+
   // Partition bodies and get features
   //
   unsigned nbodies = component->levlist[mlevel].size();
+  if (soa) nbodies = soa->levEnd(mlevel) - soa->levBeg(mlevel);
   int id = *((int*)arg);
   int nbeg = nbodies*id/nthrds;
   int nend = nbodies*(id+1)/nthrds;
@@ -446,50 +470,128 @@ void * SphericalBasis::determine_coefficients_thread(void * arg)
 
   unsigned whch = 0;		// For PCA jacknife
 
-  for (int i=nbeg; i<nend; i++) {
+				// PCA accumulators for this thread
+				// (shared and locked if pcalock)
+  auto & massT1_  = pcaMass(id);
+  auto & coefT1_  = pcaT1(id);
+  auto & coefM1_  = pcaM1(id);
+  auto & tvar_    = pcaVar(id);
 
-    int indx = component->levlist[mlevel][i];
+				// Mass and position are streamed from
+				// this thread's slot range
+  unsigned sbeg = soa ? soa->levBeg(mlevel) : 0;
 
-    if (component->freeze(indx)) continue;
+  // Per-thread block of in-range particles for the batch radial
+  // evaluation
+  //
+  auto & blk = coefBlk[id];
 
-    
-    double mass = component->Mass(indx) * adb;
+  for (int i0=nbeg; i0<nend; i0+=batchSize) {
+
+    int i1 = std::min<int>(nend, i0+batchSize), nb = 0;
+
+    // Pass 1: positions, masses and radii
+    //
+    for (int i=i0; i<i1; i++) {
+
+      int indx;
+      double mass, xx, yy, zz;
+
+      if (soa) {
+	unsigned s = sbeg + i;
+	indx = soa->indx[s];
+
+	if (component->freeze(indx)) continue;
+
+	double pos[3] = {soa->pos[0][s], soa->pos[1][s], soa->pos[2][s]};
+	mass = soa->mass[s] * adb;
+	if (subset) mass /= ssfrac;
+
+	if (mix) {
+	  component->ConvertPos(pos, Component::Local);
+	  xx = pos[0] - ctr[0];
+	  yy = pos[1] - ctr[1];
+	  zz = pos[2] - ctr[2];
+	} else {
+	  component->ConvertPos(pos, Component::Local | Component::Centered);
+	  xx = pos[0];
+	  yy = pos[1];
+	  zz = pos[2];
+	}
+      } else {
+	indx = component->levlist[mlevel][i];
+
+	if (component->freeze(indx)) continue;
+
+	mass = component->Mass(indx) * adb;
 				// Adjust mass for subset
-    if (subset) mass /= ssfrac;
-    
-    double xx, yy, zz;
-    if (mix) {
-      xx = component->Pos(indx, 0, Component::Local) - ctr[0];
-      yy = component->Pos(indx, 1, Component::Local) - ctr[1];
-      zz = component->Pos(indx, 2, Component::Local) - ctr[2];
-    } else {
-      xx = component->Pos(indx, 0, Component::Local | Component::Centered);
-      yy = component->Pos(indx, 1, Component::Local | Component::Centered);
-      zz = component->Pos(indx, 2, Component::Local | Component::Centered);
+	if (subset) mass /= ssfrac;
+
+	if (mix) {
+	  xx = component->Pos(indx, 0, Component::Local) - ctr[0];
+	  yy = component->Pos(indx, 1, Component::Local) - ctr[1];
+	  zz = component->Pos(indx, 2, Component::Local) - ctr[2];
+	} else {
+	  xx = component->Pos(indx, 0, Component::Local | Component::Centered);
+	  yy = component->Pos(indx, 1, Component::Local | Component::Centered);
+	  zz = component->Pos(indx, 2, Component::Local | Component::Centered);
+	}
+      }
+
+      double r2 = (xx*xx + yy*yy + zz*zz);
+      double r  = sqrt(r2) + DSMALL;
+
+      if (r>=rmin and r<=rmax) {
+	blk.indx[nb] = indx;
+	blk.mass[nb] = mass;
+	blk.x   [nb] = xx;
+	blk.y   [nb] = yy;
+	blk.z   [nb] = zz;
+	blk.r   [nb] = r;
+	blk.rs  [nb] = r/scale;
+	nb++;
+      }
+
     }
+    // END: pass 1
 
-    double r2 = (xx*xx + yy*yy + zz*zz);
-    double r  = sqrt(r2) + DSMALL;
-      
-    if (r>=rmin and r<=rmax) {
+    // Radial functions for the whole block
+    //
+    get_potl_batch(Lmax, nmax, nb, blk.rs.data(), potB[id], id);
 
-      use[id]++;
-      double costh = zz/r;
-      double phi = atan2(yy,xx);
-      double rs = r/scale;
-      
-      legendre_R(Lmax, costh, legs[id]);
-      sinecosine_R(Lmax, phi, cosm[id], sinm[id]);
+    // Pass 2: accumulate
+    //
+    auto & lb = legB[id];
+    constexpr int W = LegendreBlock<double>::lanes;
+
+    for (int j=0; j<nb; j++) {
+
+      int q = j % W;		// Lane in the Legendre block
+
+      if (q==0) {		// Angular functions for the next W
+	double costh[W], phi[W];
+	int nq = std::min<int>(W, nb-j);
+	for (int k=0; k<nq; k++) {
+	  costh[k] = blk.z[j+k]/blk.r[j+k];
+	  phi[k]   = atan2(blk.y[j+k], blk.x[j+k]);
+	}
+	lb.legendre(costh, nq);
+	lb.sinecosine(Lmax, phi, nq);
+      }
 
-      get_potl(Lmax, nmax, rs, potd[id], id);
+      int    indx = blk.indx[j];
+      double mass = blk.mass[j];
+      auto & potd_ = potB[id][j];
+
+      use[id]++;
 
       if (compute) {
 	muse1[id] += mass;
 	if (pcavar) {
 	  whch = indx % sampT;
-	  pthread_mutex_lock(&cc_lock);
-	  massT1[whch] += mass;
-	  pthread_mutex_unlock(&cc_lock);
+	  if (pcalock) pthread_mutex_lock(&cc_lock);
+	  massT1_[whch] += mass;
+	  if (pcalock) pthread_mutex_unlock(&cc_lock);
 	}
       }
 
@@ -498,32 +600,32 @@ void * SphericalBasis::determine_coefficients_thread(void * arg)
 	//		m loop
 	for (int m=0, moffset=0; m<=l; m++) {
 
-	  double facL = factorial(l, m) * legs[id](l, m);
+	  double facL = factorial(l, m) * lb.P(l, m, q);
 
 	  if (m==0) {
 	    for (int n=0; n<nmax; n++) {
-	      wk[n] = potd[id](l, n)*facL*mass*fac0/sqnorm(l, n);
+	      wk[n] = potd_(l, n)*facL*mass*fac0/sqnorm(l, n);
 	      (*expcoef0[id][loffset+moffset])[n] += wk[n];
 	    }
 
 	    if (compute and pcavar) {
-	      pthread_mutex_lock(&cc_lock);
+	      if (pcalock) pthread_mutex_lock(&cc_lock);
 	      for (int n=0; n<nmax; n++) {
-		(*expcoefT1[whch][iC])[n] += wk[n];
+		(*coefT1_[whch][iC])[n] += wk[n];
 		for (int o=0; o<nmax; o++)
-		  (*expcoefM1[whch][iC])(n, o) += wk[n]*wk[o]/mass;
+		  (*coefM1_[whch][iC])(n, o) += wk[n]*wk[o]/mass;
 	      }
-	      pthread_mutex_unlock(&cc_lock);
+	      if (pcalock) pthread_mutex_unlock(&cc_lock);
 	    }
 
 	    if (compute and pcaeof) {
-	      pthread_mutex_lock(&cc_lock);
+	      if (pcalock) pthread_mutex_lock(&cc_lock);
 	      for (int n=0; n<nmax; n++) {
 		for (int o=0; o<nmax; o++) {
-		  (*tvar[iC])(n, o) += wk[n]*wk[o]/mass;
+		  (*tvar_[iC])(n, o) += wk[n]*wk[o]/mass;
 		}
 	      }
-	      pthread_mutex_unlock(&cc_lock);
+	      if (pcalock) pthread_mutex_unlock(&cc_lock);
 	    }
 
 	    iC++;
@@ -532,35 +634,35 @@ void * SphericalBasis::determine_coefficients_thread(void * arg)
 	  else {
 	    if (not M0_only) {
 
-	      double fac1 = facL*cosm[id][m];
-	      double fac2 = facL*sinm[id][m];
+	      double fac1 = facL*lb.C(m, q);
+	      double fac2 = facL*lb.S(m, q);
 
 	      for (int n=0; n<nmax; n++) {
 
-		wk[n] = potd[id](l, n)*mass*fac0/sqnorm(l, n);
+		wk[n] = potd_(l, n)*mass*fac0/sqnorm(l, n);
 
 		(*expcoef0[id][loffset+moffset  ])[n] += wk[n]*fac1;
 		(*expcoef0[id][loffset+moffset+1])[n] += wk[n]*fac2;
 	      }
 
 	      if (compute and pcavar) {
-		pthread_mutex_lock(&cc_lock);
+		if (pcalock) pthread_mutex_lock(&cc_lock);
 		for (int n=0; n<nmax; n++) {
-		  (*expcoefT1[whch][iC])[n] += wk[n]*facL;
+		  (*coefT1_[whch][iC])[n] += wk[n]*facL;
 		  for (int o=0; o<nmax; o++)
-		    (*expcoefM1[whch][iC])(n, o) += wk[n]*wk[o]*facL*facL/mass;
+		    (*coefM1_[whch][iC])(n, o) += wk[n]*wk[o]*facL*facL/mass;
 		}
-		pthread_mutex_unlock(&cc_lock);
+		if (pcalock) pthread_mutex_unlock(&cc_lock);
 	      }
 	    
 	      if (compute and pcaeof) {
-		pthread_mutex_lock(&cc_lock);
+		if (pcalock) pthread_mutex_lock(&cc_lock);
 		for (int n=0; n<nmax; n++) {
 		  for (int o=0; o<nmax; o++) {
-		    (*tvar[iC])(n, o) += wk[n]*wk[o]/mass;
+		    (*tvar_[iC])(n, o) += wk[n]*wk[o]/mass;
 		  }
 		}
-		pthread_mutex_unlock(&cc_lock);
+		if (pcalock) pthread_mutex_unlock(&cc_lock);
 	      }
 	    }
 
@@ -572,7 +674,7 @@ void * SphericalBasis::determine_coefficients_thread(void * arg)
 
       } // l loop
 
-    } // r < rmax
+    } // block particle loop
 
   } // particle loop
 
@@ -737,6 +839,8 @@ void SphericalBasis::determine_coefficients_particles(void)
       if (pcaeof) {
 	for (auto & v : tvar) v->setZero();
       }
+
+      pca_thread_zero((Lmax+1)*(Lmax+2)/2);
     }
   }
 
@@ -744,6 +848,11 @@ void SphericalBasis::determine_coefficients_particles(void)
   cout << "Process " << myid << ": in <determine_coefficients>" << endl;
 #endif
 
+  // Complete the reduction from the previous pass at this level
+  // before the interpolation arrays are swapped
+  //
+  coefReduce[mlevel].wait();
+
   // Swap interpolation arrays
   //
   auto p = expcoefL[mlevel];
@@ -792,6 +901,12 @@ void SphericalBasis::determine_coefficients_particles(void)
     
   std::fill(use.begin(), use.end(), 0);
 
+  // Refresh the slot table before forking the threads
+  //
+  if (component->useSoA()) component->SoA();
+
+  auto startP = std::chrono::high_resolution_clock::now();
+
 #if HAVE_LIBCUDA==1
   if (component->cudaDevice>=0 and use_cuda) {
     if (cudaAccumOverride) {
@@ -809,6 +924,11 @@ void SphericalBasis::determine_coefficients_particles(void)
 #else
   exp_thread_fork(true);
 #endif
+
+  if (compute and (pcavar or pcaeof)) {
+    auto finishP = std::chrono::high_resolution_clock::now();
+    pca_time_accum += std::chrono::duration<double>(finishP - startP).count();
+  }
   
  #ifdef DEBUG
   cout << "Process " << myid << ": in <determine_coefficients>, thread returned, lev=" << mlevel << endl;
@@ -825,46 +945,10 @@ void SphericalBasis::determine_coefficients_particles(void)
     used += use1;
   }
   
-  for (int l=0, loffset=0; l<=Lmax; loffset+=(2*l+1), l++) {
-    
-    for (int m=0, moffset=0; m<=l; m++) {
-
-      if (m==0) {
-	  
-	if (multistep)
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset]).data(),
-			  (*expcoefN[mlevel][loffset+moffset]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	else
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset]).data(),
-			  (*expcoef[loffset+moffset]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	
-	moffset++;
-	  
-      } else {
-	
-	if (multistep) {
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset]).data(),
-			  (*expcoefN[mlevel][loffset+moffset]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	  
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset+1]).data(),
-			  (*expcoefN[mlevel][loffset+moffset+1]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	} else {
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset]).data(),
-			  (*expcoef[loffset+moffset]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	  
-	  MPI_Allreduce ( (*expcoef0[0][loffset+moffset+1]).data(),
-			  (*expcoef[loffset+moffset+1]).data(),
-			  nmax, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-	}
-	moffset+=2;
-      }
-    }
-  }
+  // Sum over processes with one fused, non-blocking reduction.  The
+  // result is needed by the last level at the latest.
+  //
+  coefReduce[mlevel].post(expcoef0[0], multistep ? expcoefN[mlevel] : expcoef);
   
   //======================================
   // Last level?
@@ -872,6 +956,8 @@ void SphericalBasis::determine_coefficients_particles(void)
   
   if (mlevel==multistep) {
 
+    finish_coefficients();
+
     //======================================
     // Multistep update
     //======================================
@@ -885,7 +971,11 @@ void SphericalBasis::determine_coefficients_particles(void)
     if (compute) {
       for (int i=0; i<nthrds; i++) muse0 += muse1[i];
       MPI_Allreduce ( &muse0, &muse,  1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+      pca_thread_reduce();
       parallel_gather_coef2();
+      pca_time_count++;
+      if (component->timers)
+	pca_timing_report("SphericalBasis: PCA accumulation timing");
     }
 
     pca_hall(compute);
@@ -975,6 +1065,8 @@ void SphericalBasis::multistep_update_begin()
 {
   if (play_back and not play_cnew) return;
 
+  finish_coefficients();
+
 				// Clear the update matricies
   for (int n=0; n<nthrds; n++) {
     for (int M=mfirst[mdrft]; M<=multistep; M++) differ1[n][M].setZero();
@@ -1193,6 +1285,8 @@ void SphericalBasis::compute_multistep_coefficients()
 {
   if (play_back and not play_cnew) return;
 
+  finish_coefficients();
+
 #ifdef TMP_DEBUG
   Eigen::MatrixXd tmpcoef((Lmax+1)*(Lmax+1), nmax);
   for (int l=0; l<(Lmax+1)*(Lmax+1); l++) {
@@ -1455,11 +1549,26 @@ void * SphericalBasis::determine_acceleration_and_potential_thread(void * arg)
 
   thread_timing_beg(id);
 
+  auto & fblk = forceBlk[id];
+
+  // Level-ordered slot table, if in use.  All levels at or above
+  // <mlevel> are one contiguous slot range so a single pass suffices.
+  //
+  ParticleSoA *soa = cC->useSoA() ? &cC->SoA() : 0;
+  int levtop = soa ? mlevel : multistep;
+
   // If we are multistepping, compute accel only at or above <mlevel>
   //
-  for (int lev=mlevel; lev<=multistep; lev++) {
+  for (int lev=mlevel; lev<=levtop; lev++) {
 
-    unsigned nbodies = cC->levlist[lev].size();
+    unsigned nbodies, sbeg = 0;
+    if (soa) {
+      auto range = soa->levRange(mlevel, multistep);
+      sbeg    = range.first;
+      nbodies = range.second - range.first;
+    } else {
+      nbodies = cC->levlist[lev].size();
+    }
 
     if (nbodies==0) continue;
 
@@ -1475,142 +1584,218 @@ void * SphericalBasis::determine_acceleration_and_potential_thread(void * arg)
     pthread_mutex_unlock(&io_lock);
 #endif
 
-    for (int i=nbeg; i<nend; i++) {
+    for (int i0=nbeg; i0<nend; i0+=batchSize) {
 
-      int indx = cC->levlist[lev][i];
+      int i1 = std::min<int>(nend, i0+batchSize), nb = 0;
 
-      if (cC->freeze(indx)) continue;
+      // Pass 1: positions and radii
+      //
+      for (int i=i0; i<i1; i++) {
 
-      if (mix) {
-	if (use_external) {
-	  cC->Pos(pos, indx, Component::Inertial);
-	  component->ConvertPos(pos, Component::Local);
-	} else
-	  cC->Pos(pos, indx, Component::Local);
+	int indx = 0, slot = -1;
 
-	mfactor = mix->Mixture(pos);
-	xx = pos[0] - ctr[0];
-	yy = pos[1] - ctr[1];
-	zz = pos[2] - ctr[2];
-      } else {
-	if (use_external) {
-	  cC->Pos(pos, indx, Component::Inertial);
-	  component->ConvertPos(pos, Component::Local | Component::Centered);
-	} else
-	  cC->Pos(pos, indx, Component::Local | Component::Centered);
-	
-	xx = pos[0];
-	yy = pos[1];
-	zz = pos[2];
-      }	
-
-      double r = sqrt(xx*xx + yy*yy + zz*zz) + DSMALL;
-      double costh = zz/r;
-      double rs = r/scale;
-      double phi = atan2(yy, xx);
-
-      dlegendre_R (Lmax, costh, legs[id], dlegs[id]);
-      sinecosine_R(Lmax, phi,   cosm[id], sinm [id]);
-
-      int ioff = 0;
-      if (r>rmax) {
-	ioff = 1;
-	r0   = r;
-	r    = rmax;
-	rs   = r/scale;
+	if (soa) {
+	  slot = sbeg + i;
+	  indx = soa->indx[slot];
+
+	  if (cC->freeze(indx)) continue;
+
+	  for (int k=0; k<3; k++) pos[k] = soa->pos[k][slot];
+
+	  unsigned flags = Component::Local;
+	  if (not mix) flags |= Component::Centered;
+	  if (use_external) component->ConvertPos(pos, flags);
+	  else              cC->ConvertPos(pos, flags);
+	} else {
+	  indx = cC->levlist[lev][i];
+	  if (cC->freeze(indx)) continue;
+	}
+
+	if (mix) {
+	  if (slot>=0) {	// Position already converted
+	  } else if (use_external) {
+	    cC->Pos(pos, indx, Component::Inertial);
+	    component->ConvertPos(pos, Component::Local);
+	  } else
+	    cC->Pos(pos, indx, Component::Local);
+
+	  mfactor = mix->Mixture(pos);
+	  xx = pos[0] - ctr[0];
+	  yy = pos[1] - ctr[1];
+	  zz = pos[2] - ctr[2];
+	} else {
+	  if (slot>=0) {	// Position already converted
+	  } else if (use_external) {
+	    cC->Pos(pos, indx, Component::Inertial);
+	    component->ConvertPos(pos, Component::Local | Component::Centered);
+	  } else
+	    cC->Pos(pos, indx, Component::Local | Component::Centered);
+
+	  xx = pos[0];
+	  yy = pos[1];
+	  zz = pos[2];
+	}	
+
+	double r = sqrt(xx*xx + yy*yy + zz*zz) + DSMALL;
+
+	fblk.slot [nb] = slot;
+	fblk.indx [nb] = indx;
+	fblk.mfac [nb] = mfactor;
+	fblk.x    [nb] = xx;
+	fblk.y    [nb] = yy;
+	fblk.z    [nb] = zz;
+	fblk.r    [nb] = r;
+	fblk.rs   [nb] = std::min<double>(r, rmax)/scale;
+	nb++;
       }
+      // END: pass 1
 
-      // Zero coefficient accumulated field values
+      // Radial functions for the whole block
       //
-      potl = potr = pott = potp = 0.0;
-      
-      get_dpotl(Lmax, nmax, rs, potd[id], dpot[id], id);
+      get_dpotl_batch(Lmax, nmax, nb, fblk.rs.data(), potB[id], dpotB[id], id);
 
-      if (!NO_L0) {
-	get_pot_coefs_safe(0, *expcoef[0], p, dp, potd[id], dpot[id]);
-	if (ioff) {
-	  p *= rmax/r0;
-	  dp = -p/r0;
+      // Pass 2: forces
+      //
+      auto & lb = legB[id];
+      constexpr int W = LegendreBlock<double>::lanes;
+
+      for (int j=0; j<nb; j++) {
+
+	int q = j % W;		// Lane in the Legendre block
+
+	if (q==0) {		// Angular functions for the next W
+	  double costh[W], phi[W];
+	  int nq = std::min<int>(W, nb-j);
+	  for (int k=0; k<nq; k++) {
+	    costh[k] = fblk.z[j+k]/fblk.r[j+k];
+	    phi[k]   = atan2(fblk.y[j+k], fblk.x[j+k]);
+	  }
+	  lb.dlegendre(costh, nq);
+	  lb.sinecosine(Lmax, phi, nq);
 	}
-	double facL = mfactor * factorial(0, 0);
-	potl = facL * p;
-	potr = facL * dp;
-      }
-      
-      //		l loop
-      //		------
-      for (int l=1, loffset=1; l<=Lmax; loffset+=(2*l+1), l++) {
+
+	int slot = fblk.slot[j];
+	int indx = fblk.indx[j];
+	mfactor = fblk.mfac[j];
+	xx = fblk.x[j];
+	yy = fblk.y[j];
+	zz = fblk.z[j];
+
+	auto & potd_ = potB [id][j];
+	auto & dpot_ = dpotB[id][j];
+
+	double r = fblk.r[j];
+
+	int ioff = 0;
+	if (r>rmax) {
+	  ioff = 1;
+	  r0   = r;
+	  r    = rmax;
+	}
+
+	// Zero coefficient accumulated field values
+	//
+	potl = potr = pott = potp = 0.0;
+
+	if (!NO_L0) {
+	  get_pot_coefs_safe(0, *expcoef[0], p, dp, potd_, dpot_);
+	  if (ioff) {
+	    p *= rmax/r0;
+	    dp = -p/r0;
+	  }
+	  double facL = mfactor * factorial(0, 0);
+	  potl = facL * p;
+	  potr = facL * dp;
+	}
+
+	//		l loop
+	//		------
+	for (int l=1, loffset=1; l<=Lmax; loffset+=(2*l+1), l++) {
 
 				// Suppress L=1 terms?
-	if (NO_L1 && l==1) continue;
-	
+	  if (NO_L1 && l==1) continue;
+
 				// Suppress odd L terms?
-	if (EVEN_L && (l/2)*2 != l) continue;
+	  if (EVEN_L && (l/2)*2 != l) continue;
 
-	//		m loop
-	//		------
-	for (int m=0, moffset=0; m<=l; m++) {
-	  
-	  double facL = factorial(l, m) *  legs[id](l, m) * mfactor;
-	  double facD = factorial(l, m) * dlegs[id](l, m) * mfactor;
+	  //		m loop
+	  //		------
+	  for (int m=0, moffset=0; m<=l; m++) {
+
+	    double facL = factorial(l, m) *  lb.P(l, m, q) * mfactor;
+	    double facD = factorial(l, m) * lb.dP(l, m, q) * mfactor;
 
 				// Suppress odd M terms?
-	  if (EVEN_M && (m/2)*2 != m) continue;
+	    if (EVEN_M && (m/2)*2 != m) continue;
 
 				// Suppress all asymmetric terms
-	  if (M0_only and m!=0) continue;
-
-	  if (m==0) {
-	    get_pot_coefs_safe(l, *expcoef[loffset+moffset], p, dp,
-			       potd[id], dpot[id]);
-	    if (ioff) {
-	      p *= pow(rmax/r0,(double)(l+1));
-	      dp = -p/r0 * (l+1);
+	    if (M0_only and m!=0) continue;
+
+	    if (m==0) {
+	      get_pot_coefs_safe(l, *expcoef[loffset+moffset], p, dp,
+				 potd_, dpot_);
+	      if (ioff) {
+		p *= pow(rmax/r0,(double)(l+1));
+		dp = -p/r0 * (l+1);
+	      }
+	      potl += facL * p;
+	      potr += facL * dp;
+	      pott += facD * p;
+	      moffset++;
 	    }
-	    potl += facL * p;
-	    potr += facL * dp;
-	    pott += facD * p;
-	    moffset++;
-	  }
-	  else {
-	    get_pot_coefs_safe(l, *expcoef[loffset+moffset], pc, dpc,
-			       potd[id], dpot[id]);
-
-	    get_pot_coefs_safe(l, *expcoef[loffset+moffset+1], ps, dps,
-			       potd[id], dpot[id]);
-	    if (ioff) {		// Factors for external multipole solution
-	      facp  = pow(rmax/r0,(double)(l+1));
-	      facdp = -1.0/r0 * (l+1);
+	    else {
+	      get_pot_coefs_safe(l, *expcoef[loffset+moffset], pc, dpc,
+				 potd_, dpot_);
+
+	      get_pot_coefs_safe(l, *expcoef[loffset+moffset+1], ps, dps,
+				 potd_, dpot_);
+	      if (ioff) {		// Factors for external multipole solution
+		facp  = pow(rmax/r0,(double)(l+1));
+		facdp = -1.0/r0 * (l+1);
 				// Apply the factors
-	      pc   *= facp;
-	      ps   *= facp;
-	      dpc   = pc * facdp;
-	      dps   = ps * facdp;
+		pc   *= facp;
+		ps   *= facp;
+		dpc   = pc * facdp;
+		dps   = ps * facdp;
+	      }
+	      potl += facL * (pc *lb.C(m, q) + ps *lb.S(m, q) );
+	      potr += facL * (dpc*lb.C(m, q) + dps*lb.S(m, q) );
+	      pott += facD * (pc *lb.C(m, q) + ps *lb.S(m, q) );
+	      potp += facL * (-pc*lb.S(m, q) + ps *lb.C(m, q) )*m;
+	      moffset +=2;
 	    }
-	    potl += facL * (pc *cosm[id][m] + ps *sinm[id][m] );
-	    potr += facL * (dpc*cosm[id][m] + dps*sinm[id][m] );
-	    pott += facD * (pc *cosm[id][m] + ps *sinm[id][m] );
-	    potp += facL * (-pc*sinm[id][m] + ps *cosm[id][m] )*m;
-	    moffset +=2;
 	  }
 	}
-      }
 
-      double fac = xx*xx + yy*yy;
+	double fac = xx*xx + yy*yy;
+
+	potr /= scale*scale;
+	potl /= scale;
+	pott /= scale;
+	potp /= scale;
 
-      potr /= scale*scale;
-      potl /= scale;
-      pott /= scale;
-      potp /= scale;
+	if (slot>=0) {		// Direct update of the slot arrays
+	  soa->acc[0][slot] += -(potr*xx/r - pott*xx*zz/(r*r*r));
+	  soa->acc[1][slot] += -(potr*yy/r - pott*yy*zz/(r*r*r));
+	  soa->acc[2][slot] += -(potr*zz/r + pott*fac/(r*r*r))  ;
+	  if (fac > DSMALL) {
+	    soa->acc[0][slot] +=  potp*yy/fac;
+	    soa->acc[1][slot] += -potp*xx/fac;
+	  }
+	  soa->pot[slot] += potl;
+	  continue;
+	}
 
-      cC->AddAcc(indx, 0, -(potr*xx/r - pott*xx*zz/(r*r*r)) );
-      cC->AddAcc(indx, 1, -(potr*yy/r - pott*yy*zz/(r*r*r)) );
-      cC->AddAcc(indx, 2, -(potr*zz/r + pott*fac/(r*r*r))   );
-      if (fac > DSMALL) {
-	cC->AddAcc(indx, 0,  potp*yy/fac );
-	cC->AddAcc(indx, 1, -potp*xx/fac );
+	cC->AddAcc(indx, 0, -(potr*xx/r - pott*xx*zz/(r*r*r)) );
+	cC->AddAcc(indx, 1, -(potr*yy/r - pott*yy*zz/(r*r*r)) );
+	cC->AddAcc(indx, 2, -(potr*zz/r + pott*fac/(r*r*r))   );
+	if (fac > DSMALL) {
+	  cC->AddAcc(indx, 0,  potp*yy/fac );
+	  cC->AddAcc(indx, 1, -potp*xx/fac );
+	}
+	cC->AddPot(indx, potl);
       }
-      cC->AddPot(indx, potl);
+      // END: pass 2
     }
 
   }
@@ -1634,6 +1819,8 @@ void SphericalBasis::determine_acceleration_and_potential(void)
   cout << "Process " << myid << ": in determine_acceleration_and_potential\n";
 #endif
 
+  finish_coefficients();
+
   if (play_back) {
     swap_coefs(expcoefP, expcoef);
   }
@@ -1646,6 +1833,10 @@ void SphericalBasis::determine_acceleration_and_potential(void)
 
   }
 
+  // Refresh the slot table before forking the threads
+  //
+  if (cC->useSoA()) cC->SoA();
+
 #if HAVE_LIBCUDA==1
   if (use_cuda and cC->cudaDevice>=0 and cC->force->cudaAware()) {
     if (cudaAccelOverride) {
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+
+#include "expand.H"
+#include <ThreadPool.H>
+
+// Worker id of the current thread inside a job (-1 outside)
+static thread_local int pool_id = -1;
+
+ThreadPool& ThreadPool::instance()
+{
+  static ThreadPool pool(nthrds);
+  return pool;
+}
+
+ThreadPool::ThreadPool(int N) :
+  nthreads(std::max<int>(1, N)), generation(0), pending(0), shutdown(false),
+  blocks(std::max<int>(1, N)), stats(std::max<int>(1, N))
+{
+  for (int n=1; n<nthreads; n++)
+    threads.emplace_back(&ThreadPool::worker, this, n);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    shutdown = true;
+  }
+  cv_start.notify_all();
+  for (auto & t : threads) t.join();
+}
+
+void ThreadPool::worker(int id)
+{
+  unsigned long seen = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv_start.wait(lock, [&]{ return shutdown or generation != seen; });
+      if (shutdown) return;
+      seen = generation;
+    }
+
+    execute(id);
+
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (--pending == 0) cv_done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::execute(int id)
+{
+  pool_id = id;
+
+  auto beg = std::chrono::steady_clock::now();
+
+  try {
+    job(id);
+  }
+  catch (...) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (not error) error = std::current_exception();
+  }
+
+  auto end = std::chrono::steady_clock::now();
+
+  stats[id].s.busy += std::chrono::duration<double>(end - beg).count();
+  stats[id].s.jobs++;
+  stats[id].finish = end;
+
+  pool_id = -1;
+}
+
+void ThreadPool::dispatch(std::function<void(int)> f)
+{
+  std::lock_guard<std::mutex> guard(submit);
+
+  job   = f;
+  error = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    pending = nthreads - 1;
+    generation++;
+  }
+  cv_start.notify_all();
+
+  execute(0);			// The caller is worker 0
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv_done.wait(lock, [&]{ return pending == 0; });
+  }
+
+  // Everybody waits for the slowest worker
+  //
+  auto last = stats[0].finish;
+  for (int n=1; n<nthreads; n++) last = std::max(last, stats[n].finish);
+  for (int n=0; n<nthreads; n++)
+    stats[n].s.idle += std::chrono::duration<double>(last - stats[n].finish).count();
+
+  job = nullptr;
+
+  if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::run(const Task& f)
+{
+  // Serial execution for one worker or for a nested call
+  //
+  if (nthreads==1 or pool_id>=0) {
+    for (int n=0; n<nthreads; n++) f(n);
+    return;
+  }
+
+  dispatch(f);
+}
+
+bool ThreadPool::next_chunk(int id, unsigned chunk,
+			    unsigned& first, unsigned& last)
+{
+  // Take from the front of our own block
+  //
+  uint64_t cur = blocks[id].r.load();
+  while (lo(cur) > hi(cur)) {
+    unsigned a = hi(cur), b = std::min<unsigned>(lo(cur), a + chunk);
+    if (blocks[id].r.compare_exchange_weak(cur, pack(b, lo(cur)))) {
+      first = a;
+      last  = b;
+      return true;
+    }
+  }
+
+  // Our block is empty: steal the back half of the largest block
+  //
+  while (true) {
+    int victim = -1;
+    unsigned most = 0;
+    for (int n=0; n<nthreads; n++) {
+      if (n==id) continue;
+      uint64_t v = blocks[n].r.load();
+      if (lo(v) > hi(v) and lo(v) - hi(v) > most) {
+	most   = lo(v) - hi(v);
+	victim = n;
+      }
+    }
+
+    if (victim<0) return false;	// Nothing left anywhere
+
+    uint64_t v = blocks[victim].r.load();
+    unsigned a = hi(v), b = lo(v);
+    if (b <= a) continue;
+
+    // Take the whole remainder if it is no more than a chunk so that
+    // the tail is not split into ever smaller pieces
+    unsigned mid = b - a <= chunk ? a : a + (b - a + 1)/2;
+    if (blocks[victim].r.compare_exchange_strong(v, pack(a, mid))) {
+      stats[id].s.steals++;
+      // Keep one chunk and publish the rest as our own block
+      unsigned c = std::min<unsigned>(b, mid + chunk);
+      blocks[id].r.store(pack(c, b));
+      first = mid;
+      last  = c;
+      return true;
+    }
+  }
+}
+
+void ThreadPool::parallel_for(unsigned beg, unsigned end, const RangeTask& f,
+			      unsigned chunk)
+{
+  if (end <= beg) return;
+
+  unsigned N = end - beg;
+
+  // Serial execution for one worker or for a nested call
+  //
+  if (nthreads==1 or pool_id>=0) {
+    f(std::max<int>(pool_id, 0), beg, end);
+    return;
+  }
+
+  if (chunk==0) chunk = pool_chunk;
+  if (chunk==0) chunk = std::max<unsigned>(64, N/(8*nthreads));
+
+  // Initial static partition
+  //
+  for (int n=0; n<nthreads; n++) {
+    unsigned a = beg + static_cast<uint64_t>(N)*(n  )/nthreads;
+    unsigned b = beg + static_cast<uint64_t>(N)*(n+1)/nthreads;
+    blocks[n].r.store(pack(a, b));
+  }
+
+  dispatch([&](int id) {
+    unsigned first, last;
+    while (next_chunk(id, chunk, first, last)) {
+      stats[id].s.chunks++;
+      f(id, first, last);
+    }
+  });
+}
+
+std::vector<ThreadPool::Stats> ThreadPool::getStats()
+{
+  std::vector<Stats> ret;
+  for (auto & v : stats) ret.push_back(v.s);
+  return ret;
+}
+
+void ThreadPool::resetStats()
+{
+  for (auto & v : stats) v.s = Stats();
+}
+
+void ThreadPool::report(std::ostream& out, const std::string& label)
+{
+  out << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setw(70) << std::left << "--- " + label << std::endl
+      << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setfill(' ') << std::right
+      << std::setw(6)  << "Thrd"
+      << std::setw(14) << "Busy"
+      << std::setw(14) << "Idle"
+      << std::setw(8)  << "Idle%"
+      << std::setw(10) << "Jobs"
+      << std::setw(10) << "Chunks"
+      << std::setw(10) << "Steals" << std::endl;
+
+  for (int n=0; n<nthreads; n++) {
+    const Stats& s = stats[n].s;
+    double tot = s.busy + s.idle;
+    out << std::setw(6)  << n
+	<< std::setw(14) << std::setprecision(6) << s.busy
+	<< std::setw(14) << std::setprecision(6) << s.idle
+	<< std::setw(8)  << std::setprecision(3)
+	<< (tot>0.0 ? 100.0*s.idle/tot : 0.0)
+	<< std::setw(10) << s.jobs
+	<< std::setw(10) << s.chunks
+	<< std::setw(10) << s.steals << std::endl;
+  }
+
+  out << std::setw(70) << std::setfill('-') << '-' << std::endl
+      << std::setfill(' ');
+}
@@ -128,7 +128,7 @@ void Orient::accumulate_gpu(double time, Component *c)
   // Prepare bunch loop
   //
   unsigned nbodies = c->Number();
-  unsigned tkeep = many/numprocs;
+  unsigned tkeep = many + 1;	// Enough for an exact global cut
 
   const unsigned oBunchSize = 200000;
   unsigned int Npacks = nbodies/oBunchSize + 1;
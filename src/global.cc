@@ -14,6 +14,7 @@
 int nsteps = 500;		// Number of steps to execute
 int nscale = 20;		// Number of steps between rescaling
 int ngpus  = 0;	                // Number of GPUs per node (0 means use all available)
+unsigned pool_chunk = 0;	// Thread pool chunk size (0 means automatic)
 int nbalance = 0;		// Steps between load balancing
 int nreport = 0;		// Steps between particle reporting
 double dbthresh = 0.05;		// Load balancing threshold (5% by default)
@@ -82,17 +83,6 @@ int cudaGlobalDevice;
 #endif
 
 
-				// Multithreading data structures for
-				// incr_position and incr_velocity
-/*struct thrd_pass_posvel 
-{
-  double dt;
-  int mlevel;
-  int id;
-};*/
-
-vector<thrd_pass_posvel> posvel_data;
-vector<pthread_t> posvel_thrd;
 int is_init=1;
 
 				// List of host names and ranks
@@ -139,6 +129,8 @@ bool fpe_wait      = false;
 bool traceback     = false;
 
 bool ignore_info   = false;
+bool mpiio_restart = true;
+int  h5coef_version = 1;
 bool all_couples   = true;
 
 int  rlimit_val    = 0;
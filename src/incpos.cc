@@ -3,6 +3,7 @@
 */
 
 #include "expand.H"
+#include <ThreadPool.H>
 
 #ifdef USE_GPTL
 #include <gptl.h>
@@ -12,64 +13,6 @@
 void incr_position_cuda(cuFP_t dt, int mlevel);
 #endif
 
-void * incr_position_thread(void *ptr)
-{
-  // Current time step
-  //
-  double dt = static_cast<thrd_pass_posvel*>(ptr)->dt;
-
-  // Current level
-  //
-  int mlevel = static_cast<thrd_pass_posvel*>(ptr)->mlevel;
-
-  // Thread ID
-  //
-  int id = static_cast<thrd_pass_posvel*>(ptr)->id;
-
-  
-  int nbeg, nend, indx;
-  unsigned ntot;
-  Component *c;
-  
-  //
-  // Component loop
-  //
-  for (auto c : comp->components) {
-
-    if (mlevel>=0)		// Use a particular level
-      ntot = c->levlist[mlevel].size();
-    else			// Use ALL levels
-      ntot = c->Number();
-      
-    if (ntot==0) continue;
-
-    //
-    // Compute the beginning and end points in particle list
-    // for each thread
-    //
-    nbeg = ntot*(id  )/nthrds;
-    nend = ntot*(id+1)/nthrds;
-
-    PartMapItr it = c->Particles().begin();
-
-    for (int q=0   ; q<nbeg; q++) it++;
-    for (int q=nbeg; q<nend; q++) {
-
-      if (mlevel>=0)
-	indx = c->levlist[mlevel][q];
-      else
-	indx = (it++)->first;
-
-      Particle *p = c->Part(indx);
-      for (int k=0; k<c->dim; k++) 
-	p->pos[k] += p->vel[k]*dt;
-    }
-  }
-
-  return (NULL);
-}
-
-
 void incr_position(double dt, int mlevel)
 {
   if (!eqmotion) return;
@@ -85,61 +28,68 @@ void incr_position(double dt, int mlevel)
   }
 #endif
 
-  if (nthrds==1) {
-
-    posvel_data[0].dt = dt;
-    posvel_data[0].mlevel = mlevel;
-    posvel_data[0].id = 0;
+  ThreadPool& pool = ThreadPool::instance();
 
-    incr_position_thread(&posvel_data[0]);
+  //
+  // Component loop
+  //
+  for (auto c : comp->components) {
 
-  } else {
+    int dim = c->dim;
 
     //
-    // Make the <nthrds> threads
+    // Use the level-ordered slot arrays: the particles at this level
+    // are a contiguous slot range
     //
-    int errcode;
-    void *retval;
-  
-    for (int i=0; i<nthrds; i++) {
-
-      posvel_data[i].dt = dt;
-      posvel_data[i].mlevel = mlevel;
-      posvel_data[i].id = i;
-      
-      pthread_t *p = &posvel_thrd[i];
-      errcode =  pthread_create(p, 0, incr_position_thread, &posvel_data[i]);
-
-      if (errcode) {
-	std::ostringstream sout;
-	sout << "Process " << myid
-	     << " incr_position: cannot make thread " << i
-	     << ", errcode=" << errcode;;
-	throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-      }
-#ifdef DEBUG
-      else {
-	cout << "Process " << myid << ": thread <" << i << "> created\n";
+    if (c->useSoA()) {
+      ParticleSoA& soa = c->SoA();
+      unsigned sbeg = 0, send = soa.size();
+      if (mlevel>=0) {
+	sbeg = soa.levBeg(mlevel);
+	send = soa.levEnd(mlevel);
       }
-#endif
+
+      pool.parallel_for(sbeg, send, [&](int id, unsigned first, unsigned last) {
+	for (int k=0; k<dim; k++) {
+	  double *x = soa.pos[k].data();
+	  const double *v = soa.vel[k].data();
+#pragma omp simd
+	  for (unsigned s=first; s<last; s++) x[s] += v[s]*dt;
+	}
+      });
     }
-    
     //
-    // Collapse the threads
+    // Use a particular level: chunks of the level list
     //
-    for (int i=0; i<nthrds; i++) {
-      pthread_t p = posvel_thrd[i];
-      if ((errcode=pthread_join(p, &retval))) {
-	std::ostringstream sout;
-	sout << "Process " << myid
-	     << " incr_position: thread join " << i
-	     << " failed, errcode=" << errcode;
-	throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-      }
-#ifdef DEBUG    
-      cout << "Process " << myid << ": incr_position thread <" 
-	   << i << "> thread exited\n";
-#endif
+    else if (mlevel>=0) {
+      auto & lev = c->levlist[mlevel];
+
+      pool.parallel_for(0, lev.size(), [&](int id, unsigned first, unsigned last) {
+	for (unsigned q=first; q<last; q++) {
+	  Particle *p = c->Part(lev[q]);
+	  for (int k=0; k<dim; k++) p->pos[k] += p->vel[k]*dt;
+	}
+      });
+    }
+    //
+    // Use ALL levels: static split of the particle map
+    //
+    else {
+      unsigned ntot = c->Number();
+      if (ntot==0) continue;
+
+      pool.run([&](int id) {
+	unsigned nbeg = ntot*(id  )/pool.size();
+	unsigned nend = ntot*(id+1)/pool.size();
+
+	PartMapItr it = c->Particles().begin();
+	std::advance(it, nbeg);
+
+	for (unsigned q=nbeg; q<nend; q++) {
+	  Particle *p = (it++)->second.get();
+	  for (int k=0; k<dim; k++) p->pos[k] += p->vel[k]*dt;
+	}
+      });
     }
   }
   
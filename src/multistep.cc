@@ -3,6 +3,7 @@
 */
 
 #include <expand.H>
+#include <ThreadPool.H>
 #include <sstream>
 #include <chrono>
 #include <limits>
@@ -30,6 +31,9 @@ struct thrd_pass_sync
 
   //! Component
   Component *c;
+
+  //! Range in the level list
+  int beg, end;
 };
 
 //
@@ -69,27 +73,53 @@ void * adjust_multistep_level_thread(void *ptr)
   // criterion and adjust level if necessary
 
   double dt, dts, dtv, dta, dtA, dtd, dtr, dsr, rtot, vtot, atot, ptot;
-  int npart = c->levlist[level].size();
   int offlo = 0, offhi = 0;
 
   //
-  // Compute the beginning and end points for threads
+  // The chunk of the level list assigned by the thread pool
   //
-  int nbeg = npart*id    /nthrds;
-  int nend = npart*(id+1)/nthrds;
+  int nbeg = static_cast<thrd_pass_sync*>(ptr)->beg;
+  int nend = static_cast<thrd_pass_sync*>(ptr)->end;
 
   //
   // Small positive constant
   //
   const double eps = 1.0e-10;
 
+  //
+  // The level lists are in slot order if the component uses the
+  // slot arrays
+  //
+  ParticleSoA *soa = c->soaResident() ? &c->SoA() : 0;
+  unsigned sbeg = soa ? soa->levBeg(level) : 0;
+
   //
   // The particle loop
   //
   for (int i=nbeg; i<nend; i++) {
 
     int n = c->levlist[level][i];
-    Particle *p = c->Part(n);
+    Particle *p;
+    double vel[3], acc[3], pot, potext;
+
+    if (soa) {
+      unsigned s = sbeg + i;
+      p = soa->owner[s];
+      for (int k=0; k<c->dim; k++) {
+	vel[k] = soa->vel[k][s];
+	acc[k] = soa->acc[k][s];
+      }
+      pot    = soa->pot[s];
+      potext = soa->potext[s];
+    } else {
+      p = c->Part(n);
+      for (int k=0; k<c->dim; k++) {
+	vel[k] = p->vel[k];
+	acc[k] = p->acc[k];
+      }
+      pot    = p->pot;
+      potext = p->potext;
+    }
 
     // dtd = eps* rscale/v_i    -- char. drift time scale
     // dtv = eps* min(v_i/a_i)  -- char. force time scale
@@ -101,11 +131,11 @@ void * adjust_multistep_level_thread(void *ptr)
     atot = 0.0;
 
     for (int k=0; k<c->dim; k++) {
-      dtr  += p->vel[k]*p->acc[k];
-      vtot += p->vel[k]*p->vel[k];
-      atot += p->acc[k]*p->acc[k];
+      dtr  += vel[k]*acc[k];
+      vtot += vel[k]*vel[k];
+      atot += acc[k]*acc[k];
     }
-    ptot = fabs(p->pot + p->potext);
+    ptot = fabs(pot + potext);
 
 
     dsr = p->scale;
@@ -403,25 +433,6 @@ void adjust_multistep_level()
     }
   }
 
-  thrd_pass_sync* td = new thrd_pass_sync [nthrds];
-
-  if (!td) {
-    std::ostringstream sout;
-    sout << "Process " << myid
-	 << ": adjust_multistep_level: error allocating thread structures";
-    throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-  }
-
-  pthread_t* t  = new pthread_t [nthrds];
-
-  if (!t) {
-    std::ostringstream sout;
-    sout << "Process " << myid
-	 << ": adjust_multistep_level: error allocating memory for thread";
-    throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-  }
-  
-
   if (tmdt.size() == 0) {
     tmdt = std::vector< std::vector< std::vector<unsigned> > >(nthrds);
     for (int n=0; n<nthrds; n++) {
@@ -448,63 +459,24 @@ void adjust_multistep_level()
 
     if (this_step==0 and mstep==0) first = 0; // Do all levels
 
+    // Reload the slot arrays before forking
+    //
+    if (c->useSoA()) c->SoA();
+
     for (int level=first; level<=multistep; level++) {
       
-      if (nthrds==1) {
-
-	td[0].level = level;
-	td[0].id = 0;
-	td[0].c = c;
-	
-	adjust_multistep_level_thread(&td[0]);
-	
-      } else {
-	  
-	//
-	// Make the <nthrds> threads
-	//
-	int errcode;
-	void *retval;
-	
-	for (int i=0; i<nthrds; i++) {
-	  
-	  td[i].level = level;
-	  td[i].id = i;
-	  td[i].c = c;
-	  
-	  errcode =  pthread_create(&t[i], 0, adjust_multistep_level_thread, &td[i]);
-	    
-	  if (errcode) {
-	    std::ostringstream sout;
-	    sout << "Process " << myid
-		 << " adjust_multistep_level: cannot make thread " << i
-		 << ", errcode=" << errcode;
-	    throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-	  }
-#ifdef DEBUG
-	  else {
-	    cout << "Process " << myid << ": thread <" << i << "> created\n";
-	  }
-#endif
-	}
-	  
-	//
-	// Collapse the threads
-	//
-	for (int i=0; i<nthrds; i++) {
-	  if ((errcode=pthread_join(t[i], &retval))) {
-	    std::ostringstream sout;
-	    sout << "Process " << myid
-		 << " adjust_multistep_level: thread join " << i
-		 << " failed, errcode=" << errcode;
-	    throw GenericError(sout.str(), __FILE__, __LINE__, 1024, true);
-	  }
-#ifdef DEBUG    
-	  cout << "Process " << myid 
-	       << ": multistep thread <" << i << "> thread exited\n";
-#endif
-	}
-      }
+      //
+      // Chunks of the level list are handed out by the thread pool;
+      // the per-thread counters are indexed by worker id
+      //
+      ThreadPool::instance().parallel_for
+	(0, c->levlist[level].size(),
+	 [&](int id, unsigned beg, unsigned end)
+	 {
+	   thrd_pass_sync td {level, id, c,
+			      static_cast<int>(beg), static_cast<int>(end)};
+	   adjust_multistep_level_thread(&td);
+	 });
     }
 
     // Accumulate counters for all threads at the master step boundary
@@ -517,9 +489,6 @@ void adjust_multistep_level()
     }
   }
 
-  delete [] td;
-  delete [] t;
-
   //
   // Finish the update
   //
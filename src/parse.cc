@@ -19,6 +19,7 @@
 #include <set>
 
 #include <global_key_set.H>
+#include <Coefficients.H>
 
 void exp_version()
 {
@@ -89,6 +90,7 @@ void initialize(void)
     if (_G["nsteps"])	     nsteps     = _G["nsteps"].as<int>();
     if (_G["nthrds"])	     nthrds     = std::max<int>(1, _G["nthrds"].as<int>());
     if (_G["ngpus"])	     ngpus      = _G["ngpus"].as<int>();
+    if (_G["pool_chunk"])    pool_chunk = _G["pool_chunk"].as<unsigned>();
     if (_G["nreport"])	     nreport    = _G["nreport"].as<int>();
     if (_G["nbalance"])      nbalance   = _G["nbalance"].as<int>();
     if (_G["dbthresh"])      dbthresh   = _G["dbthresh"].as<double>();
@@ -241,6 +243,15 @@ void initialize(void)
     if (_G["runtag"])		runtag       = _G["runtag"].as<std::string>();
     if (_G["restart_cmd"])      restart_cmd  = _G["restart_cmd"].as<std::string>();
     if (_G["restart_as_new"])   ignore_info  = _G["restart_as_new"].as<bool>();
+    if (_G["mpiio_restart"])    mpiio_restart = _G["mpiio_restart"].as<bool>();
+    if (_G["h5coef_version"])   h5coef_version = _G["h5coef_version"].as<int>();
+    if (h5coef_version != 1 and h5coef_version != 2) {
+      std::ostringstream sout;
+      sout << "h5coef_version=" << h5coef_version << " must be 1 or 2";
+      throw EXPException("Configuration error", sout.str(),
+			 __FILE__, __LINE__);
+    }
+    CoefClasses::Coefs::H5Version = h5coef_version;
     if (_G["allcouples"])       all_couples  = _G["allcouples"].as<bool>();
     
     bool ok = true;
@@ -341,6 +352,7 @@ void update_parm()
     if (not conf["nsteps"])        conf["nsteps"]      = nsteps;
     if (not conf["nthrds"])        conf["nthrds"]      = nthrds;
     if (not conf["ngpus"])         conf["ngpus"]       = ngpus;
+    if (not conf["pool_chunk"])    conf["pool_chunk"]  = pool_chunk;
     if (not conf["nreport"])       conf["nreport"]     = nreport;
     if (not conf["nbalance"])      conf["nbalance"]    = nbalance;
     if (not conf["dbthresh"])      conf["dbthresh"]    = dbthresh;
@@ -372,6 +384,8 @@ void update_parm()
     if (not conf["outdir"])        conf["outdir"]      = outdir;
     if (not conf["runtag"])        conf["runtag"]      = runtag;
     if (not conf["restart_cmd"])   conf["restart_cmd"] = restart_cmd;
+    if (not conf["mpiio_restart"]) conf["mpiio_restart"] = mpiio_restart;
+    if (not conf["h5coef_version"]) conf["h5coef_version"] = h5coef_version;
     
     parse["Global"] = conf;
   }
@@ -14,6 +14,8 @@
 
 #include <expand.H>
 #include <OutputContainer.H>
+#include <ThreadPool.H>
+#include <CoefReduce.H>
 
 // Substep timing
 //
@@ -371,6 +373,11 @@ void do_step(int n)
       std::cout << sForm("Total", timer_tot.getTime(), totalT)
 		<< std::setw(70) << std::setfill('-') << '-' << std::endl
 		<< std::setfill(' ');
+
+      if (nthrds>1)
+	ThreadPool::instance().report(std::cout, "Thread pool [root]");
+
+      CoefReduce::report(std::cout, "Coefficient reductions [root]");
     }
 
     //
@@ -438,6 +445,9 @@ void do_step(int n)
     timer_rpt  .reset();
     timer_bal  .reset();
     timer_tot  .reset();
+
+    ThreadPool::instance().resetStats();
+    CoefReduce::resetStats();
     if (use_cuda) comp->timer_cuda.reset();
     if (use_cuda) comp->timer_orient.reset();
   }
@@ -0,0 +1,43 @@
+# Compare the log from the structure-of-arrays run (config_soa.yml)
+# with the log from the default run (config.yml) over the steps
+# that both runs cover.  Usage: check_soa.py [ref soa [rtol]]; other
+# pairs of runs that differ only in summation order are compared the
+# same way (e.g. config_direct.yml and config_direct_simd.yml)
+#
+import sys
+
+def read_log(name):
+    rows = []
+    n = 0
+    with open(name) as file:
+        while (line := file.readline()) != "":
+            if n >= 6:          # Skip the header stuff
+                rows.append([float(x) for x in line.split('|')])
+            n = n + 1           # Count lines
+    return rows
+
+args = sys.argv[1:] + ["OUTLOG.run0", "OUTLOG.run1"][len(sys.argv)-1:]
+
+ref = read_log(args[0])
+soa = read_log(args[1])
+
+# Rows are written every nint steps in both runs
+#
+nrow = min(len(ref), len(soa))
+if nrow < 2:
+    exit(1)
+
+rtol = 1.0e-6                   # Only summation order differs
+if len(args) > 2: rtol = float(args[2])
+atol = 1.0e-10
+
+clock = 17                      # Wall clock column
+
+for i in range(nrow):
+    for j, (a, b) in enumerate(zip(ref[i], soa[i])):
+        if j == clock: continue
+        if abs(a - b) > atol + rtol*max(abs(a), abs(b)):
+            print("Row", i, "column", j, "differs:", a, b)
+            exit(1)
+
+exit(0)
@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *  Description:
+ *  -----------
+ *
+ *  List and maintain the shared basis store.  The store directory is
+ *  given by --dir or by the EXP_CACHE_DIR environment variable.
+ *
+ *  Call sequence:
+ *  -------------
+ *  basiscache                        # list the entries
+ *  basiscache -v                     # list with the basis parameters
+ *  basiscache --evict 10G            # trim to at most 10 GiB
+ *  basiscache --clear                # remove all entries
+ *
+ *  Returns:
+ *  -------
+ *  One line per entry, most recently used first: force ID, hash,
+ *  size and time of last use
+ *
+ ***************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <ctime>
+
+#include <BasisCache.H>
+#include <cxxopts.H>
+
+int main(int argc, char** argv)
+{
+  bool verbose, clear;
+  std::string dir, evict;
+
+  //====================
+  // Parse command line
+  //====================
+
+  cxxopts::Options options(argv[0], "List and maintain the shared basis store");
+
+  options.add_options()
+   ("h,help", "Print this help message")
+   ("v,verbose", "print the basis parameters for each entry",
+     cxxopts::value<bool>(verbose)->default_value("false"))
+   ("d,dir", "store directory (default: EXP_CACHE_DIR)",
+     cxxopts::value<std::string>(dir))
+   ("evict", "remove least recently used entries down to this size (e.g. 500M, 10G)",
+     cxxopts::value<std::string>(evict))
+   ("clear", "remove all entries",
+     cxxopts::value<bool>(clear)->default_value("false"))
+    ;
+
+  cxxopts::ParseResult vm;
+
+  try {
+    vm = options.parse(argc, argv);
+  } catch (cxxopts::OptionException& e) {
+    std::cout << "Option error: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help")) {
+    std::cout << options.help() << std::endl << std::endl;
+    return 1;
+  }
+
+  if (dir.empty()) dir = BasisCache::directory();
+  if (dir.empty()) {
+    std::cout << "No store directory: use --dir or set EXP_CACHE_DIR"
+	      << std::endl;
+    return 1;
+  }
+
+  // Human-readable size
+  //
+  auto human = [](std::uintmax_t size)
+  {
+    const char* unit[] = {"B", "K", "M", "G", "T"};
+    double s = size;
+    int u = 0;
+    while (s >= 1024.0 and u < 4) { s /= 1024.0; u++; }
+    std::ostringstream sout;
+    sout << std::fixed << std::setprecision(u ? 1 : 0) << s << unit[u];
+    return sout.str();
+  };
+
+  try {
+    if (clear or vm.count("evict")) {
+      std::uintmax_t limit = clear ? 0 : BasisCache::parseSize(evict);
+      auto removed = BasisCache::evict(limit, dir);
+      std::cout << "Removed " << human(removed) << " from <" << dir << ">"
+		<< std::endl;
+    }
+  }
+  catch (std::exception& e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 2;
+  }
+
+  auto entries = BasisCache::list(dir);
+
+  std::uintmax_t total = 0;
+  for (auto & e : entries) total += e.size;
+
+  std::cout << "Store <" << dir << ">: " << entries.size() << " entries, "
+	    << human(total) << std::endl << std::endl;
+
+  if (entries.empty()) return 0;
+
+  std::cout << std::left
+	    << std::setw(14) << "forceID"
+	    << std::setw(34) << "hash"
+	    << std::setw(10) << "size"
+	    << "last used" << std::endl
+	    << std::setw(14) << "-------"
+	    << std::setw(34) << "----"
+	    << std::setw(10) << "----"
+	    << "---------" << std::endl;
+
+  for (auto & e : entries) {
+    char when[64];
+    std::strftime(when, sizeof(when), "%F %T", std::localtime(&e.used));
+
+    std::cout << std::setw(14) << e.forceID
+	      << std::setw(34) << e.hash
+	      << std::setw(10) << human(e.size)
+	      << when << std::endl;
+
+    if (verbose and e.params) {
+      for (auto it=e.params.begin(); it!=e.params.end(); it++) {
+	std::cout << "    " << std::setw(14) << it->first.as<std::string>();
+	if (it->second.IsScalar()) {
+	  // Multiline values (YAML configurations) are indented
+	  std::string v = it->second.as<std::string>(), line;
+	  std::istringstream sin(v);
+	  bool first = true;
+	  while (std::getline(sin, line)) {
+	    if (not first) std::cout << "    " << std::setw(14) << "";
+	    std::cout << line << std::endl;
+	    first = false;
+	  }
+	  if (first) std::cout << std::endl;
+	}
+	else std::cout << it->second << std::endl;
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*****************************************************************************
+ *  Description:
+ *  -----------
+ *
+ *  Scaling benchmark for the Sturm-Liouville table construction in
+ *  SLGridSph (and optionally SLGridSlab).  Every combination of the
+ *  requested Lmax, nmax, numr and thread counts is computed without
+ *  the cache and timed.  With --mpi, the tables are shared over all
+ *  processes as well.
+ *
+ *  Call sequence:
+ *  -------------
+ *  slbench --Lmax 4,10 --nmax 20,40 --numr 1000 --threads 1,2,4,8
+ *  mpirun -np 4 slbench --mpi --slab --Lmax 10 --nmax 40
+ *
+ *  Returns:
+ *  -------
+ *  Wall-clock time for each configuration and the speedup relative
+ *  to the first thread count
+ *
+ ***************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include <localmpi.H>
+#include <SLGridMP2.H>
+#include <cxxopts.H>
+
+int main(int argc, char** argv)
+{
+  bool use_mpi, use_slab, report;
+  double rmin, rmax, rs, zmax;
+  int cmap, numz;
+  std::vector<int> Lmax, nmax, numr, threads;
+  std::string filename;
+
+  //====================
+  // Parse command line
+  //====================
+
+  cxxopts::Options options(argv[0], "Time the construction of the SL tables");
+
+  options.add_options()
+   ("h,help", "Print this help message")
+   ("mpi", "share the tables over all MPI processes",
+     cxxopts::value<bool>(use_mpi)->default_value("false"))
+   ("slab", "also time SLGridSlab (Lmax is the maximum wave number)",
+     cxxopts::value<bool>(use_slab)->default_value("false"))
+   ("progress", "print the per-table progress report",
+     cxxopts::value<bool>(report)->default_value("false"))
+   ("Lmax", "list of maximum angular harmonic orders",
+     cxxopts::value<std::vector<int>>(Lmax)->default_value("4,10"))
+   ("nmax", "list of maximum radial orders",
+     cxxopts::value<std::vector<int>>(nmax)->default_value("20,40"))
+   ("numr", "list of radial (or vertical) grid sizes",
+     cxxopts::value<std::vector<int>>(numr)->default_value("1000"))
+   ("threads", "list of thread counts",
+     cxxopts::value<std::vector<int>>(threads)->default_value("1"))
+   ("cmap", "use mapped (1) or linear (0) coordinates",
+     cxxopts::value<int>(cmap)->default_value("1"))
+   ("rmin", "minimum radius for the SL grid",
+     cxxopts::value<double>(rmin)->default_value("0.0001"))
+   ("rmax", "maximum radius for the SL grid",
+     cxxopts::value<double>(rmax)->default_value("1.95"))
+   ("rs", "cmap scale factor",
+     cxxopts::value<double>(rs)->default_value("0.067"))
+   ("zmax", "maximum height for the slab grid",
+     cxxopts::value<double>(zmax)->default_value("10.0"))
+   ("filename", "spherical model file",
+     cxxopts::value<std::string>(filename)->default_value("SLGridSph.model"))
+    ;
+
+  //===================
+  // MPI preliminaries
+  //===================
+  if (use_mpi) {
+    local_init_mpi(argc, argv);
+  }
+
+  //===================
+  // Parse options
+  //===================
+
+  cxxopts::ParseResult vm;
+
+  try {
+    vm = options.parse(argc, argv);
+  } catch (cxxopts::OptionException& e) {
+    if (myid==0) std::cout << "Option error: " << e.what() << std::endl;
+    if (use_mpi) MPI_Finalize();
+    return 2;
+  }
+
+  // Print help message and exit
+  //
+  if (vm.count("help")) {
+    if (myid == 0) {
+      std::cout << options.help() << std::endl << std::endl;
+    }
+    if (use_mpi) MPI_Finalize();
+    return 1;
+  }
+
+  SLGridSph ::mpi      = use_mpi ? 1 : 0;
+  SLGridSlab::mpi      = use_mpi ? 1 : 0;
+  SLGridSph ::progress = report;
+  SLGridSlab::progress = report;
+  SLGridSlab::cache    = 0;
+
+  int nprocs = 1;
+  if (use_mpi) MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+  // Time one construction
+  //
+  auto timeit = [&](auto make) -> double
+  {
+    if (use_mpi) MPI_Barrier(MPI_COMM_WORLD);
+    auto beg = std::chrono::steady_clock::now();
+    make();
+    if (use_mpi) MPI_Barrier(MPI_COMM_WORLD);
+    std::chrono::duration<double> dur = std::chrono::steady_clock::now() - beg;
+    return dur.count();
+  };
+
+  if (myid==0) {
+    std::cout << std::left
+	      << std::setw(8)  << "Grid"
+	      << std::setw(8)  << "Lmax"
+	      << std::setw(8)  << "nmax"
+	      << std::setw(8)  << "numr"
+	      << std::setw(8)  << "procs"
+	      << std::setw(10) << "threads"
+	      << std::setw(14) << "time (s)"
+	      << std::setw(10) << "speedup"
+	      << std::endl
+	      << std::setw(8)  << "----"
+	      << std::setw(8)  << "----"
+	      << std::setw(8)  << "----"
+	      << std::setw(8)  << "----"
+	      << std::setw(8)  << "-----"
+	      << std::setw(10) << "-------"
+	      << std::setw(14) << "--------"
+	      << std::setw(10) << "-------"
+	      << std::endl;
+  }
+
+  auto row = [&](const std::string& grid, int L, int N, int R, int T,
+		 double t, double t0)
+  {
+    if (myid==0)
+      std::cout << std::setw(8)  << grid
+		<< std::setw(8)  << L
+		<< std::setw(8)  << N
+		<< std::setw(8)  << R
+		<< std::setw(8)  << nprocs
+		<< std::setw(10) << T
+		<< std::setw(14) << t
+		<< std::setw(10) << t0/t
+		<< std::endl;
+  };
+
+  for (auto L : Lmax) {
+    for (auto N : nmax) {
+      for (auto R : numr) {
+
+	double t0 = 0.0;
+	for (auto T : threads) {
+	  omp_set_num_threads(T);
+	  double t = timeit([&]() {
+	    SLGridSph sl(filename, L, N, R, rmin, rmax, false, cmap, rs,
+			 0, 1.0);
+	  });
+	  if (t0==0.0) t0 = t;
+	  row("sph", L, N, R, T, t, t0);
+	}
+
+	if (use_slab) {
+	  t0 = 0.0;
+	  for (auto T : threads) {
+	    omp_set_num_threads(T);
+	    double t = timeit([&]() {
+	      SLGridSlab sl(L, N, R, zmax);
+	    });
+	    if (t0==0.0) t0 = t;
+	    row("slab", L, N, R, T, t, t0);
+	  }
+	}
+      }
+    }
+  }
+
+  if (use_mpi) MPI_Finalize();
+
+  return 0;
+}
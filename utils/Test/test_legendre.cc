@@ -0,0 +1,268 @@
+/*****************************************************************************
+ *  Description:
+ *  -----------
+ *
+ *  Benchmark the block Legendre and sine/cosine recursions in
+ *  LegendreBlock against the scalar, per-point recursions used by
+ *  Basis::dlegendre_R and Basis::sinecosine_R
+ *
+ *  Call sequence:
+ *  -------------
+ *  legbench -L 10 -N 1000000 -n 5
+ *
+ *  Returns:
+ *  -------
+ *  Time per point for each variant and the largest difference
+ *  relative to the scalar double-precision tables
+ *
+ ***************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cmath>
+
+#include <Eigen/Eigen>
+
+#include <LegendreBlock.H>
+#include <cxxopts.H>
+
+// Scalar reference: the same recursions as Basis::dlegendre_R and
+// Basis::sinecosine_R
+//
+void dlegendre_scalar(int lmax, double x,
+		      Eigen::MatrixXd &p, Eigen::MatrixXd &dp)
+{
+  const double MINEPS = 20.0*std::numeric_limits<double>::min();
+  double fact, somx2, pll, pl1, pl2;
+
+  p(0, 0) = pll = 1.0;
+  if (lmax > 0) {
+    somx2 = sqrt( (1.0 - x)*(1.0 + x) );
+    fact = 1.0;
+    for (int m=1; m<=lmax; m++) {
+      pll *= -fact*somx2;
+      p(m, m) = pll;
+      fact += 2.0;
+    }
+  }
+
+  for (int m=0; m<lmax; m++) {
+    pl2 = p(m, m);
+    p(m+1, m) = pl1 = x*(2*m+1)*pl2;
+    for (int l=m+2; l<=lmax; l++) {
+      p(l, m) = pll = (x*(2*l-1)*pl1-(l+m-1)*pl2)/(l-m);
+      pl2 = pl1;
+      pl1 = pll;
+    }
+  }
+
+  if (1.0-fabs(x) < MINEPS) {
+    if (x>0) x =   1.0 - MINEPS;
+    else     x = -(1.0 - MINEPS);
+  }
+
+  somx2 = 1.0/(x*x - 1.0);
+  dp(0, 0) = 0.0;
+  for (int l=1; l<=lmax; l++) {
+    for (int m=0; m<l; m++)
+      dp(l, m) = somx2*(x*l*p(l, m) - (l+m)*p(l-1, m));
+    dp(l, l) = somx2*x*l*p(l, l);
+  }
+}
+
+void sinecosine_scalar(int mmax, double phi,
+		       Eigen::VectorXd& c, Eigen::VectorXd& s)
+{
+  c[0] = 1.0;
+  s[0] = 0.0;
+
+  if (mmax>0) {
+    c[1] = cos(phi);
+    s[1] = sin(phi);
+
+    for (int m=2; m<=mmax; m++) {
+      c[m] = 2.0*c[1]*c[m-1] - c[m-2];
+      s[m] = 2.0*c[1]*s[m-1] - s[m-2];
+    }
+  }
+}
+
+// Prevent the optimizer from discarding the tables
+//
+static volatile double sink;
+
+// Time and check one block variant
+//
+template<typename T, int W>
+void bench(const std::string& label, int lmax, int niter,
+	   const std::vector<double>& x, const std::vector<double>& phi,
+	   const std::vector<Eigen::MatrixXd>& Pref,
+	   const std::vector<Eigen::MatrixXd>& dPref,
+	   const std::vector<Eigen::VectorXd>& Cref,
+	   const std::vector<Eigen::VectorXd>& Sref,
+	   double tscalar)
+{
+  LegendreBlock<T, W> lb(lmax);
+  int N = x.size();
+
+  std::vector<T> xT(x.begin(), x.end()), pT(phi.begin(), phi.end());
+
+  auto beg = std::chrono::steady_clock::now();
+  double sum = 0.0;
+  for (int it=0; it<niter; it++) {
+    for (int i=0; i<N; i+=W) {
+      int n = std::min<int>(W, N-i);
+      lb.dlegendre(&xT[i], n);
+      lb.sinecosine(lmax, &pT[i], n);
+      sum += lb.dP(lmax, 0, 0) + lb.C(lmax, 0);
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  sink = sum;
+
+  double t = std::chrono::duration<double>(end - beg).count()/(niter*N);
+
+  // Accuracy relative to the scalar double tables (the reference
+  // points are the first Pref.size() points)
+  //
+  double errP = 0.0, errD = 0.0, errT = 0.0;
+  int M = Pref.size();
+  for (int i=0; i<M; i+=W) {
+    int n = std::min<int>(W, M-i);
+    lb.dlegendre(&xT[i], n);
+    lb.sinecosine(lmax, &pT[i], n);
+    for (int k=0; k<n; k++) {
+      for (int l=0; l<=lmax; l++) {
+	for (int m=0; m<=l; m++) {
+	  double s1 = std::max<double>(1.0, fabs(Pref [i+k](l, m)));
+	  double s2 = std::max<double>(1.0, fabs(dPref[i+k](l, m)));
+	  errP = std::max<double>(errP, fabs(lb.P (l, m, k) - Pref [i+k](l, m))/s1);
+	  errD = std::max<double>(errD, fabs(lb.dP(l, m, k) - dPref[i+k](l, m))/s2);
+	}
+	errT = std::max<double>(errT, fabs(lb.C(l, k) - Cref[i+k][l]));
+	errT = std::max<double>(errT, fabs(lb.S(l, k) - Sref[i+k][l]));
+      }
+    }
+  }
+
+  std::cout << std::left << std::setw(22) << label << std::right
+	    << std::setw(12) << std::setprecision(4) << t*1.0e9
+	    << std::setw(10) << std::setprecision(3) << tscalar/t
+	    << std::setw(12) << std::setprecision(3) << errP
+	    << std::setw(12) << std::setprecision(3) << errD
+	    << std::setw(14) << std::setprecision(3) << errT
+	    << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+  int lmax, N, niter, ncheck;
+
+  cxxopts::Options options(argv[0], "Benchmark the block Legendre recursions");
+
+  options.add_options()
+    ("h,help", "Produce help message")
+    ("L,lmax", "maximum harmonic order",
+     cxxopts::value<int>(lmax)->default_value("10"))
+    ("N,number", "number of evaluation points",
+     cxxopts::value<int>(N)->default_value("1000000"))
+    ("n,iter", "number of timing iterations",
+     cxxopts::value<int>(niter)->default_value("5"))
+    ("c,check", "number of points compared with the scalar version",
+     cxxopts::value<int>(ncheck)->default_value("10000"))
+    ;
+
+  cxxopts::ParseResult vm;
+
+  try {
+    vm = options.parse(argc, argv);
+  } catch (cxxopts::OptionException& e) {
+    std::cout << "Option error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  if (vm.count("help")) {
+    std::cout << options.help() << std::endl;
+    return 0;
+  }
+
+  ncheck = std::min<int>(ncheck, N);
+
+  // Random points
+  //
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> ux(-1.0, 1.0), up(-M_PI, M_PI);
+
+  std::vector<double> x(N), phi(N);
+  for (int i=0; i<N; i++) {
+    x  [i] = ux(gen);
+    phi[i] = up(gen);
+  }
+
+  // Scalar timing and reference tables
+  //
+  Eigen::MatrixXd P(lmax+1, lmax+1), dP(lmax+1, lmax+1);
+  Eigen::VectorXd C(lmax+1), S(lmax+1);
+
+  auto beg = std::chrono::steady_clock::now();
+  double sum = 0.0;
+  for (int it=0; it<niter; it++) {
+    for (int i=0; i<N; i++) {
+      dlegendre_scalar (lmax, x[i],   P, dP);
+      sinecosine_scalar(lmax, phi[i], C, S);
+      sum += dP(lmax, 0) + C[lmax];
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  sink = sum;
+
+  double tscalar = std::chrono::duration<double>(end - beg).count()/(niter*N);
+
+  std::vector<Eigen::MatrixXd> Pref(ncheck), dPref(ncheck);
+  std::vector<Eigen::VectorXd> Cref(ncheck), Sref(ncheck);
+  for (int i=0; i<ncheck; i++) {
+    Pref [i].setZero(lmax+1, lmax+1);
+    dPref[i].setZero(lmax+1, lmax+1);
+    Cref [i].resize(lmax+1);
+    Sref [i].resize(lmax+1);
+    dlegendre_scalar (lmax, x[i],   Pref[i], dPref[i]);
+    sinecosine_scalar(lmax, phi[i], Cref[i], Sref[i]);
+  }
+
+  std::cout << std::setfill('-') << std::setw(80) << '-' << std::endl
+	    << std::setfill(' ')
+	    << "Lmax=" << lmax << "  points=" << N << "  iterations=" << niter
+	    << std::endl
+	    << std::setfill('-') << std::setw(80) << '-' << std::endl
+	    << std::setfill(' ')
+	    << std::left << std::setw(22) << "Variant" << std::right
+	    << std::setw(12) << "ns/point"
+	    << std::setw(10) << "speedup"
+	    << std::setw(12) << "err(P)"
+	    << std::setw(12) << "err(dP)"
+	    << std::setw(14) << "err(cos/sin)"
+	    << std::endl
+	    << std::left << std::setw(22) << "scalar double" << std::right
+	    << std::setw(12) << std::setprecision(4) << tscalar*1.0e9
+	    << std::setw(10) << 1.0
+	    << std::setw(12) << 0.0
+	    << std::setw(12) << 0.0
+	    << std::setw(14) << 0.0
+	    << std::endl;
+
+  bench<double,  8>("block double W=8",  lmax, niter, x, phi,
+		    Pref, dPref, Cref, Sref, tscalar);
+  bench<double, 16>("block double W=16", lmax, niter, x, phi,
+		    Pref, dPref, Cref, Sref, tscalar);
+  bench<float,  16>("block float  W=16", lmax, niter, x, phi,
+		    Pref, dPref, Cref, Sref, tscalar);
+
+  std::cout << std::setfill('-') << std::setw(80) << '-' << std::endl
+	    << std::setfill(' ');
+
+  return 0;
+}